@@ -74,9 +74,9 @@ char    appv_status_message[150] = "READY";
 
 // Set of status
 LiveObjectsD_Data_t appv_set_status[] = {
-  { LOD_TYPE_STRING_C, "sample_version" ,  (void*)appv_version, 1 },
-  { LOD_TYPE_INT32,    "sample_counter" ,  &appv_status_counter, 1 },
-  { LOD_TYPE_STRING_C, "sample_message" ,  appv_status_message, 1 }
+  { LOD_TYPE_STRING_C, "sample_version" ,  (void*)appv_version, 1, 0 },
+  { LOD_TYPE_INT32,    "sample_counter" ,  &appv_status_counter, 1, 0 },
+  { LOD_TYPE_STRING_C, "sample_message" ,  appv_status_message, 1, 0 }
 };
 #define SET_STATUS_NB (sizeof(appv_set_status) / sizeof(LiveObjectsD_Data_t))
 
@@ -105,9 +105,9 @@ float    appv_measures_volt = 5.0;
 
 // Set of Collected data (published on a data stream)
 LiveObjectsD_Data_t appv_set_measures[] = {
-  { LOD_TYPE_UINT32, "counter" ,        &appv_measures_counter, 1 },
-  { LOD_TYPE_INT32,  "temperature" ,    &appv_measures_temp, 1 },
-  { LOD_TYPE_FLOAT,  "battery_level" ,  &appv_measures_volt, 1 }
+  { LOD_TYPE_UINT32, "counter" ,        &appv_measures_counter, 1, 0 },
+  { LOD_TYPE_INT32,  "temperature" ,    &appv_measures_temp, 1, 0 },
+  { LOD_TYPE_FLOAT,  "battery_level" ,  &appv_measures_volt, 1, 0 }
 };
 #define SET_MEASURES_NB (sizeof(appv_set_measures) / sizeof(LiveObjectsD_Data_t))
 
@@ -141,10 +141,10 @@ struct conf_s {
 
 // Set of configuration parameters
 LiveObjectsD_Param_t appv_set_param[] = {
-  { PARM_IDX_NAME,      { LOD_TYPE_STRING_C, "name"    ,   appv_conf.name, 1 } },
-  { PARM_IDX_TIMEOUT,   { LOD_TYPE_UINT32,   "timeout" ,   (void*)&appv_cfg_timeout, 1 } },
-  { PARM_IDX_THRESHOLD, { LOD_TYPE_INT32,    "threshold" , &appv_conf.threshold, 1 } },
-  { PARM_IDX_GAIN,      { LOD_TYPE_FLOAT,    "gain" ,      &appv_conf.gain, 1 } }
+  { PARM_IDX_NAME,      { LOD_TYPE_STRING_C, "name"    ,   appv_conf.name, 1, 0 } },
+  { PARM_IDX_TIMEOUT,   { LOD_TYPE_UINT32,   "timeout" ,   (void*)&appv_cfg_timeout, 1, 0 } },
+  { PARM_IDX_THRESHOLD, { LOD_TYPE_INT32,    "threshold" , &appv_conf.threshold, 1, 0 } },
+  { PARM_IDX_GAIN,      { LOD_TYPE_FLOAT,    "gain" ,      &appv_conf.gain, 1, 0 } }
 };
 #define SET_PARAM_NB (sizeof(appv_set_param) / sizeof(LiveObjectsD_Param_t))
 
@@ -392,8 +392,8 @@ extern "C" {
         uint32_t code = 200;
         char msg [] = "USER LED TEST = OK";
         LiveObjectsD_Data_t cmd_resp[] = {
-          { LOD_TYPE_UINT32,    "code" ,  &code, 1 },
-          { LOD_TYPE_STRING_C,  "msg" ,   msg, 1 }
+          { LOD_TYPE_UINT32,    "code" ,  &code, 1, 0 },
+          { LOD_TYPE_STRING_C,  "msg" ,   msg, 1, 0 }
         };
         // switch off the LED
         app_led_user = 1;
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  bench_decode.c
+ * @brief Host micro-benchmark: reading of received JSON messages,
+ *        jsmn tokenizer (before) versus the JSON reader LO_json_parse (after).
+ *
+ * Built twice: bench_decode uses the vector scan of the reader (LOM_JSON_SIMD, SSE2/AVX2/NEON
+ * as targeted by the compiler), bench_decode_scalar the byte per byte scan.
+ * Both must find the same number of tokens (names and values) as jsmn.
+ *
+ * Usage: bench_decode [min_time_ms]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "liveobjects-client/LiveObjectsClient_Config.h"
+#include "iotsoftbox-core/loc_json_api.h"
+#include "jsmn/jsmn.h"
+
+#define BENCH_BUF_SZ          (1024*16)
+#define BENCH_MAX_TOKENS      1024
+#define BENCH_MIN_TIME_MS     300
+
+#if (LOM_JSON_SIMD) && defined(__GNUC__) && defined(__AVX2__)
+#define BENCH_SCAN            "AVX2"
+#elif (LOM_JSON_SIMD) && defined(__GNUC__) && defined(__SSE2__)
+#define BENCH_SCAN            "SSE2"
+#elif (LOM_JSON_SIMD) && defined(__GNUC__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define BENCH_SCAN            "NEON"
+#else
+#define BENCH_SCAN            "scalar"
+#endif
+
+typedef struct {
+	const char* name;
+	char* text;
+	uint32_t len;
+} BenchMsg_t;
+
+static char _msg_buf[5][BENCH_BUF_SZ];
+static jsmntok_t _jsmn_tokens[BENCH_MAX_TOKENS];
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static uint64_t bench_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Configuration update, as received on 'dev/cfg/upd' */
+static uint32_t bench_msg_cfg(char* buf) {
+	uint32_t len;
+	int i;
+	len = (uint32_t) snprintf(buf, BENCH_BUF_SZ, "{\"cfg\":{");
+	for (i = 0; i < 12; i++) {
+		if (i % 3 == 2)
+			len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "%s\"param_%02d\":{\"t\":\"str\",\"v\":\"%s\"}",
+					(i) ? "," : "", i, "sensor-gateway-0042");
+		else
+			len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "%s\"param_%02d\":{\"t\":\"u32\",\"v\":%d}",
+					(i) ? "," : "", i, 1000 + i * 7919);
+	}
+	len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "},\"cid\":907432}");
+	return len;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Command request with long string arguments, as received on 'dev/cmd' */
+static uint32_t bench_msg_cmd(char* buf) {
+	uint32_t len;
+	int i;
+	len = (uint32_t) snprintf(buf, BENCH_BUF_SZ, "{\"req\":\"display\",\"arg\":{\"line1\":\"");
+	for (i = 0; i < 12; i++)
+		len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "The quick brown fox jumps over the lazy dog. ");
+	len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "\",\"line2\":\"escaped \\\"quotes\\\" and \\\\ ");
+	for (i = 0; i < 6; i++)
+		len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "0123456789abcdefghijklmnopqrstuvwxyz ");
+	len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "\",\"duration\":30,\"blink\":true},\"cid\":12345678}");
+	return len;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Resource update request, as received on 'dev/rsc/upd' */
+static uint32_t bench_msg_rsc(char* buf) {
+	return (uint32_t) snprintf(buf, BENCH_BUF_SZ, "{\"id\":\"firmware\",\"old\":\"1.0.3\",\"new\":\"1.1.0\","
+			"\"m\":{\"uri\":\"http://liveobjects.orange-business.com/dl/rsc/firmware/1.1.0/"
+			"0f343b0931126a20f133d67c2b018a3b?token=9dc3c85f5e7be0d3d1e2b27c3c64c9d2e8a0f9b1c2d3e4f5\","
+			"\"md5\":\"0f343b0931126a20f133d67c2b018a3b\",\"size\":294512},\"cid\":733912}");
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Configuration update, pretty printed */
+static uint32_t bench_msg_pretty(char* buf) {
+	uint32_t len;
+	int i;
+	len = (uint32_t) snprintf(buf, BENCH_BUF_SZ, "{\n    \"cfg\": {\n");
+	for (i = 0; i < 12; i++) {
+		len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len,
+				"        \"param_%02d\": {\n            \"t\": \"f64\",\n            \"v\": %d.%03d\n        }%s\n",
+				i, 20 + i, i * 37, (i < 11) ? "," : "");
+	}
+	len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "    },\n    \"cid\": 907432\n}\n");
+	return len;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Large message: command with an array of records (gateway) */
+static uint32_t bench_msg_large(char* buf) {
+	uint32_t len;
+	int i;
+	len = (uint32_t) snprintf(buf, BENCH_BUF_SZ, "{\"req\":\"provision\",\"arg\":{\"devices\":[");
+	for (i = 0; i < 64; i++) {
+		len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len,
+				"%s{\"id\":\"urn:lo:nsid:sensor:%08X\",\"label\":\"temperature sensor, building B floor %d\","
+				"\"period\":%d,\"enabled\":%s}", (i) ? "," : "", 0x1A2B0000 + i, i % 7, 60 * (1 + i % 5),
+				(i % 3) ? "true" : "false");
+	}
+	len += (uint32_t) snprintf(buf + len, BENCH_BUF_SZ - len, "]},\"cid\":5}");
+	return len;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Count the tokens as jsmn does: one per value, and one per member name */
+static int bench_count_event(void* ctx, const LOJsonToken_t* tk) {
+	uint32_t* count = (uint32_t*) ctx;
+	if ((tk->evt == LOJSON_EVT_OBJECT_END) || (tk->evt == LOJSON_EVT_ARRAY_END))
+		return 0;
+	*count += (tk->name_ptr) ? 2 : 1;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int bench_parse_before(const BenchMsg_t* msg, uint32_t* tokens) {
+	jsmn_parser parser;
+	int ret;
+	jsmn_init(&parser);
+	ret = jsmn_parse(&parser, msg->text, msg->len, _jsmn_tokens, BENCH_MAX_TOKENS);
+	if (ret < 0)
+		return -1;
+	*tokens = (uint32_t) ret;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int bench_parse_after(const BenchMsg_t* msg, uint32_t* tokens) {
+	*tokens = 0;
+	return (LO_json_parse(msg->text, msg->len, bench_count_event, tokens)) ? -1 : 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Return the mean time (ns) to read the message */
+static double bench_run(int (*fct)(const BenchMsg_t*, uint32_t*), const BenchMsg_t* msg, uint64_t min_time_ns,
+		uint32_t* tokens) {
+	uint64_t t0, dt;
+	uint64_t iter = 0;
+	uint32_t n = 64;
+	t0 = bench_now_ns();
+	do {
+		uint32_t k;
+		for (k = 0; k < n; k++) {
+			if (fct(msg, tokens)) {
+				fprintf(stderr, "ERROR: reading of '%s' failed\n", msg->name);
+				exit(1);
+			}
+		}
+		iter += n;
+		dt = bench_now_ns() - t0;
+	} while (dt < min_time_ns);
+	return (double) dt / iter;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int main(int argc, char* argv[]) {
+	BenchMsg_t msgs[5] = {
+			{ "cfg update", _msg_buf[0], 0 },
+			{ "cmd long strings", _msg_buf[1], 0 },
+			{ "rsc update", _msg_buf[2], 0 },
+			{ "cfg pretty", _msg_buf[3], 0 },
+			{ "cmd 64 records", _msg_buf[4], 0 } };
+	uint64_t min_time_ns = (uint64_t) BENCH_MIN_TIME_MS * 1000000ULL;
+	int i;
+
+	if (argc > 1) {
+		min_time_ns = (uint64_t) strtoul(argv[1], NULL, 10) * 1000000ULL;
+	}
+
+	msgs[0].len = bench_msg_cfg(msgs[0].text);
+	msgs[1].len = bench_msg_cmd(msgs[1].text);
+	msgs[2].len = bench_msg_rsc(msgs[2].text);
+	msgs[3].len = bench_msg_pretty(msgs[3].text);
+	msgs[4].len = bench_msg_large(msgs[4].text);
+
+	printf("JSON reader scan: %s\n", BENCH_SCAN);
+	printf("%-20s %8s %8s %12s %12s %10s %8s\n", "message", "bytes", "tokens", "jsmn ns", "reader ns", "reader MB/s",
+			"speedup");
+	for (i = 0; i < 5; i++) {
+		uint32_t tk_before, tk_after;
+		double ns_before, ns_after;
+
+		ns_before = bench_run(bench_parse_before, &msgs[i], min_time_ns, &tk_before);
+		ns_after = bench_run(bench_parse_after, &msgs[i], min_time_ns, &tk_after);
+
+		if (tk_before != tk_after) {
+			fprintf(stderr, "ERROR: '%s' tokens differ: jsmn %u, reader %u\n", msgs[i].name, tk_before, tk_after);
+			return 1;
+		}
+
+		printf("%-20s %8u %8u %12.0f %12.0f %11.0f %7.2fx\n", msgs[i].name, msgs[i].len, tk_after, ns_before, ns_after,
+				msgs[i].len * 1000.0 / ns_after, ns_before / ns_after);
+	}
+	return 0;
+}
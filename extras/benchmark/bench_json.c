@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  bench_json.c
+ * @brief Host micro-benchmark: JSON encoding of 'collected data' sets,
+ *        former strlen/snprintf based LO_json API (before) versus the JSON writer (after).
+ *
+ * Output of the sets without floating point values must be identical.
+ * Floating point values are written with their shortest representation: they are
+ * checked to read back to the same value.
+ *
+ * Usage: bench_json [min_time_ms]
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "iotsoftbox-core/loc_json_api.h"
+#include "legacy_json_api.h"
+
+#define BENCH_BUF_SZ          (1024*8)
+#define BENCH_MAX_ITEMS       80
+#define BENCH_MIN_TIME_MS     300
+
+typedef struct {
+	const char*         name;
+	LiveObjectsD_Data_t items[BENCH_MAX_ITEMS];
+	int                 items_nb;
+} BenchDataSet_t;
+
+static int32_t  _v_i32[128];
+static int16_t  _v_i16[128];
+static int8_t   _v_i8[128];
+static uint8_t  _v_u8[128];
+static uint16_t _v_u16[128];
+static uint32_t _v_u32[128];
+static float    _v_f32[128];
+static double   _v_f64[128];
+static uint8_t  _v_bool[128];
+
+static int32_t  _v_i32_edge[] = { INT32_MIN, INT32_MIN + 1, -1000000000, -99, -10, -9, -1, 0, 1, 9, 10, 99, 100,
+		999999999, 1000000000, INT32_MAX };
+static uint32_t _v_u32_edge[] = { 0, 1, 9, 10, 99, 100, 65535, 65536, 999999999, 1000000000, UINT32_MAX };
+static int16_t  _v_i16_edge[] = { INT16_MIN, -1, 0, INT16_MAX };
+static uint16_t _v_u16_edge[] = { 0, 9999, 10000, UINT16_MAX };
+static int8_t   _v_i8_edge[] = { INT8_MIN, -1, 0, INT8_MAX };
+static uint8_t  _v_u8_edge[] = { 0, 99, 100, UINT8_MAX };
+#define EDGE_NB(a)  ((int8_t) (sizeof(a) / sizeof(a[0])))
+static const char* _v_str[4] = { "running", "OK", "LO_arduino_dev01", "FW-V04.14-2018" };
+
+static char _item_names[BENCH_MAX_ITEMS][16];
+
+static char _buf_before[BENCH_BUF_SZ];
+static char _buf_after[BENCH_BUF_SZ];
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static uint64_t bench_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void bench_init_values(void) {
+	int i;
+	for (i = 0; i < 128; i++) {
+		_v_i32[i] = (i * 7919) - 300000;
+		_v_i16[i] = (int16_t)((i * 131) - 8000);
+		_v_i8[i] = (int8_t)(i - 64);
+		_v_u8[i] = (uint8_t)(i * 3);
+		_v_u16[i] = (uint16_t)(i * 509);
+		_v_bool[i] = (uint8_t)((i % 3) == 0);
+		_v_u32[i] = 4000000000U - (uint32_t)(i * 104729);
+		_v_f32[i] = 21.5f + (float) i * 0.25f;
+	}
+	for (i = 0; i < 128; i++) {
+		_v_f64[i] = 48.8566 + (i * 0.0001);
+	}
+	for (i = 0; i < BENCH_MAX_ITEMS; i++) {
+		snprintf(_item_names[i], sizeof(_item_names[i]), "item_%02d", i);
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void bench_add(BenchDataSet_t* set, LiveObjectsD_Type_t type, void* value, int8_t dim) {
+	LiveObjectsD_Data_t* p = &set->items[set->items_nb];
+	p->data_type = type;
+	p->data_name = _item_names[set->items_nb];
+	p->data_value = value;
+	p->data_dim = dim;
+	set->items_nb++;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Typical sensor 'dev/data' set: a few scalars */
+static void bench_set_small(BenchDataSet_t* set) {
+	set->name = "small scalars";
+	bench_add(set, LOD_TYPE_INT32, &_v_i32[0], 1);
+	bench_add(set, LOD_TYPE_UINT8, &_v_u8[1], 1);
+	bench_add(set, LOD_TYPE_FLOAT, &_v_f32[0], 1);
+	bench_add(set, LOD_TYPE_BOOL, &_v_bool[1], 1);
+	bench_add(set, LOD_TYPE_STRING_C, (void*) _v_str[0], 1);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* About 1 KB: many mixed scalars */
+static void bench_set_1k(BenchDataSet_t* set) {
+	int i;
+	set->name = "~1KB mixed";
+	for (i = 0; i < 40; i++) {
+		switch (i % 8) {
+		case 0: bench_add(set, LOD_TYPE_INT32, &_v_i32[i], 1); break;
+		case 1: bench_add(set, LOD_TYPE_INT16, &_v_i16[i], 1); break;
+		case 2: bench_add(set, LOD_TYPE_UINT32, &_v_u32[i], 1); break;
+		case 3: bench_add(set, LOD_TYPE_UINT8, &_v_u8[i], 1); break;
+		case 4: bench_add(set, LOD_TYPE_FLOAT, &_v_f32[i], 1); break;
+		case 5: bench_add(set, LOD_TYPE_DOUBLE, &_v_f64[i % 8], 1); break;
+		case 6: bench_add(set, LOD_TYPE_BOOL, &_v_bool[i % 8], 1); break;
+		default: bench_add(set, LOD_TYPE_STRING_C, (void*) _v_str[i % 4], 1); break;
+		}
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/* About 2 KB: scalars and small arrays */
+static void bench_set_2k(BenchDataSet_t* set) {
+	int i;
+	set->name = "~2KB mixed+arrays";
+	for (i = 0; i < 50; i++) {
+		switch (i % 5) {
+		case 0: bench_add(set, LOD_TYPE_INT32, &_v_i32[i], 1); break;
+		case 1: bench_add(set, LOD_TYPE_INT16, &_v_i16[0], 8); break;
+		case 2: bench_add(set, LOD_TYPE_FLOAT, &_v_f32[i], 1); break;
+		case 3: bench_add(set, LOD_TYPE_UINT8, &_v_u8[0], 4); break;
+		default: bench_add(set, LOD_TYPE_STRING_C, (void*) _v_str[i % 4], 1); break;
+		}
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Large arrays (up to data_dim = 127) */
+static void bench_set_arrays(BenchDataSet_t* set) {
+	set->name = "large int arrays";
+	bench_add(set, LOD_TYPE_INT32, &_v_i32[0], 127);
+	bench_add(set, LOD_TYPE_INT16, &_v_i16[0], 127);
+	bench_add(set, LOD_TYPE_UINT32, &_v_u32[0], 100);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Large arrays of each integer type, and of booleans */
+static void bench_set_int_arrays(BenchDataSet_t* set) {
+	set->name = "int/bool arrays x127";
+	bench_add(set, LOD_TYPE_INT32, &_v_i32[0], 127);
+	bench_add(set, LOD_TYPE_UINT32, &_v_u32[0], 127);
+	bench_add(set, LOD_TYPE_INT16, &_v_i16[0], 127);
+	bench_add(set, LOD_TYPE_UINT16, &_v_u16[0], 127);
+	bench_add(set, LOD_TYPE_INT8, &_v_i8[0], 127);
+	bench_add(set, LOD_TYPE_UINT8, &_v_u8[0], 127);
+	bench_add(set, LOD_TYPE_BOOL, &_v_bool[0], 127);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Limits and digit-count boundaries of each integer type (output check) */
+static void bench_set_int_edges(BenchDataSet_t* set) {
+	set->name = "int edge values";
+	bench_add(set, LOD_TYPE_INT32, _v_i32_edge, EDGE_NB(_v_i32_edge));
+	bench_add(set, LOD_TYPE_UINT32, _v_u32_edge, EDGE_NB(_v_u32_edge));
+	bench_add(set, LOD_TYPE_INT16, _v_i16_edge, EDGE_NB(_v_i16_edge));
+	bench_add(set, LOD_TYPE_UINT16, _v_u16_edge, EDGE_NB(_v_u16_edge));
+	bench_add(set, LOD_TYPE_INT8, _v_i8_edge, EDGE_NB(_v_i8_edge));
+	bench_add(set, LOD_TYPE_UINT8, _v_u8_edge, EDGE_NB(_v_u8_edge));
+	bench_add(set, LOD_TYPE_INT32, &_v_i32_edge[0], 1);
+	bench_add(set, LOD_TYPE_UINT32, &_v_u32_edge[EDGE_NB(_v_u32_edge) - 1], 1);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Typical sensor floats (temperature, voltage, pressure, GPS) */
+static void bench_set_floats(BenchDataSet_t* set) {
+	int i;
+	set->name = "sensor floats";
+	for (i = 0; i < 24; i++) {
+		if (i % 3)
+			bench_add(set, LOD_TYPE_FLOAT, &_v_f32[i], 1);
+		else
+			bench_add(set, LOD_TYPE_DOUBLE, &_v_f64[i], 1);
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Large float/double arrays */
+static void bench_set_float_arrays(BenchDataSet_t* set) {
+	set->name = "float arrays x127";
+	bench_add(set, LOD_TYPE_FLOAT, &_v_f32[0], 127);
+	bench_add(set, LOD_TYPE_DOUBLE, &_v_f64[0], 127);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Check that floating point values read back to the same value */
+static int bench_check_floats(void) {
+	static const float f_values[] = { 0.0f, -0.0f, 1.0f, -3.0f, 21.5f, 0.1f, 4.98f, 1013.25f, 1e-7f, 1.5e6f,
+			3.4028235e38f, 1.17549435e-38f, 1.4e-45f, 123456789.0f };
+	static const double d_values[] = { 0.1, 48.8566, 2.3522219, 1e300, 5e-324, 2.2250738585072014e-308,
+			1.7976931348623157e308, 123.456, -1e-6 };
+	char buf[64];
+	LOJsonWriter_t jw;
+	LiveObjectsD_Data_t d;
+	uint32_t seed = 12345;
+	int i;
+
+	memset(&d, 0, sizeof(d));
+	d.data_dim = 1;
+	d.data_name = "f";
+	for (i = 0; i < 200000; i++) {
+		float f;
+		double v;
+		uint32_t u;
+		if (i < (int) (sizeof(d_values) / sizeof(double))) {
+			d.data_type = LOD_TYPE_DOUBLE;
+			v = d_values[i];
+			d.data_value = &v;
+		}
+		else {
+			if (i < (int) (sizeof(f_values) / sizeof(float))) {
+				f = f_values[i];
+			}
+			else {
+				seed = seed * 1664525U + 1013904223U;
+				u = seed;
+				memcpy(&f, &u, sizeof(f));
+				if (isnan(f) || isinf(f))
+					continue;
+			}
+			d.data_type = LOD_TYPE_FLOAT;
+			d.data_value = &f;
+		}
+		LO_json_init(&jw, buf, sizeof(buf));
+		if (LO_json_add_item(&jw, &d)) {
+			fprintf(stderr, "ERROR: float encoding failed\n");
+			return -1;
+		}
+		if (((d.data_type == LOD_TYPE_FLOAT) && (strtof(buf + 4, NULL) != f))
+				|| ((d.data_type == LOD_TYPE_DOUBLE) && (strtod(buf + 4, NULL) != v))) {
+			fprintf(stderr, "ERROR: float value does not read back: %s\n", buf);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Output check of the configuration parameters (LO_json_add_param) and of LO_json_add_name_int */
+static int bench_check_params(void) {
+	char buf_before[64];
+	char buf_after[64];
+	LOJsonWriter_t jw;
+	LiveObjectsD_Data_t d;
+	int i;
+
+	d.data_dim = 1;
+	d.data_name = "p";
+	for (i = 0; i < EDGE_NB(_v_i32_edge) + EDGE_NB(_v_u32_edge); i++) {
+		if (i < EDGE_NB(_v_i32_edge)) {
+			d.data_type = LOD_TYPE_INT32;
+			d.data_value = &_v_i32_edge[i];
+		}
+		else {
+			d.data_type = LOD_TYPE_UINT32;
+			d.data_value = &_v_u32_edge[i - EDGE_NB(_v_i32_edge)];
+		}
+		buf_before[0] = 0;
+		LO_json_init(&jw, buf_after, sizeof(buf_after));
+		if (legacy_json_add_param(&d, buf_before, sizeof(buf_before)) || LO_json_add_param(&jw, &d)
+				|| strcmp(buf_before, buf_after)) {
+			fprintf(stderr, "ERROR: param output differs\n before: %s\n after:  %s\n", buf_before, buf_after);
+			return -1;
+		}
+		if (d.data_type == LOD_TYPE_INT32) {
+			buf_before[0] = 0;
+			LO_json_init(&jw, buf_after, sizeof(buf_after));
+			if (legacy_json_add_name_int("n", _v_i32_edge[i], buf_before, sizeof(buf_before))
+					|| LO_json_add_name_int(&jw, "n", _v_i32_edge[i]) || strcmp(buf_before, buf_after)) {
+				fprintf(stderr, "ERROR: name_int output differs\n before: %s\n after:  %s\n", buf_before,
+						buf_after);
+				return -1;
+			}
+		}
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Same sequence as LO_msg_encode_data_buf() - former API */
+static int bench_encode_before(char* buf_ptr, uint32_t buf_len, const BenchDataSet_t* set) {
+	int i, ret;
+	ret = legacy_json_begin(buf_ptr, buf_len);
+	if (ret == 0)
+		ret = legacy_json_add_name_str("s", "urn:lo:nsid:bench:dev01!data", buf_ptr, buf_len);
+	if (ret == 0)
+		ret = legacy_json_add_name_str("m", "bench_model_v1", buf_ptr, buf_len);
+	if (ret == 0)
+		ret = legacy_json_add_section_start("v", buf_ptr, buf_len);
+	for (i = 0; (ret == 0) && (i < set->items_nb); i++)
+		ret = legacy_json_add_item(&set->items[i], buf_ptr, buf_len);
+	if (ret == 0)
+		ret = legacy_json_add_section_end(buf_ptr, buf_len);
+	if (ret == 0)
+		ret = legacy_json_add_name_array("t", "\"bench\",\"host\"", buf_ptr, buf_len);
+	if (ret == 0)
+		ret = legacy_json_end(buf_ptr, buf_len);
+	return ret;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Same sequence as LO_msg_encode_data_buf() - JSON writer */
+static int bench_encode_after(char* buf_ptr, uint32_t buf_len, const BenchDataSet_t* set) {
+	int i, ret;
+	LOJsonWriter_t jw;
+	LO_json_init(&jw, buf_ptr, buf_len);
+	ret = LO_json_begin(&jw);
+	if (ret == 0)
+		ret = LO_json_add_name_str(&jw, "s", "urn:lo:nsid:bench:dev01!data");
+	if (ret == 0)
+		ret = LO_json_add_name_str(&jw, "m", "bench_model_v1");
+	if (ret == 0)
+		ret = LO_json_add_section_start(&jw, "v");
+	for (i = 0; (ret == 0) && (i < set->items_nb); i++)
+		ret = LO_json_add_item(&jw, &set->items[i]);
+	if (ret == 0)
+		ret = LO_json_add_section_end(&jw);
+	if (ret == 0)
+		ret = LO_json_add_name_array(&jw, "t", "\"bench\",\"host\"");
+	if (ret == 0)
+		ret = LO_json_end(&jw);
+	return ret;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static double bench_run(int (*fct)(char*, uint32_t, const BenchDataSet_t*), char* buf_ptr,
+		const BenchDataSet_t* set, uint64_t min_time_ns, uint32_t* out_len) {
+	uint64_t t0, dt;
+	uint32_t iter = 0;
+	uint32_t n = 64;
+	t0 = bench_now_ns();
+	do {
+		uint32_t k;
+		for (k = 0; k < n; k++) {
+			if (fct(buf_ptr, BENCH_BUF_SZ, set)) {
+				fprintf(stderr, "ERROR: encoding of '%s' failed\n", set->name);
+				exit(1);
+			}
+		}
+		iter += n;
+		dt = bench_now_ns() - t0;
+	} while (dt < min_time_ns);
+	*out_len = strlen(buf_ptr);
+	return (double) dt / iter;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int main(int argc, char* argv[]) {
+	static BenchDataSet_t sets[8];
+	void (*builders[8])(BenchDataSet_t*) = { bench_set_small, bench_set_1k, bench_set_2k, bench_set_arrays,
+			bench_set_int_arrays, bench_set_int_edges, bench_set_floats, bench_set_float_arrays };
+	uint64_t min_time_ns = (uint64_t) BENCH_MIN_TIME_MS * 1000000ULL;
+	int i;
+
+	if (argc > 1) {
+		min_time_ns = (uint64_t) strtoul(argv[1], NULL, 10) * 1000000ULL;
+	}
+
+	bench_init_values();
+
+	if ((bench_check_params()) || (bench_check_floats())) {
+		return 1;
+	}
+
+	printf("%-20s %8s %8s %12s %12s %8s\n", "data set", "before B", "after B", "before ns", "after ns",
+			"speedup");
+	for (i = 0; i < 8; i++) {
+		uint32_t len_before, len_after;
+		double ns_before, ns_after;
+		int j, has_fp = 0;
+
+		builders[i](&sets[i]);
+		for (j = 0; j < sets[i].items_nb; j++) {
+			if ((sets[i].items[j].data_type == LOD_TYPE_FLOAT) || (sets[i].items[j].data_type == LOD_TYPE_DOUBLE))
+				has_fp = 1;
+		}
+
+		ns_before = bench_run(bench_encode_before, _buf_before, &sets[i], min_time_ns, &len_before);
+		ns_after = bench_run(bench_encode_after, _buf_after, &sets[i], min_time_ns, &len_after);
+
+		if ((!has_fp) && ((len_before != len_after) || memcmp(_buf_before, _buf_after, len_after))) {
+			fprintf(stderr, "ERROR: '%s' output differs\n before: %s\n after:  %s\n", sets[i].name,
+					_buf_before, _buf_after);
+			return 1;
+		}
+
+		printf("%-20s %8u %8u %12.0f %12.0f %7.2fx\n", sets[i].name, len_before, len_after, ns_before, ns_after,
+				ns_before / ns_after);
+	}
+	return 0;
+}
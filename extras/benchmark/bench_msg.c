@@ -0,0 +1,691 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  bench_msg.c
+ * @brief Host benchmark of the encode/decode/publish hot paths:
+ *        LO_msg_encode_data (with and without pre-rendered skeleton), LO_msg_encode_status, LO_msg_encode_params_all,
+ *        LO_msg_decode_cmd_req, LO_msg_decode_params_req (per param and batch callbacks), LO_msg_decode_rsc_req
+ *        and MQTTSerialize_publish, with parameterized payload shapes.
+ *        publish_data_copy / publish_data_inplace compare the two ways to build a 'dev/data' publish packet:
+ *        JSON encoded in a separate buffer then copied by MQTTSerialize_publish, or encoded in place in the
+ *        MQTT send buffer (LOM_ENCODE_IN_MQTT_BUF) with only the header serialized in front of it.
+ *        route_publish finds the message handler of a received publish among items_nb subscribed topics.
+ *
+ * For each (operation, shape), it reports:
+ * - ns/op    : mean time of one operation,
+ * - bytes/op : size of the produced (encode) or consumed (decode) payload,
+ *              i.e. the minimum LOM_JSON_BUF_SZ / LOC_MQTT_DEF_SND_SZ / LOC_MQTT_DEF_RCV_SZ,
+ * - stack    : peak stack depth of one operation (stack painting, in bytes),
+ * - heap     : peak heap in use during one operation (in bytes).
+ * A failed operation (i.e. buffer or parser limit reached) is reported as "FAILED".
+ *
+ * Before the benchmark, it checks which data items are published when a publish filter is set
+ * (LO_msg_data_check, with and without report-by-exception).
+ *
+ * Usage: bench_msg [min_time_ms | check]
+ */
+
+#include <malloc.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "liveobjects-client/LiveObjectsClient_Config.h"
+#include "liveobjects-sys/loc_trace.h"
+
+#include "iotsoftbox-core/loc_msg.h"
+
+#include "MQTTPacket/MQTTPacket.h"
+#include "paho-mqttclient-embedded-c/MQTTClient.h"
+
+#define BENCH_MIN_TIME_MS     200
+#define BENCH_MAX_ITEMS       64
+#define BENCH_MAX_STR_LEN     256
+#define BENCH_PAYLOAD_SZ      (1024*32)
+#define BENCH_STACK_PAINT_SZ  (1024*64)
+#define BENCH_STACK_PATTERN   0xA5
+#define BENCH_PUB_HDR_SZ      (1 + 4 + 2 + 16 + 2)
+
+/* ================================================================================= */
+/* Heap accounting (the benchmark is linked with -Wl,--wrap=malloc,--wrap=free,...)
+ */
+void* __real_malloc(size_t sz);
+void* __real_calloc(size_t n, size_t sz);
+void* __real_realloc(void* p, size_t sz);
+void  __real_free(void* p);
+
+static size_t _heap_cur;
+static size_t _heap_peak;
+
+void* __wrap_malloc(size_t sz) {
+	void* p = __real_malloc(sz);
+	if (p) {
+		_heap_cur += malloc_usable_size(p);
+		if (_heap_cur > _heap_peak)
+			_heap_peak = _heap_cur;
+	}
+	return p;
+}
+
+void* __wrap_calloc(size_t n, size_t sz) {
+	void* p = __real_calloc(n, sz);
+	if (p) {
+		_heap_cur += malloc_usable_size(p);
+		if (_heap_cur > _heap_peak)
+			_heap_peak = _heap_cur;
+	}
+	return p;
+}
+
+void* __wrap_realloc(void* p, size_t sz) {
+	size_t old = (p) ? malloc_usable_size(p) : 0;
+	void* q = __real_realloc(p, sz);
+	if (q) {
+		_heap_cur += malloc_usable_size(q) - old;
+		if (_heap_cur > _heap_peak)
+			_heap_peak = _heap_cur;
+	}
+	return q;
+}
+
+void __wrap_free(void* p) {
+	if (p)
+		_heap_cur -= malloc_usable_size(p);
+	__real_free(p);
+}
+
+/* ================================================================================= */
+/* Stack accounting (stack painting)
+ */
+static volatile uintptr_t _stack_low;
+
+/* --------------------------------------------------------------------------------- */
+/* Paint the stack area just below the caller frame */
+static void __attribute__((noinline)) bench_stack_paint(void) {
+	uint8_t buf[BENCH_STACK_PAINT_SZ];
+	memset(buf, BENCH_STACK_PATTERN, sizeof(buf));
+	_stack_low = (uintptr_t) buf;
+	__asm__ __volatile__("" : : "r"(buf) : "memory");
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Return the deepest stack depth used since bench_stack_paint(), from 'top' */
+static size_t __attribute__((noinline)) bench_stack_used(const uint8_t* top) {
+	const uint8_t* p = (const uint8_t*) _stack_low;
+	while ((p < top) && (*p == BENCH_STACK_PATTERN))
+		p++;
+	return (size_t) (top - p);
+}
+
+/* ================================================================================= */
+/* Payload shapes
+ */
+typedef struct {
+	int items_nb;   /* Number of items (data, params, command arguments, registered commands and resources) */
+	int data_dim;   /* Array dimension of each numeric item */
+	int str_len;    /* Length of string values */
+} BenchShape_t;
+
+static const BenchShape_t _shapes[] = {
+	{ 1, 1, 8 },
+	{ 4, 1, 16 },
+	{ 8, 1, 32 },
+	{ 16, 1, 32 },
+	{ 32, 1, 16 },
+	{ 4, 16, 16 },
+	{ 8, 32, 16 },
+	{ 4, 127, 16 },
+	{ 4, 1, 200 },
+};
+#define BENCH_SHAPES_NB (int)(sizeof(_shapes) / sizeof(BenchShape_t))
+
+static const BenchShape_t* _shape;
+
+static int32_t  _v_i32[128];
+static uint32_t _v_u32[128];
+static float    _v_f32[128];
+static uint8_t  _v_bool[128];
+static char     _v_str[BENCH_MAX_ITEMS][BENCH_MAX_STR_LEN + 1];
+static char     _names[BENCH_MAX_ITEMS][16];
+
+static LiveObjectsD_Data_t    _items[BENCH_MAX_ITEMS];
+static LiveObjectsD_Param_t   _params[BENCH_MAX_ITEMS];
+static LiveObjectsD_Command_t _cmds[BENCH_MAX_ITEMS];
+static LiveObjectsD_Resource_t _rscs[BENCH_MAX_ITEMS];
+
+static LOMSetOfData_t          _set_data;
+static LOMSetOfData_t          _set_data_noskel;
+static LOMArrayOfData_t        _set_status;
+static LOMArrayOfParams_t      _set_params;
+static LOMSetOfParams_t        _set_params_cb;
+static LOMSetOfParams_t        _set_params_batch;
+static LOMSetofCommands_t      _set_cmds;
+static LOMSetOfResources_t     _set_rscs;
+static LOMSetofUpdatedParams_t _upd_params;
+static LOMSetOfUpdatedResource_t _upd_rsc;
+
+static char          _payload_cmd[BENCH_PAYLOAD_SZ];
+static char          _payload_cfg[BENCH_PAYLOAD_SZ];
+static char          _payload_rsc[BENCH_PAYLOAD_SZ];
+static char          _payload_pub[BENCH_PAYLOAD_SZ];
+static unsigned char _mqtt_buf[BENCH_PAYLOAD_SZ + 256];
+static char          _json_buf[BENCH_PAYLOAD_SZ];
+static uint32_t      _out_len;
+
+static MQTTClient    _mqtt_client;
+static char          _topics[BENCH_MAX_ITEMS][32];
+static int           _topic_last;
+static uint32_t      _delivered;
+
+/* Not exported by MQTTClient.h */
+int deliverMessage(MQTTClient* c, MQTTString* topicName, MQTTMessage* message);
+
+/* --------------------------------------------------------------------------------- */
+/* User callbacks: accept everything */
+static int bench_cb_param(const LiveObjectsD_Param_t* param_ptr, const void* value, int len) {
+	(void)param_ptr;
+	(void)value;
+	(void)len;
+	return 0;
+}
+
+static int bench_cb_param_batch(const LiveObjectsD_ParamUpdate_t* upd_ptr, int upd_nb) {
+	(void)upd_ptr;
+	(void)upd_nb;
+	return 0;
+}
+
+static int bench_cb_command(LiveObjectsD_CommandRequestBlock_t* pCmdReqBlk) {
+	return (pCmdReqBlk->hd.cmd_args_nb < 0xFFFF) ? 1 : 0;
+}
+
+static void bench_cb_message(MessageData* md) {
+	_delivered += md->message->payloadlen;
+}
+
+static LiveObjectsD_ResourceRespCode_t bench_cb_rsc_ntfy(uint8_t state, const LiveObjectsD_Resource_t* rsc_ptr,
+		const char* version_old, const char* version_new, uint32_t size) {
+	(void)state;
+	(void)rsc_ptr;
+	(void)version_old;
+	(void)version_new;
+	(void)size;
+	return RSC_RSP_OK;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static uint64_t bench_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void bench_init_values(void) {
+	int i;
+	for (i = 0; i < 128; i++) {
+		_v_i32[i] = (i * 7919) - 300000;
+		_v_u32[i] = 4000000000U - (uint32_t) (i * 104729);
+		_v_f32[i] = 21.5f + (float) i * 0.25f;
+		_v_bool[i] = (uint8_t) (i & 1);
+	}
+	for (i = 0; i < BENCH_MAX_ITEMS; i++) {
+		snprintf(_names[i], sizeof(_names[i]), "item_%02d", i);
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Build the data/status/params sets and the received payloads for the given shape */
+static void bench_build(const BenchShape_t* shape) {
+	int i, n;
+	char* pc;
+	char* end;
+
+	_shape = shape;
+
+	for (i = 0; i < shape->items_nb; i++) {
+		LiveObjectsD_Data_t* p = &_items[i];
+		memset(_v_str[i], 'a' + (i % 26), shape->str_len);
+		_v_str[i][shape->str_len] = 0;
+		p->data_name = _names[i];
+		p->data_dim = (int8_t) shape->data_dim;
+		switch (i % 4) {
+		case 0: p->data_type = LOD_TYPE_INT32; p->data_value = _v_i32; break;
+		case 1: p->data_type = LOD_TYPE_UINT32; p->data_value = _v_u32; break;
+		case 2: p->data_type = LOD_TYPE_FLOAT; p->data_value = _v_f32; break;
+		default: p->data_type = LOD_TYPE_STRING_C; p->data_value = _v_str[i]; p->data_dim = 1; break;
+		}
+		_params[i].parm_uref = i + 1;
+		_params[i].parm_data = *p;
+		_params[i].parm_data.data_dim = 1;
+	}
+
+	memset(&_set_data, 0, sizeof(_set_data));
+	_set_data.data_set.data_ptr = _items;
+	_set_data.data_set.data_nb = shape->items_nb;
+	strcpy(_set_data.stream_id, "urn:lo:nsid:bench:dev01!data");
+#if (LOM_SETOFDATA_MODEL_SZ > 0)
+	strcpy(_set_data.model, "bench_model_v1");
+#endif
+#if (LOM_SETOFDATA_TAGS_SZ > 0)
+	strcpy(_set_data.tags, "\"bench\",\"host\"");
+#endif
+
+	/* As LiveObjectsClient_AttachData() does. Without skeleton: full encoding at each push */
+	_set_data_noskel = _set_data;
+	LO_msg_encode_data_skeleton(&_set_data);
+
+	_set_status.data_ptr = _items;
+	_set_status.data_nb = shape->items_nb;
+
+	_set_params.param_ptr = _params;
+	_set_params.param_nb = shape->items_nb;
+
+	_set_params_cb.param_set = _set_params;
+	_set_params_cb.param_callback = bench_cb_param;
+	LO_msg_name_index_build(&_set_params_cb.param_index, _params, shape->items_nb, sizeof(LiveObjectsD_Param_t),
+			offsetof(LiveObjectsD_Param_t, parm_data.data_name));
+
+	_set_params_batch = _set_params_cb;
+	_set_params_batch.param_callback = NULL;
+	_set_params_batch.param_batch_callback = bench_cb_param_batch;
+
+	/* items_nb commands and resources, the requested ones ("LED" and "message") being the last registered */
+	for (i = 0; i < shape->items_nb; i++) {
+		_cmds[i].cmd_uref = i + 1;
+		_cmds[i].cmd_name = (i == shape->items_nb - 1) ? "LED" : _names[i];
+		_rscs[i].rsc_uref = i + 1;
+		_rscs[i].rsc_name = (i == shape->items_nb - 1) ? "message" : _names[i];
+		_rscs[i].rsc_version_ptr = "01.00";
+		_rscs[i].rsc_version_sz = 5;
+	}
+
+	/* As LiveObjectsClient_AttachCommands() and LiveObjectsClient_AttachResources() do */
+	memset(&_set_cmds, 0, sizeof(_set_cmds));
+	_set_cmds.cmd_enable = 1;
+	_set_cmds.cmd_ptr = _cmds;
+	_set_cmds.cmd_nb = shape->items_nb;
+	_set_cmds.cmd_callback = bench_cb_command;
+	LO_msg_name_index_build(&_set_cmds.cmd_index, _cmds, shape->items_nb, sizeof(LiveObjectsD_Command_t),
+			offsetof(LiveObjectsD_Command_t, cmd_name));
+
+	memset(&_set_rscs, 0, sizeof(_set_rscs));
+	_set_rscs.rsc_enable = 1;
+	_set_rscs.rsc_ptr = _rscs;
+	_set_rscs.rsc_nb = shape->items_nb;
+	_set_rscs.rsc_cb_ntfy = bench_cb_rsc_ntfy;
+	LO_msg_name_index_build(&_set_rscs.rsc_index, _rscs, shape->items_nb, sizeof(LiveObjectsD_Resource_t),
+			offsetof(LiveObjectsD_Resource_t, rsc_name));
+
+	/* items_nb subscribed topics (up to MAX_MESSAGE_HANDLERS), the received one being the last registered */
+	MQTTClientInit(&_mqtt_client, NULL, 1000, NULL, 0, NULL, 0);
+	_topic_last = (shape->items_nb < MAX_MESSAGE_HANDLERS) ? shape->items_nb - 1 : MAX_MESSAGE_HANDLERS - 1;
+	for (i = 0; i <= _topic_last; i++) {
+		snprintf(_topics[i], sizeof(_topics[i]), "gw/dev_%02d/cmd", i);
+		MQTTSetMessageHandler(&_mqtt_client, _topics[i], bench_cb_message);
+	}
+
+	/* dev/cmd : {"req":"LED","arg":{"item_00":"aaa",...},"cid":12345} */
+	pc = _payload_cmd;
+	end = _payload_cmd + sizeof(_payload_cmd);
+	pc += snprintf(pc, end - pc, "{\"req\":\"LED\",\"arg\":{");
+	for (i = 0; i < shape->items_nb; i++) {
+		pc += snprintf(pc, end - pc, "%s\"%s\":\"%s\"", (i) ? "," : "", _names[i], _v_str[i]);
+	}
+	snprintf(pc, end - pc, "},\"cid\":12345}");
+
+	/* dev/cfg/upd : {"cfg":{"item_00":{"t":"i32","v":-300000},...},"cid":12346} */
+	pc = _payload_cfg;
+	end = _payload_cfg + sizeof(_payload_cfg);
+	pc += snprintf(pc, end - pc, "{\"cfg\":{");
+	for (i = 0; i < shape->items_nb; i++) {
+		const char* sep = (i) ? "," : "";
+		switch (_items[i].data_type) {
+		case LOD_TYPE_INT32:
+			pc += snprintf(pc, end - pc, "%s\"%s\":{\"t\":\"i32\",\"v\":%" PRIi32 "}", sep, _names[i], _v_i32[i]);
+			break;
+		case LOD_TYPE_UINT32:
+			pc += snprintf(pc, end - pc, "%s\"%s\":{\"t\":\"u32\",\"v\":%" PRIu32 "}", sep, _names[i], _v_u32[i]);
+			break;
+		case LOD_TYPE_FLOAT:
+			pc += snprintf(pc, end - pc, "%s\"%s\":{\"t\":\"f64\",\"v\":%f}", sep, _names[i], _v_f32[i]);
+			break;
+		default:
+			pc += snprintf(pc, end - pc, "%s\"%s\":{\"t\":\"str\",\"v\":\"%s\"}", sep, _names[i], _v_str[i]);
+			break;
+		}
+	}
+	snprintf(pc, end - pc, "},\"cid\":12346}");
+
+	/* dev/rsc/upd (the decoder expects the metadata "size" as a JSON string) */
+	n = shape->str_len;
+	if (n > 60)
+		n = 60;
+	snprintf(_payload_rsc, sizeof(_payload_rsc),
+			"{\"id\":\"message\",\"old\":\"01.00\",\"new\":\"02.00\",\"m\":{\"uri\":\"http://liveobjects/rsc/%.*s\","
+			"\"md5\":\"0123456789abcdef0123456789ABCDEF\",\"size\":\"%d\"},\"cid\":12347}", n, _v_str[0],
+			shape->items_nb * shape->str_len);
+
+	/* MQTT payload: the encoded data message, which must not depend on the skeleton */
+	_payload_pub[0] = 0;
+	{
+		const char* msg = LO_msg_encode_data(0, &_set_data_noskel);
+		if (msg)
+			strcpy(_payload_pub, msg);
+		msg = LO_msg_encode_data(0, &_set_data);
+		if ((msg) && strcmp(msg, _payload_pub)) {
+			fprintf(stderr, "ERROR: data message differs\n skeleton: %s\n full:     %s\n", msg, _payload_pub);
+			exit(1);
+		}
+	}
+}
+
+/* ================================================================================= */
+/* Operations: return 0 if successful
+ */
+
+static int bench_op_encode_data(void) {
+	const char* msg = LO_msg_encode_data(0, &_set_data);
+	if (msg == NULL)
+		return -1;
+	_out_len = strlen(msg);
+	return 0;
+}
+
+static int bench_op_encode_data_noskel(void) {
+	const char* msg = LO_msg_encode_data(0, &_set_data_noskel);
+	if (msg == NULL)
+		return -1;
+	_out_len = strlen(msg);
+	return 0;
+}
+
+static int bench_op_encode_status(void) {
+	const char* msg = LO_msg_encode_status(0, &_set_status);
+	if (msg == NULL)
+		return -1;
+	_out_len = strlen(msg);
+	return 0;
+}
+
+static int bench_op_encode_params_all(void) {
+	const char* msg = LO_msg_encode_params_all(0, &_set_params, 0);
+	if (msg == NULL)
+		return -1;
+	_out_len = strlen(msg);
+	return 0;
+}
+
+static int bench_op_decode_cmd_req(void) {
+	int32_t cid;
+	uint32_t len = strlen(_payload_cmd);
+	int ret = LO_msg_decode_cmd_req(_payload_cmd, len, &_set_cmds, &cid);
+	_out_len = len;
+	return ((ret == 1) && (cid == 12345)) ? 0 : -1;
+}
+
+static int bench_op_decode_params_req(void) {
+	uint32_t len = strlen(_payload_cfg);
+	int ret = LO_msg_decode_params_req(_payload_cfg, len, &_set_params_cb, &_upd_params);
+	_out_len = len;
+	return ((ret == 0) && (_upd_params.cid == 12346)) ? 0 : -1;
+}
+
+static int bench_op_decode_params_batch(void) {
+	uint32_t len = strlen(_payload_cfg);
+	int ret = LO_msg_decode_params_req(_payload_cfg, len, &_set_params_batch, &_upd_params);
+	_out_len = len;
+	return ((ret == 0) && (_upd_params.cid == 12346)) ? 0 : -1;
+}
+
+static int bench_op_decode_rsc_req(void) {
+	int32_t cid;
+	uint32_t len = strlen(_payload_rsc);
+	LiveObjectsD_ResourceRespCode_t ret;
+	_upd_rsc.ursc_cid = 0;
+	ret = LO_msg_decode_rsc_req(_payload_rsc, len, &_set_rscs, &_upd_rsc, &cid);
+	_out_len = len;
+	return ((ret == RSC_RSP_OK) && (cid == 12347)) ? 0 : -1;
+}
+
+static int bench_op_serialize_publish(void) {
+	int ret;
+	MQTTString topic = MQTTString_initializer;
+	int len = strlen(_payload_pub);
+	if (len == 0)
+		return -1;
+	topic.cstring = (char*) "dev/data";
+	ret = MQTTSerialize_publish(_mqtt_buf, LOC_MQTT_DEF_SND_SZ, 0, 0, 0, 0, topic, (unsigned char*) _payload_pub,
+			len);
+	if (ret <= 0)
+		return -1;
+	_out_len = ret;
+	return 0;
+}
+
+static int bench_op_publish_data_copy(void) {
+	int ret;
+	MQTTString topic = MQTTString_initializer;
+	const char* msg = LO_msg_encode_data(0, &_set_data);
+	if (msg == NULL)
+		return -1;
+	topic.cstring = (char*) "dev/data";
+	ret = MQTTSerialize_publish(_mqtt_buf, LOC_MQTT_DEF_SND_SZ, 0, 0, 0, 0, topic, (unsigned char*) msg, strlen(msg));
+	if (ret <= 0)
+		return -1;
+	_out_len = ret;
+	return 0;
+}
+
+#if LOM_ENCODE_IN_MQTT_BUF
+static int bench_op_publish_data_inplace(void) {
+	int ret, len;
+	MQTTString topic = MQTTString_initializer;
+	const char* msg;
+	LO_msg_encode_set_buffer((char*) &_mqtt_buf[BENCH_PUB_HDR_SZ], LOC_MQTT_DEF_SND_SZ - BENCH_PUB_HDR_SZ);
+	msg = LO_msg_encode_data(0, &_set_data);
+	LO_msg_encode_set_buffer(_json_buf, sizeof(_json_buf));
+	if (msg == NULL)
+		return -1;
+	topic.cstring = (char*) "dev/data";
+	len = strlen(msg);
+	ret = MQTTSerialize_publishHeaderLength(0, topic, len);
+	ret = MQTTSerialize_publishHeader((unsigned char*) msg - ret, ret, 0, 0, 0, 0, topic, len);
+	if (ret <= 0)
+		return -1;
+	_out_len = ret + len;
+	return 0;
+}
+#endif
+
+static int bench_op_route_publish(void) {
+	MQTTString topic = MQTTString_initializer;
+	MQTTMessage msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.payload = _payload_pub;
+	msg.payloadlen = 1;
+	topic.lenstring.data = _topics[_topic_last];
+	topic.lenstring.len = strlen(_topics[_topic_last]);
+	_delivered = 0;
+	if ((deliverMessage(&_mqtt_client, &topic, &msg) != SUCCESS) || (_delivered != 1))
+		return -1;
+	_out_len = topic.lenstring.len;
+	return 0;
+}
+
+typedef struct {
+	const char* name;
+	int (*fct)(void);
+} BenchOp_t;
+
+static const BenchOp_t _ops[] = {
+	{ "encode_data", bench_op_encode_data },
+	{ "encode_data_noskel", bench_op_encode_data_noskel },
+	{ "encode_status", bench_op_encode_status },
+	{ "encode_params_all", bench_op_encode_params_all },
+	{ "decode_cmd_req", bench_op_decode_cmd_req },
+	{ "decode_params_req", bench_op_decode_params_req },
+	{ "decode_params_batch", bench_op_decode_params_batch },
+	{ "decode_rsc_req", bench_op_decode_rsc_req },
+	{ "serialize_publish", bench_op_serialize_publish },
+	{ "publish_data_copy", bench_op_publish_data_copy },
+	{ "route_publish", bench_op_route_publish },
+#if LOM_ENCODE_IN_MQTT_BUF
+	{ "publish_data_inplace", bench_op_publish_data_inplace },
+#endif
+};
+#define BENCH_OPS_NB (int)(sizeof(_ops) / sizeof(BenchOp_t))
+
+/* --------------------------------------------------------------------------------- */
+/* Run once to get the peak stack and heap, then loop to get the time */
+static int __attribute__((noinline)) bench_run(const BenchOp_t* op, uint64_t min_time_ns, double* ns_op,
+		size_t* stack, size_t* heap) {
+	uint64_t t0, dt;
+	uint32_t iter = 0;
+	uint32_t n = 16;
+	const uint8_t* top = (const uint8_t*) __builtin_frame_address(0);
+	int ret;
+
+	bench_stack_paint();
+	_heap_peak = _heap_cur;
+	ret = op->fct();
+	*stack = bench_stack_used(top);
+	*heap = _heap_peak - _heap_cur;
+	if (ret)
+		return ret;
+
+	t0 = bench_now_ns();
+	do {
+		uint32_t k;
+		for (k = 0; k < n; k++) {
+			op->fct();
+		}
+		iter += n;
+		dt = bench_now_ns() - t0;
+	} while (dt < min_time_ns);
+	*ns_op = (double) dt / iter;
+	return 0;
+}
+
+#if (LOM_SETOFDATA_FILTER_NB > 0) && (LOM_SETOFDATA_RBE_NB > 0)
+/* ================================================================================= */
+/* Check of the data items to be published (LO_msg_data_check) when a publish filter is set:
+ * with report-by-exception, an item without filter is published when it changed; without,
+ * it is published at each push, so the set is published at each push.
+ * Return the number of failed steps.
+ */
+static int bench_check_step(LOMSetOfData_t* p_set, const char* step, int expected) {
+	int nb = LO_msg_data_check(p_set);
+	LO_msg_data_done(p_set);
+	if (nb != expected) {
+		fprintf(stderr, "ERROR: data_check %s: %d items to publish, expected %d\n", step, nb, expected);
+		return 1;
+	}
+	return 0;
+}
+
+static int bench_check_data_filter(void) {
+	static int32_t v_filtered;
+	static int32_t v_other;
+	static LiveObjectsD_Data_t items[] = {
+		{ LOD_TYPE_INT32, "filtered", &v_filtered, 1, 0 },
+		{ LOD_TYPE_INT32, "other",    &v_other, 1, 0 }
+	};
+	static LOMSetOfData_t set;
+	int err = 0;
+	int rbe;
+
+	for (rbe = 0; rbe <= 1; rbe++) {
+		memset(&set, 0, sizeof(set));
+		set.data_set.data_ptr = items;
+		set.data_set.data_nb = 2;
+		strcpy(set.stream_id, "check");
+		set.rbe_enabled = (uint8_t) rbe;
+		v_filtered = 100;
+		v_other = 0;
+		LO_msg_data_filter_set(&set, 0, 10.0f, 0, 0, 0);
+
+		err += bench_check_step(&set, (rbe) ? "rbe, first push" : "first push", 2);
+		/* unchanged: the item without filter is published at each push without report-by-exception */
+		err += bench_check_step(&set, (rbe) ? "rbe, unchanged" : "unchanged", (rbe) ? 0 : 2);
+		v_other = 1;
+		err += bench_check_step(&set, (rbe) ? "rbe, other changed" : "other changed", (rbe) ? 1 : 2);
+		v_filtered = 105;
+		err += bench_check_step(&set, (rbe) ? "rbe, in deadband" : "in deadband", (rbe) ? 0 : 2);
+		v_filtered = 120;
+		err += bench_check_step(&set, (rbe) ? "rbe, out of deadband" : "out of deadband", (rbe) ? 1 : 2);
+
+		/* all the items have a filter: the set is published only when one of them is out of its deadband */
+		LO_msg_data_filter_set(&set, 1, 10.0f, 0, 0, 0);
+		err += bench_check_step(&set, (rbe) ? "rbe, all filtered, first" : "all filtered, first", (rbe) ? 1 : 2);
+		v_other = 5;
+		err += bench_check_step(&set, (rbe) ? "rbe, all filtered, in deadband" : "all filtered, in deadband", 0);
+		v_other = 50;
+		err += bench_check_step(&set, (rbe) ? "rbe, all filtered, out of deadband" : "all filtered, out of deadband",
+				(rbe) ? 1 : 2);
+	}
+	return err;
+}
+#endif
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int main(int argc, char* argv[]) {
+	uint64_t min_time_ns = (uint64_t) BENCH_MIN_TIME_MS * 1000000ULL;
+	int i, j;
+
+	/* Only the errors, even if the library is built with all traces */
+	lo_trace_init(0);
+
+#if (LOM_SETOFDATA_FILTER_NB > 0) && (LOM_SETOFDATA_RBE_NB > 0)
+	if (bench_check_data_filter()) {
+		return 1;
+	}
+#endif
+	if ((argc > 1) && (strcmp(argv[1], "check") == 0)) {
+		printf("checks OK\n");
+		return 0;
+	}
+	if (argc > 1) {
+		min_time_ns = (uint64_t) strtoul(argv[1], NULL, 10) * 1000000ULL;
+	}
+
+#if LOM_ENCODE_IN_MQTT_BUF
+	/* JSON buffer of the encode_xxx operations (in the library, it is the MQTT send buffer) */
+	LO_msg_encode_set_buffer(_json_buf, sizeof(_json_buf));
+#endif
+
+	bench_init_values();
+
+	printf("LOM_JSON_BUF_SZ=%u LOC_MQTT_DEF_SND_SZ=%u LOC_PARAMS_BATCH_SZ=%u\n", LOM_JSON_BUF_SZ,
+			LOC_MQTT_DEF_SND_SZ, LOC_PARAMS_BATCH_SZ);
+	printf("%-20s %5s %4s %4s %12s %9s %8s %8s\n", "operation", "items", "dim", "str", "ns/op", "bytes/op",
+			"stack", "heap");
+	for (j = 0; j < BENCH_SHAPES_NB; j++) {
+		bench_build(&_shapes[j]);
+		for (i = 0; i < BENCH_OPS_NB; i++) {
+			double ns_op = 0;
+			size_t stack = 0, heap = 0;
+			int ret;
+			_out_len = 0;
+			ret = bench_run(&_ops[i], min_time_ns, &ns_op, &stack, &heap);
+			printf("%-20s %5d %4d %4d ", _ops[i].name, _shape->items_nb, _shape->data_dim, _shape->str_len);
+			if (ret)
+				printf("%12s %9s %8zu %8zu\n", "FAILED", "-", stack, heap);
+			else
+				printf("%12.0f %9" PRIu32 " %8zu %8zu\n", ns_op, _out_len, stack, heap);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  bench_num.c
+ * @brief Host micro-benchmark: parsing of the numeric values received in configuration updates
+ *        and command arguments, former sscanf based getValue functions (before) versus the
+ *        length-bounded LO_json_get_xxx parsers (after).
+ *
+ * Values are parsed in place, in a JSON text (as given by the JSON reader), and the results
+ * of both versions must be identical.
+ *
+ * Usage: bench_num [min_time_ms]
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "iotsoftbox-core/loc_json_api.h"
+
+#define BENCH_BUF_SZ          (1024*8)
+#define BENCH_MAX_VALUES      256
+#define BENCH_MIN_TIME_MS     300
+
+typedef enum {
+	BENCH_NUM_I32 = 0,
+	BENCH_NUM_U32,
+	BENCH_NUM_FLOAT,
+	BENCH_NUM_DOUBLE
+} BenchNumType_t;
+
+typedef struct {
+	const char* name;
+	BenchNumType_t type;
+	const char* const* values;
+	int values_nb;
+} BenchNumSet_t;
+
+/* A value in the received JSON text */
+typedef struct {
+	const char* val_ptr;
+	uint32_t val_len;
+} BenchNumToken_t;
+
+static const char* const _v_i32[] = { "0", "1", "-1", "9", "10", "-99", "100", "1000", "60", "3600", "-40", "86400",
+		"-300000", "123456", "-1000000000", "2147483647", "-2147483648" };
+static const char* const _v_u32[] = { "0", "1", "5", "10", "30", "60", "100", "255", "1000", "3600", "65535", "65536",
+		"86400", "1000000", "999999999", "4000000000", "4294967295" };
+static const char* const _v_float[] = { "0", "1", "-1", "0.5", "21.5", "21.75", "-12.25", "3.14159", "100.1",
+		"0.001", "-273.15", "1013.25", "48.8566", "2.3522", "1e3", "1.5E-3", "65535.5" };
+static const char* const _v_double[] = { "0", "1", "0.1", "-0.5", "48.856614", "2.3522219", "-273.15",
+		"1013.25", "3.141592653589793", "2.718281828459045", "123456.789", "0.000123", "1e-7", "6.02214076e23",
+		"1.7976931348623157e308", "5e-324", "9007199254740993" };
+
+#define VALUES_NB(a)  ((int) (sizeof(a) / sizeof(a[0])))
+
+static char _json_buf[BENCH_BUF_SZ];
+static BenchNumToken_t _tokens[BENCH_MAX_VALUES];
+static int _tokens_nb;
+
+static union {
+	int32_t i32[BENCH_MAX_VALUES];
+	uint32_t u32[BENCH_MAX_VALUES];
+	float f32[BENCH_MAX_VALUES];
+	double f64[BENCH_MAX_VALUES];
+} _out_before, _out_after;
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static uint64_t bench_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Build a configuration update with all the values of a set, and keep the position of each value */
+static void bench_build_cfg(const BenchNumSet_t* set) {
+	static const char* const types[] = { "i32", "u32", "f64", "f64" };
+	uint32_t len;
+	int i;
+
+	len = (uint32_t) snprintf(_json_buf, BENCH_BUF_SZ, "{\"cfg\":{");
+	_tokens_nb = 0;
+	for (i = 0; (i < set->values_nb) && (_tokens_nb < BENCH_MAX_VALUES); i++) {
+		len += (uint32_t) snprintf(_json_buf + len, BENCH_BUF_SZ - len, "%s\"p%02d\":{\"t\":\"%s\",\"v\":", (i) ? "," : "",
+				i, types[set->type]);
+		_tokens[_tokens_nb].val_ptr = _json_buf + len;
+		_tokens[_tokens_nb].val_len = (uint32_t) strlen(set->values[i]);
+		_tokens_nb++;
+		len += (uint32_t) snprintf(_json_buf + len, BENCH_BUF_SZ - len, "%s}", set->values[i]);
+	}
+	snprintf(_json_buf + len, BENCH_BUF_SZ - len, "},\"cid\":12345}");
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Former getValue functions: sscanf on the JSON text (stops at the first character after the value) */
+static int bench_parse_before(const BenchNumSet_t* set) {
+	int i;
+	for (i = 0; i < _tokens_nb; i++) {
+		const char* p = _tokens[i].val_ptr;
+		int rc;
+		switch (set->type) {
+		case BENCH_NUM_I32: rc = sscanf(p, "%" SCNi32, &_out_before.i32[i]); break;
+		case BENCH_NUM_U32: rc = sscanf(p, "%" SCNu32, &_out_before.u32[i]); break;
+		case BENCH_NUM_FLOAT: rc = sscanf(p, "%f", &_out_before.f32[i]); break;
+		default: rc = sscanf(p, "%lf", &_out_before.f64[i]); break;
+		}
+		if (rc != 1)
+			return -1;
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int bench_parse_after(const BenchNumSet_t* set) {
+	int i;
+	for (i = 0; i < _tokens_nb; i++) {
+		const char* p = _tokens[i].val_ptr;
+		uint32_t len = _tokens[i].val_len;
+		int rc;
+		switch (set->type) {
+		case BENCH_NUM_I32: rc = LO_json_get_int32(p, len, &_out_after.i32[i]); break;
+		case BENCH_NUM_U32: rc = LO_json_get_uint32(p, len, &_out_after.u32[i]); break;
+		case BENCH_NUM_FLOAT: rc = LO_json_get_float(p, len, &_out_after.f32[i]); break;
+		default: rc = LO_json_get_double(p, len, &_out_after.f64[i]); break;
+		}
+		if (rc)
+			return -1;
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Return the mean time (ns) to parse one value */
+static double bench_run(int (*fct)(const BenchNumSet_t*), const BenchNumSet_t* set, uint64_t min_time_ns) {
+	uint64_t t0, dt;
+	uint64_t iter = 0;
+	uint32_t n = 64;
+	t0 = bench_now_ns();
+	do {
+		uint32_t k;
+		for (k = 0; k < n; k++) {
+			if (fct(set)) {
+				fprintf(stderr, "ERROR: parsing of '%s' failed\n", set->name);
+				exit(1);
+			}
+		}
+		iter += n;
+		dt = bench_now_ns() - t0;
+	} while (dt < min_time_ns);
+	return (double) dt / (iter * _tokens_nb);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Values refused by the JSON number grammar, or out of range */
+static int bench_check_invalid(void) {
+	static const char* const bad_int[] = { "", "-", "+1", "01", "1.0", "1e2", "0x10", "12a", "2147483648",
+			"-2147483649" };
+	static const char* const bad_dbl[] = { "", "-", "+1", "01", ".5", "1.", "1e", "1e+", "1.5x", "nan", "inf",
+			"1e309" };
+	int32_t i32;
+	uint32_t u32;
+	double f64;
+	float f32;
+	int i;
+
+	for (i = 0; i < VALUES_NB(bad_int); i++) {
+		if (!LO_json_get_int32(bad_int[i], (uint32_t) strlen(bad_int[i]), &i32)) {
+			fprintf(stderr, "ERROR: '%s' accepted as i32\n", bad_int[i]);
+			return 1;
+		}
+	}
+	if ((!LO_json_get_uint32("-1", 2, &u32)) || (!LO_json_get_uint32("4294967296", 10, &u32))) {
+		fprintf(stderr, "ERROR: out of range u32 accepted\n");
+		return 1;
+	}
+	for (i = 0; i < VALUES_NB(bad_dbl); i++) {
+		if (!LO_json_get_double(bad_dbl[i], (uint32_t) strlen(bad_dbl[i]), &f64)) {
+			fprintf(stderr, "ERROR: '%s' accepted as double\n", bad_dbl[i]);
+			return 1;
+		}
+	}
+	if (!LO_json_get_float("1e39", 4, &f32)) {
+		fprintf(stderr, "ERROR: out of range float accepted\n");
+		return 1;
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int main(int argc, char* argv[]) {
+	static const BenchNumSet_t sets[4] = {
+			{ "i32 values", BENCH_NUM_I32, _v_i32, VALUES_NB(_v_i32) },
+			{ "u32 values", BENCH_NUM_U32, _v_u32, VALUES_NB(_v_u32) },
+			{ "float values", BENCH_NUM_FLOAT, _v_float, VALUES_NB(_v_float) },
+			{ "double values", BENCH_NUM_DOUBLE, _v_double, VALUES_NB(_v_double) } };
+	uint64_t min_time_ns = (uint64_t) BENCH_MIN_TIME_MS * 1000000ULL;
+	int i;
+
+	if (argc > 1) {
+		min_time_ns = (uint64_t) strtoul(argv[1], NULL, 10) * 1000000ULL;
+	}
+
+	if (bench_check_invalid()) {
+		return 1;
+	}
+
+	printf("%-20s %8s %12s %12s %8s\n", "value set", "values", "before ns", "after ns", "speedup");
+	for (i = 0; i < 4; i++) {
+		double ns_before, ns_after;
+		int j;
+
+		bench_build_cfg(&sets[i]);
+		ns_before = bench_run(bench_parse_before, &sets[i], min_time_ns);
+		ns_after = bench_run(bench_parse_after, &sets[i], min_time_ns);
+
+		for (j = 0; j < _tokens_nb; j++) {
+			int same;
+			switch (sets[i].type) {
+			case BENCH_NUM_I32: same = (_out_before.i32[j] == _out_after.i32[j]); break;
+			case BENCH_NUM_U32: same = (_out_before.u32[j] == _out_after.u32[j]); break;
+			case BENCH_NUM_FLOAT: same = !memcmp(&_out_before.f32[j], &_out_after.f32[j], sizeof(float)); break;
+			default: same = !memcmp(&_out_before.f64[j], &_out_after.f64[j], sizeof(double)); break;
+			}
+			if (!same) {
+				fprintf(stderr, "ERROR: '%s' value '%.*s' differs\n", sets[i].name, (int) _tokens[j].val_len,
+						_tokens[j].val_ptr);
+				return 1;
+			}
+		}
+
+		printf("%-20s %8d %12.1f %12.1f %7.2fx\n", sets[i].name, _tokens_nb, ns_before, ns_after,
+				ns_before / ns_after);
+	}
+	return 0;
+}
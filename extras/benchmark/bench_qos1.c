@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  bench_qos1.c
+ * @brief Host benchmark: throughput of QoS1 messages over a link with a round trip time,
+ *        blocking MQTTPublish (before) versus MQTTPublishAsync with the in-flight window (after).
+ *
+ * The network is simulated: each PUBLISH packet written by the client is acknowledged (PUBACK)
+ * one round trip time later. All the messages must be acknowledged, once, in both cases.
+ *
+ * Usage: bench_qos1 [nb_of_messages]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "paho-mqttclient-embedded-c/MQTTClient.h"
+
+#define BENCH_MSG_NB          200
+#define BENCH_ACK_MAX         64
+#define BENCH_BUF_SZ          512
+
+/* PUBACK to send back to the client, at due_ns */
+typedef struct {
+	uint64_t due_ns;
+	unsigned char packet[4];
+} BenchAck_t;
+
+static struct {
+	uint64_t rtt_ns;
+	BenchAck_t acks[BENCH_ACK_MAX];
+	int ack_rd;
+	int ack_wr;
+	int ack_off;       /* bytes of the current PUBACK already read */
+	uint32_t published;
+} _link;
+
+static uint32_t _acked;
+static unsigned char _snd_buf[BENCH_BUF_SZ];
+static unsigned char _rcv_buf[BENCH_BUF_SZ];
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static uint64_t bench_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void bench_sleep_ns(uint64_t ns) {
+	struct timespec ts;
+	ts.tv_sec = (time_t) (ns / 1000000000ULL);
+	ts.tv_nsec = (long) (ns % 1000000000ULL);
+	nanosleep(&ts, NULL);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Simulated link, client to server: a PUBLISH QoS1 packet is acknowledged one round trip later */
+static int bench_link_write(Network* n, unsigned char* buf, int len, int timeout_ms) {
+	(void) n;
+	(void) timeout_ms;
+	if (((buf[0] & 0xF0) == 0x30) && ((buf[0] & 0x06) == 0x02)) {
+		unsigned char dup;
+		unsigned short id;
+		int qos;
+		unsigned char retained;
+		MQTTString topic;
+		unsigned char* payload;
+		int payloadlen;
+		BenchAck_t* ack;
+		if (MQTTDeserialize_publish(&dup, &qos, &retained, &id, &topic, &payload, &payloadlen, buf, len) != 1) {
+			return -1;
+		}
+		if (((_link.ack_wr + 1) % BENCH_ACK_MAX) == _link.ack_rd) {
+			return -1;
+		}
+		ack = &_link.acks[_link.ack_wr];
+		ack->due_ns = bench_now_ns() + _link.rtt_ns;
+		MQTTSerialize_ack(ack->packet, sizeof(ack->packet), PUBACK, 0, id);
+		_link.ack_wr = (_link.ack_wr + 1) % BENCH_ACK_MAX;
+		_link.published++;
+	}
+	return len;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Simulated link, server to client: waits (up to the timeout) for the next PUBACK */
+static int bench_link_read(Network* n, unsigned char* buf, int len, int timeout_ms) {
+	BenchAck_t* ack;
+	uint64_t now = bench_now_ns();
+	int nb;
+	(void) n;
+
+	if (_link.ack_rd == _link.ack_wr) {
+		bench_sleep_ns((uint64_t) timeout_ms * 1000000ULL);
+		return 0;
+	}
+	ack = &_link.acks[_link.ack_rd];
+	if (ack->due_ns > now) {
+		if (ack->due_ns - now > (uint64_t) timeout_ms * 1000000ULL) {
+			bench_sleep_ns((uint64_t) timeout_ms * 1000000ULL);
+			return 0;
+		}
+		bench_sleep_ns(ack->due_ns - now);
+	}
+	nb = (int) sizeof(ack->packet) - _link.ack_off;
+	if (nb > len) {
+		nb = len;
+	}
+	memcpy(buf, ack->packet + _link.ack_off, nb);
+	_link.ack_off += nb;
+	if (_link.ack_off == (int) sizeof(ack->packet)) {
+		_link.ack_off = 0;
+		_link.ack_rd = (_link.ack_rd + 1) % BENCH_ACK_MAX;
+	}
+	return nb;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void bench_link_init(MQTTClient* c, Network* n, uint32_t rtt_ms) {
+	memset(&_link, 0, sizeof(_link));
+	_link.rtt_ns = (uint64_t) rtt_ms * 1000000ULL;
+	_acked = 0;
+	n->mqttread = bench_link_read;
+	n->mqttwrite = bench_link_write;
+	n->mqttwritev = NULL;
+	MQTTClientInit(c, n, 5000, _snd_buf, sizeof(_snd_buf), _rcv_buf, sizeof(_rcv_buf));
+	c->isconnected = 1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void bench_completed(void* context, unsigned short id, int rc) {
+	(void) context;
+	(void) id;
+	if (rc == SUCCESS) {
+		_acked++;
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Return the number of messages per second */
+static double bench_run(int async, uint32_t rtt_ms, uint32_t msg_nb) {
+	static const char payload[] = "{\"s\":\"urn:lo:nsid:bench:qos1\",\"v\":{\"temp\":21.5,\"hum\":48}}";
+	MQTTClient c;
+	Network n;
+	uint64_t t0, dt;
+	uint32_t i;
+
+	bench_link_init(&c, &n, rtt_ms);
+	t0 = bench_now_ns();
+	for (i = 0; i < msg_nb; i++) {
+		MQTTMessage msg;
+		int rc;
+		memset(&msg, 0, sizeof(msg));
+		msg.qos = QOS1;
+		msg.payload = (void*) payload;
+		msg.payloadlen = sizeof(payload) - 1;
+		if (async) {
+			rc = MQTTPublishAsync(&c, "dev/data", &msg, bench_completed, NULL);
+		}
+		else {
+			rc = MQTTPublish(&c, "dev/data", &msg);
+			if (rc == SUCCESS) {
+				_acked++;
+			}
+		}
+		if (rc != SUCCESS) {
+			fprintf(stderr, "ERROR: publish %u failed, rc=%d\n", i, rc);
+			exit(1);
+		}
+	}
+	/* Wait for the last acknowledgements */
+	while (_acked < msg_nb) {
+		if (MQTTYield(&c, 1) == FAILURE) {
+			break;
+		}
+		if (bench_now_ns() - t0 > 60000000000ULL) {
+			break;
+		}
+	}
+	dt = bench_now_ns() - t0;
+
+	if ((_acked != msg_nb) || (_link.published != msg_nb)) {
+		fprintf(stderr, "ERROR: %u messages, %u published, %u acknowledged\n", msg_nb, _link.published, _acked);
+		exit(1);
+	}
+	return msg_nb * 1000000000.0 / dt;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int main(int argc, char* argv[]) {
+	static const uint32_t rtts[3] = { 2, 10, 50 };
+	uint32_t msg_nb = BENCH_MSG_NB;
+	int i;
+
+	if (argc > 1) {
+		msg_nb = (uint32_t) strtoul(argv[1], NULL, 10);
+	}
+
+	printf("QoS1 in-flight window: %d messages\n", MAX_INFLIGHT_MESSAGES);
+	printf("%-10s %8s %14s %14s %8s\n", "rtt ms", "messages", "before msg/s", "after msg/s", "speedup");
+	for (i = 0; i < 3; i++) {
+		uint32_t nb = (rtts[i] > 10) ? (msg_nb / 5) : msg_nb;
+		double before, after;
+
+		before = bench_run(0, rtts[i], nb);
+		after = bench_run(1, rtts[i], nb);
+		printf("%-10u %8u %14.1f %14.1f %7.2fx\n", rtts[i], nb, before, after, after / before);
+	}
+	return 0;
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file   legacy_json_api.h
+ * @brief  Former JSON interface, kept as benchmark reference
+ *
+ */
+
+#ifndef __legacy_json_api_H_
+#define __legacy_json_api_H_
+
+#include "liveobjects-client/LiveObjectsClient_Defs.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+int legacy_json_begin(char *pbuf, uint32_t sz);
+
+int legacy_json_end(char *pbuf, uint32_t sz);
+
+int legacy_json_begin_section(char *pbuf, uint32_t sz, const char* name);
+
+int legacy_json_end_section(char *pbuf, uint32_t sz);
+
+int legacy_json_add_section_start(const char* section_name, char *pbuf, uint32_t sz);
+
+int legacy_json_add_section_end(char *pbuf, uint32_t sz);
+
+int legacy_json_add_name_int(const char* name, int32_t value, char *pbuf, uint32_t sz);
+
+int legacy_json_add_name_str(const char* name, const char* value, char *pbuf, uint32_t sz);
+
+int legacy_json_add_name_array(const char* name, const char* array, char *pbuf, uint32_t sz);
+
+int legacy_json_add_item(const LiveObjectsD_Data_t* p, char *pbuf, uint32_t sz);
+
+int legacy_json_add_param(const LiveObjectsD_Data_t* p, char *pbuf, uint32_t sz);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __legacy_json_api_H_ */
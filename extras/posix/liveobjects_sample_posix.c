@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  liveobjects_sample_posix.c
+ * @brief Host (Linux/POSIX) sample: status, collected data, configuration parameters
+ *        and commands, against the MQTT broker defined by LOC_SERV_IP_ADDRESS (default: 127.0.0.1:1883).
+ *
+ * Usage: liveobjects_sample_posix [nb_of_data_push] [period_ms] [full_every]
+ *
+ * When full_every is given, the collected data are published in 'report-by-exception' mode
+ * (only the changed values), with a full snapshot every full_every push.
+ *
+ * The API key is read from the LO_APIKEY environment variable (32 hexa digits).
+ */
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "liveobjects_iotsoftbox_api.h"
+
+#define LOC_CLIENT_DEV_NAME_SPACE            "LiveObjectsSample"
+#define LOC_CLIENT_DEV_ID                    "LO_posix_dev01"
+
+#define DBG_DFT_TRACE_LEVEL                  LOTRACE_LEVEL_INF
+#define DBG_DFT_MSG_DUMP                     0
+
+#define MEOL                                 "\n"
+#define PRINTF                               printf
+
+static const char* appv_version = "POSIX BASIC SAMPLE V04.14";
+
+static volatile sig_atomic_t appv_stop = 0;
+
+/* ---------------------------------------------------------------------------------
+ * STATUS data
+ */
+static int32_t appv_status_counter = 0;
+static char    appv_status_message[150] = "READY";
+
+static LiveObjectsD_Data_t appv_set_status[] = {
+	{ LOD_TYPE_STRING_C, "sample_version", NULL, 1, 0 },
+	{ LOD_TYPE_INT32,    "sample_counter", &appv_status_counter, 1, 0 },
+	{ LOD_TYPE_STRING_C, "sample_message", appv_status_message, 1, 0 }
+};
+#define SET_STATUS_NB (sizeof(appv_set_status) / sizeof(LiveObjectsD_Data_t))
+
+static int appv_hdl_status = -1;
+
+/* ---------------------------------------------------------------------------------
+ * Collected DATA
+ */
+static uint32_t appv_measures_counter = 0;
+static int32_t  appv_measures_temp = 20;
+static float    appv_measures_volt = 5.0f;
+
+static LiveObjectsD_Data_t appv_set_measures[] = {
+	{ LOD_TYPE_UINT32, "counter",       &appv_measures_counter, 1, 0 },
+	{ LOD_TYPE_INT32,  "temperature",   &appv_measures_temp, 1, 0 },
+	{ LOD_TYPE_FLOAT,  "battery_level", &appv_measures_volt, 1, 0 }
+};
+#define SET_MEASURES_NB (sizeof(appv_set_measures) / sizeof(LiveObjectsD_Data_t))
+
+static int appv_hdl_data = -1;
+
+/* ---------------------------------------------------------------------------------
+ * CONFIGURATION data
+ */
+static uint32_t appv_cfg_timeout = 10;
+static int32_t  appv_cfg_threshold = -3;
+
+#define PARM_IDX_TIMEOUT     1
+#define PARM_IDX_THRESHOLD   2
+
+static LiveObjectsD_Param_t appv_set_param[] = {
+	{ PARM_IDX_TIMEOUT,   { LOD_TYPE_UINT32, "timeout",   &appv_cfg_timeout, 1, 0 } },
+	{ PARM_IDX_THRESHOLD, { LOD_TYPE_INT32,  "threshold", &appv_cfg_threshold, 1, 0 } }
+};
+#define SET_PARAM_NB (sizeof(appv_set_param) / sizeof(LiveObjectsD_Param_t))
+
+/* ---------------------------------------------------------------------------------
+ * COMMANDS
+ */
+#define CMD_IDX_RESET       1
+#define CMD_IDX_LED         2
+
+static LiveObjectsD_Command_t appv_set_commands[] = {
+	{ CMD_IDX_RESET, "RESET", 0 },
+	{ CMD_IDX_LED,   "LED",   0 }
+};
+#define SET_COMMANDS_NB (sizeof(appv_set_commands) / sizeof(LiveObjectsD_Command_t))
+
+/* --------------------------------------------------------------------------------- */
+/*  Called (by the LiveObjects thread) to update configuration parameters */
+static int main_cb_param_udp(const LiveObjectsD_Param_t* param_ptr, const void* value, int len) {
+	(void)len;
+	if (param_ptr == NULL) {
+		return -1;
+	}
+	PRINTF("UPDATE user_ref=%" PRIu32 " %s ..." MEOL, param_ptr->parm_uref, param_ptr->parm_data.data_name);
+	switch (param_ptr->parm_uref) {
+	case PARM_IDX_TIMEOUT: {
+		uint32_t timeout = *((const uint32_t*) value);
+		if ((timeout > 0) && (timeout <= 120)) {
+			return 0; /* primitive parameter is updated by library */
+		}
+		break;
+	}
+	case PARM_IDX_THRESHOLD: {
+		int32_t threshold = *((const int32_t*) value);
+		if ((threshold >= -10) && (threshold <= 10)) {
+			return 0;
+		}
+		break;
+	}
+	}
+	PRINTF("ERROR to update param[%" PRIu32 "] %s !!" MEOL, param_ptr->parm_uref, param_ptr->parm_data.data_name);
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  Called (by the LiveObjects thread) to perform an 'attached/registered' command */
+static int main_cb_command(LiveObjectsD_CommandRequestBlock_t* pCmdReqBlk) {
+	const LiveObjectsD_Command_t* cmd_ptr;
+	if ((pCmdReqBlk == NULL) || (pCmdReqBlk->hd.cmd_ptr == NULL) || (pCmdReqBlk->hd.cmd_cid == 0)) {
+		PRINTF("*** COMMAND : ERROR, Invalid parameter" MEOL);
+		return -1;
+	}
+	cmd_ptr = pCmdReqBlk->hd.cmd_ptr;
+	PRINTF("*** COMMAND %d %s - cid=%d args=%d" MEOL, cmd_ptr->cmd_uref, cmd_ptr->cmd_name,
+			(int) pCmdReqBlk->hd.cmd_cid, (int) pCmdReqBlk->hd.cmd_args_nb);
+	switch (cmd_ptr->cmd_uref) {
+	case CMD_IDX_RESET:
+	case CMD_IDX_LED:
+		return 1; /* response = OK */
+	}
+	return -4;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void main_sig_handler(int sig) {
+	(void)sig;
+	appv_stop = 1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static unsigned long long main_hex_to_u64(const char* str) {
+	char tmp[17];
+	strncpy(tmp, str, 16);
+	tmp[16] = 0;
+	return strtoull(tmp, NULL, 16);
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static unsigned long main_millis(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long) ts.tv_sec * 1000UL + ts.tv_nsec / 1000000UL;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int main(int argc, char* argv[]) {
+	int ret;
+	unsigned long nb_push = 0;
+	unsigned long period_ms = 1000;
+	long full_every = -1;
+	unsigned long next_push;
+	unsigned long long apikey_p1 = 0;
+	unsigned long long apikey_p2 = 0;
+	const char* apikey = getenv("LO_APIKEY");
+
+	if (argc > 1)
+		nb_push = strtoul(argv[1], NULL, 10);
+	if (argc > 2)
+		period_ms = strtoul(argv[2], NULL, 10);
+	if (argc > 3)
+		full_every = strtol(argv[3], NULL, 10);
+
+	if ((apikey) && (strlen(apikey) == 32)) {
+		apikey_p1 = main_hex_to_u64(apikey);
+		apikey_p2 = main_hex_to_u64(apikey + 16);
+	}
+
+	signal(SIGINT, main_sig_handler);
+	signal(SIGTERM, main_sig_handler);
+
+	PRINTF("%s" MEOL, appv_version);
+	appv_set_status[0].data_value = (void*) appv_version;
+
+	LiveObjectsClient_InitDbgTrace(DBG_DFT_TRACE_LEVEL);
+	LiveObjectsClient_SetDbgMsgDump(DBG_DFT_MSG_DUMP);
+	LiveObjectsClient_SetDevId(LOC_CLIENT_DEV_ID);
+	LiveObjectsClient_SetNameSpace(LOC_CLIENT_DEV_NAME_SPACE);
+
+	ret = LiveObjectsClient_Init(NULL, apikey_p1, apikey_p2);
+	if (ret) {
+		PRINTF("LiveObjectsClient_Init -> ERROR (%d)" MEOL, ret);
+		return 1;
+	}
+
+	ret = LiveObjectsClient_AttachCfgParams(appv_set_param, SET_PARAM_NB, main_cb_param_udp);
+	if (ret)
+		PRINTF("LiveObjectsClient_AttachCfgParams -> ERROR (%d)" MEOL, ret);
+
+	appv_hdl_status = LiveObjectsClient_AttachStatus(appv_set_status, SET_STATUS_NB);
+	if (appv_hdl_status)
+		PRINTF("LiveObjectsClient_AttachStatus -> ERROR (%d)" MEOL, appv_hdl_status);
+
+	appv_hdl_data = LiveObjectsClient_AttachData(0, "LO_sample_measures", "mV1", "\"Test\"", NULL, appv_set_measures,
+			SET_MEASURES_NB);
+	if (appv_hdl_data)
+		PRINTF("LiveObjectsClient_AttachData -> ERROR (%d)" MEOL, appv_hdl_data);
+	else if (full_every >= 0) {
+		ret = LiveObjectsClient_ControlDataDelta(appv_hdl_data, true, (uint16_t) full_every);
+		if (ret)
+			PRINTF("LiveObjectsClient_ControlDataDelta -> ERROR (%d)" MEOL, ret);
+	}
+
+	ret = LiveObjectsClient_AttachCommands(appv_set_commands, SET_COMMANDS_NB, main_cb_command);
+	if (ret)
+		PRINTF("LiveObjectsClient_AttachCommands -> ERROR (%d)" MEOL, ret);
+	LiveObjectsClient_ControlCommands(true);
+
+	ret = LiveObjectsClient_DnsResolve();
+	if (ret < 0) {
+		PRINTF("LiveObjectsClient_DnsResolve -> ERROR (%d)" MEOL, ret);
+		return 1;
+	}
+
+	ret = LiveObjectsClient_Connect();
+	if (ret) {
+		PRINTF("LiveObjectsClient_Connect -> ERROR (%d)" MEOL, ret);
+		return 1;
+	}
+
+	next_push = main_millis();
+	while (!appv_stop) {
+		if ((long) (main_millis() - next_push) >= 0) {
+			if ((nb_push) && (appv_measures_counter >= nb_push))
+				break;
+			appv_measures_counter++;
+			appv_measures_temp = 20 + (int32_t) ((appv_measures_counter / 4) % 10);
+			appv_measures_volt = 5.0f - (float) ((appv_measures_counter / 2) % 50) * 0.02f;
+			LiveObjectsClient_PushData(appv_hdl_data);
+			next_push += period_ms;
+		}
+		if (LiveObjectsClient_Cycle(10)) {
+			PRINTF("LiveObjectsClient_Cycle -> ERROR" MEOL);
+			break;
+		}
+	}
+
+	LiveObjectsClient_Disconnect();
+	PRINTF("%" PRIu32 " data messages pushed" MEOL, appv_measures_counter);
+	return 0;
+}
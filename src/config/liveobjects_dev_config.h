@@ -33,24 +33,37 @@
 #define LOC_MQTT_DEF_COMMAND_TIMEOUT           60000
 //#define LOC_MQTT_DEF_SND_SZ                  (1024*2)
 //#define LOC_MQTT_DEF_RCV_SZ                  (1024*2)
+//#define LOC_MQTT_RCV_CHUNKED                 1
+//#define LOC_NETW_RCV_BUF_SZ                  256
+//#define LOC_NETW_SND_BUF_SZ                  1024
 
 //#define LOC_MQTT_DEF_TOPIC_NAME_SZ           40
 //#define LOC_MQTT_DEF_DEV_ID_SZ               20
 //#define LOC_MQTT_DEF_NAME_SPACE_SZ           20
 
 //#define LOC_MQTT_DEF_PENDING_MSG_MAX         5
+//#define LOC_MQTT_DEF_PUB_ASYNC_MAX           4
 //#define LOC_MAX_OF_COMMAND_ARGS              5
+//#define LOC_CMD_BLK_NB                       2
+//#define LOC_CMD_BLK_SZ                       256
 //#define LOC_MAX_OF_DATA_SET                  5
 //#define LOC_MAX_OF_STATUS_SET                1
 
 //#define LOC_MAX_OF_PARSED_PARAMS             5
+//#define LOC_PARAMS_BATCH_SZ                  8
 
 //#define LOM_JSON_BUF_SZ                      1024
 //#define LOM_JSON_BUF_USER_SZ                 200
+//#define LOM_JSON_SIMD                        1
+//#define LOM_NAME_INDEX_SZ                    64
 
 //#define LOM_SETOFDATA_STREAM_ID_SZ           80
 //#define LOM_SETOFDATA_MODEL_SZ               80
 //#define LOM_SETOFDATA_TAGS_SZ                80
+//#define LOM_SETOFDATA_SKEL_SZ                320
+//#define LOM_SETOFDATA_RBE_NB                 16
+//#define LOM_SETOFDATA_FILTER_NB              4
+//#define LOM_SETOFDATA_AGGR_NB                4
 
 //#define LOM_PUSH_ASYNC                       0
 //#define LOM_MQUEUE                           0
@@ -70,28 +83,58 @@
 
 #define LOC_MQTT_DEF_SND_SZ                  (250)
 #define LOC_MQTT_DEF_RCV_SZ                  (250)
+#define LOC_MQTT_RCV_CHUNKED                 1
+#define LOC_NETW_RCV_BUF_SZ                  32
+#define LOC_NETW_SND_BUF_SZ                  0
 
 #define LOC_MQTT_DEF_TOPIC_NAME_SZ           12
 #define LOC_MQTT_DEF_DEV_ID_SZ               20
 #define LOC_MQTT_DEF_NAME_SPACE_SZ           20
 
 #define LOC_MQTT_DEF_PENDING_MSG_MAX         2
+#define LOC_MQTT_DEF_PUB_ASYNC_MAX           0
 #define LOC_MAX_OF_COMMAND_ARGS              2
+#define LOC_CMD_BLK_NB                       1
+#define LOC_CMD_BLK_SZ                       96
 #define LOC_MAX_OF_DATA_SET                  1
 #define LOC_MAX_OF_STATUS_SET                1
 
 //#define LOC_MAX_OF_PARSED_PARAMS             5
+#define LOC_PARAMS_BATCH_SZ                  2
 
 #define LOM_JSON_BUF_SZ                      200
 #define LOM_JSON_BUF_USER_SZ                 200
+#define LOM_NAME_INDEX_SZ                    0
 
 #define LOM_SETOFDATA_STREAM_ID_SZ           40
 #define LOM_SETOFDATA_MODEL_SZ               0
 #define LOM_SETOFDATA_TAGS_SZ                0
+#define LOM_SETOFDATA_SKEL_SZ                96
+#define LOM_SETOFDATA_RBE_NB                 0
+#define LOM_SETOFDATA_FILTER_NB              0
+#define LOM_SETOFDATA_AGGR_NB                0
 
 #define LOM_PUSH_ASYNC                       1
 //#define LOM_MQUEUE                           0
 
+#elif !defined(ARDUINO)
+
+/* Host build (LOC_PLATFORM_POSIX) : default parameters */
+
+//#define LOC_MQTT_DUMP_MSG                    0
+
+//#define LOC_MQTT_DEF_SND_SZ                  (1024*2)
+//#define LOC_MQTT_DEF_RCV_SZ                  (1024*2)
+//#define LOC_MQTT_RCV_CHUNKED                 1
+//#define LOC_NETW_RCV_BUF_SZ                  256
+//#define LOC_NETW_SND_BUF_SZ                  1024
+
+//#define LOC_MQTT_DEF_PUB_ASYNC_MAX           4
+
+//#define LOM_JSON_BUF_SZ                      1024
+//#define LOM_JSON_BUF_USER_SZ                 1024
+//#define LOM_JSON_SIMD                        1
+
 #else
 
 #error "ERROR : Arduino platform not defined "
@@ -24,7 +24,15 @@
 // IP address, TCP port, Connection timeout in milliseconds.
 //#define LOC_SERV_IP_ADDRESS                  "XXXX"
 //#define LOC_SERV_PORT                        8883
+#if defined(ARDUINO)
 #define SECURITY_ENABLED                     1
+#else
+// Host build (LOC_PLATFORM_POSIX): plain MQTT (no TLS), by default to a local broker
+#define SECURITY_ENABLED                     0
+#ifndef LOC_SERV_IP_ADDRESS
+#define LOC_SERV_IP_ADDRESS                  "127.0.0.1"
+#endif
+#endif
 //#define LOC_SERV_TIMEOUT                     XXXX
 
 // When there is an issue with DNS to resolve FQDN liveobjects.orange-business.com ?
@@ -108,6 +108,7 @@ extern "C" int f_netw_sock_init(Network *pNetwork, void* net_iface_handler) {
 		pNetwork->my_socket = SOCKETHANDLE_NULL;
 		pNetwork->mqttread = NULL;
 		pNetwork->mqttwrite = NULL;
+		pNetwork->mqttwritev = NULL;
 	}
 	_netw_socket = SOCKETHANDLE_NULL;
 	_netw_bSockState = 0;
@@ -48,7 +48,7 @@ extern "C" void lo_trace_level(int level) {
 }
 
 extern "C" void lo_trace_log(int level,
-#if defined(ARDUINO_MEDIATEK) || defined(ARDUINO_ARCH_SAMD)
+#if LOTRACE_WITH_LOCATION
 		const char *file,
 		unsigned int line,
 		const char *function,
@@ -104,7 +104,7 @@ extern "C" void lo_trace_log(int level,
 			if (pt_str < end_str)
 				pt_str += snprintf(pt_str, end_str - pt_str, ":%c:", *(_trace_TraceLib + level));
 
-#if defined(ARDUINO_MEDIATEK) || defined(ARDUINO_ARCH_SAMD)
+#if LOTRACE_WITH_LOCATION
 			/*Add file:line: */
 			if (pt_str < end_str) {
 				const char* name = strrchr(file, '\\');
@@ -15,6 +15,7 @@
 
 #include "paho-mqttclient-embedded-c/MQTTClient.h"
 
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -48,11 +49,13 @@
 #define LOC_SERV_IP_ADDRESS           LOC_SERV_HOST_NAME
 #endif
 
+#ifndef LOC_SERV_PORT
 #if SECURITY_ENABLED // TODO
 #define LOC_SERV_PORT                  8883
 #else
 #define LOC_SERV_PORT                  1883
 #endif
+#endif
 
 /* Version of MQTT to be used : 4 = 3.1.1  (3 is for  3.1) */
 #define MQTTPacket_connectData_initializer { \
@@ -72,7 +75,23 @@
 
 #define MTYPE_PUB_CMD_RSP        0x27
 
+#if LOM_MQUEUE && (LOC_MQTT_DEF_PUB_ASYNC_MAX > 0)
+#define LOC_PUB_ASYNC            1
+#else
+#define LOC_PUB_ASYNC            0
+#endif
+
+#define PUB_ASYNC_QUEUED         1
+#define PUB_ASYNC_INFLIGHT       2
+#define PUB_ASYNC_SENT           3
+#if (MAX_INFLIGHT_MESSAGES > 0)
+#define PUB_ASYNC_QOS_MAX        1
+#else
+#define PUB_ASYNC_QOS_MAX        0
+#endif
+
 #define BYTE_PRINTED_SIZE        3
+#define DUMP_BYTES_PER_LINE      16
 
 #define APIKEY_LENGTH			 33
 
@@ -85,8 +104,20 @@ typedef struct {
 	uint8_t subscribed;
 	char topicName[LOC_MQTT_DEF_TOPIC_NAME_SZ];
 	messageHandler callback;
+	messageChunkHandler chunk_callback;  /* payload larger than the receive buffer */
 } LOMTopicSub_t;
 
+#if LOC_PUB_ASYNC
+typedef struct {
+	int ticket;                                 /* 0 if free */
+	uint8_t state;                              /* PUB_ASYNC_QUEUED, PUB_ASYNC_INFLIGHT or PUB_ASYNC_SENT */
+	uint8_t qos;
+	const char* p_msg;                          /* MEM_ALLOC: message type (MTYPE_PUB_xxx) and JSON payload */
+	LiveObjectsD_CallbackPublished_t callback;
+	void* context;
+} LOMPubAsync_t;
+#endif
+
 /* --------------------------------------------------------------------------------- */
 /* Local variables
  * ---------------
@@ -108,6 +139,13 @@ static int8_t _LOClient_cfg_first;
 static MQTTClient _LOClient_mqtt_ctx;
 
 static unsigned char _LOClient_mqtt_buffer_snd[LOC_MQTT_DEF_SND_SZ + 10];
+#if LOM_ENCODE_IN_MQTT_BUF
+/* Room reserved at the beginning of the MQTT send buffer for the header (fixed header, remaining length,
+ * topic name and packet id) of a publish packet whose JSON payload is encoded in place.
+ * The longest topic is "dev/rsc/upd/res". */
+#define LOC_MQTT_PUB_HDR_SZ                  (1 + 4 + 2 + 16 + 2)
+#define LOC_MQTT_PUB_PAYLOAD                 ((char*) &_LOClient_mqtt_buffer_snd[LOC_MQTT_PUB_HDR_SZ])
+#endif
 static unsigned char _LOClient_mqtt_buffer_rcv[LOC_MQTT_DEF_RCV_SZ + 10];
 
 #if LOM_MQUEUE
@@ -118,6 +156,14 @@ static struct {
 } _LOClient_queue;
 #endif /* LOM_MQUEUE */
 
+#if LOC_PUB_ASYNC
+/* Messages published by the LiveObjectsClient_xxxAsync functions, not completed yet */
+static struct {
+	int ticket_last;
+	LOMPubAsync_t msg[LOC_MQTT_DEF_PUB_ASYNC_MAX];
+} _LOClient_pubAsync;
+#endif
+
 static LiveObjectsNetConnectParams_t _LOClient_params_connect = {
 		LOC_SERV_IP_ADDRESS,
 		LOC_SERV_PORT,
@@ -131,6 +177,13 @@ static void LOCC_ntfDevCfgUpd(MessageData* msg);
 #define LOCC_NTFDEVCFGUDP  NULL
 #endif
 
+#if LOC_FEATURE_LO_PARAMS && LOC_MQTT_RCV_CHUNKED
+#define LOCC_NTFDEVCFGUDP_PART  LOCC_ntfDevCfgUpdPart
+static int LOCC_ntfDevCfgUpdPart(MessageData* msg, size_t offset, size_t total);
+#else
+#define LOCC_NTFDEVCFGUDP_PART  NULL
+#endif
+
 #if LOC_FEATURE_LO_COMMANDS
 #define LOCC_NTFDEVCMD  LOCC_ntfDevCmd
 static void LOCC_ntfDevCmd(MessageData* msg);
@@ -138,6 +191,13 @@ static void LOCC_ntfDevCmd(MessageData* msg);
 #define LOCC_NTFDEVCMD    NULL
 #endif
 
+#if LOC_FEATURE_LO_COMMANDS && LOC_MQTT_RCV_CHUNKED
+#define LOCC_NTFDEVCMD_PART  LOCC_ntfDevCmdPart
+static int LOCC_ntfDevCmdPart(MessageData* msg, size_t offset, size_t total);
+#else
+#define LOCC_NTFDEVCMD_PART  NULL
+#endif
+
 #if LOC_FEATURE_LO_RESOURCES
 #define LOCC_NTFDEVRSCUDP  LOCC_ntfDevRscUpd
 static void LOCC_ntfDevRscUpd(MessageData* msg);
@@ -150,9 +210,9 @@ static void LOCC_ntfDevRscUpd(MessageData* msg);
 #define TOPIC_RSC_UPD  2
 
 LOMTopicSub_t _LOClient_TopicSub[3] = {
-		{ 0, "dev/cfg/upd", LOCC_NTFDEVCFGUDP },
-		{ 0, "dev/cmd", LOCC_NTFDEVCMD },
-		{ 0, "dev/rsc/upd", LOCC_NTFDEVRSCUDP }
+		{ 0, "dev/cfg/upd", LOCC_NTFDEVCFGUDP, LOCC_NTFDEVCFGUDP_PART },
+		{ 0, "dev/cmd", LOCC_NTFDEVCMD, LOCC_NTFDEVCMD_PART },
+		{ 0, "dev/rsc/upd", LOCC_NTFDEVRSCUDP, NULL }
 };
 
 #if LOC_FEATURE_LO_STATUS  && (LOC_MAX_OF_DATA_SET > 0)
@@ -187,32 +247,19 @@ static uint16_t _LOClient_dump_mqtt_publish = 0;
 /* --------------------------------------------------------------------------------- */
 /*  */
 static void mqtt_dump_hex(const unsigned char* p_buf, int len) {
-#if 0
-	int i;
-#if defined(LOC_MQT_DUMP_STATIC_BUFFER_SIZE) && (LOC_MQT_DUMP_STATIC_BUFFER_SIZE > 0)
-	static char frame_buffer[LOC_MQT_DUMP_STATIC_BUFFER_SIZE * BYTE_PRINTED_SIZE + 2];
-	if (len >= LOC_MQT_DUMP_STATIC_BUFFER_SIZE) {
-		len = LOC_MQT_DUMP_STATIC_BUFFER_SIZE;
+	char line[DUMP_BYTES_PER_LINE * BYTE_PRINTED_SIZE];
+	while (len > 0) {
+		int n = (len > DUMP_BYTES_PER_LINE) ? DUMP_BYTES_PER_LINE : len;
+		LO_hex_encode(line, sizeof(line), p_buf, n, ' ');
+		LOTRACE_PRINTF("%s\n", line);
+		p_buf += n;
+		len -= n;
 	}
-#else
-	char frame_buffer[len * BYTE_PRINTED_SIZE + 2];
-#endif
-	char byte_buffer[2]; /* 2 char = 1 Byte */
-	for (i = 0; i < len; i++) {
-		/* LOTRACE_PRINTF("%02X ", p_buf[i]); */
-		snprintf(byte_buffer, 3, "%02X", p_buf[i]);
-		frame_buffer[i * BYTE_PRINTED_SIZE] = byte_buffer[0];
-		frame_buffer[(i * BYTE_PRINTED_SIZE) + 1] = byte_buffer[1];
-		frame_buffer[(i * BYTE_PRINTED_SIZE) + 2] = ' ';
-	}
-	frame_buffer[(i * BYTE_PRINTED_SIZE)] = '\0'; /* Avoid undefined character when printing */
-	LOTRACE_PRINTF("%s\n", frame_buffer);
-#endif
 }
 
 /* --------------------------------------------------------------------------------- */
-/*  */
-static void mqtt_dump_msg(const unsigned char* p_buf) {
+/* p_payload: payload of a PUBLISH packet written in two segments, NULL if it follows the header in p_buf */
+static void mqtt_dump_msg(const unsigned char* p_buf, const unsigned char* p_payload) {
 	const unsigned char* pc = p_buf;
 	unsigned char digit;
 	MQTTHeader header;
@@ -244,6 +291,12 @@ static void mqtt_dump_msg(const unsigned char* p_buf) {
 			pc += topic_len;
 
 			payload_len = remain_len - topic_len - 2;
+			if (p_payload) {
+				if (header.bits.qos > 0) {
+					payload_len -= 2;
+				}
+				pc = p_payload;
+			}
 			LOTRACE_PRINTF("PAYLOAD(%3d) : %.*s\n", payload_len, payload_len, pc);
 		}
 	}
@@ -251,14 +304,24 @@ static void mqtt_dump_msg(const unsigned char* p_buf) {
 	if (_LOClient_dump_mqtt_publish & 0x02) {
 		remain_len += header_len;
 		LOTRACE_PRINTF("MSG_LEN = %3d\n", remain_len);
-		mqtt_dump_hex(p_buf, remain_len);
+		if (p_payload) {
+			int topic_len = 256 * p_buf[header_len] + p_buf[header_len + 1];
+			int hdr_len = header_len + 2 + topic_len + ((header.bits.qos > 0) ? 2 : 0);
+			mqtt_dump_hex(p_buf, hdr_len);
+			mqtt_dump_hex(p_payload, remain_len - hdr_len);
+		}
+		else {
+			mqtt_dump_hex(p_buf, remain_len);
+		}
 	}
 }
 
 #if (LOC_MQTT_DUMP_MSG & 0x02)
-void LOCC_mqtt_dump_msg(const unsigned char* p_buf) {
-	if (_LOClient_dump_mqtt_publish & 0x08) {
-		mqtt_dump_msg(p_buf);
+/* A PUBLISH packet written in two segments is dumped only if its header starts the send buffer:
+ * after a partial write, the rest of the header is written again from the middle of this buffer. */
+void LOCC_mqtt_dump_msg(const unsigned char* p_buf, const unsigned char* p_payload) {
+	if ((_LOClient_dump_mqtt_publish & 0x08) && ((p_payload == NULL) || (p_buf == _LOClient_mqtt_buffer_snd))) {
+		mqtt_dump_msg(p_buf, p_payload);
 	}
 }
 #endif
@@ -274,6 +337,9 @@ static int LOCC_mqInit(void) {
 #if LOM_MQUEUE
 	memset(&_LOClient_queue, 0, sizeof(_LOClient_queue));
 #endif /* LOM_MQUEUE */
+#if LOC_PUB_ASYNC
+	memset(&_LOClient_pubAsync, 0, sizeof(_LOClient_pubAsync));
+#endif
 	return 0;
 }
 
@@ -351,6 +417,110 @@ static void LOCC_mqPurge(void) {
 }
 #endif /* LOM_MQUEUE */
 
+#if LOC_PUB_ASYNC
+/* --------------------------------------------------------------------------------- */
+/* Put a message (MEM_ALLOC) to be published by the LiveObjects Client thread, return its ticket */
+static int LOCC_pubAsyncPut(const char* p_msg, uint8_t qos, LiveObjectsD_CallbackPublished_t callback, void* context) {
+	int ret = -1;
+	int i;
+	/* lock */
+	if (MQ_MUTEX_LOCK()) {
+		LOTRACE_WARN("Error to lock mutex");
+		return ret;
+	}
+	for (i = 0; i < LOC_MQTT_DEF_PUB_ASYNC_MAX; i++) {
+		LOMPubAsync_t* p = &_LOClient_pubAsync.msg[i];
+		if (p->ticket == 0) {
+			if (++_LOClient_pubAsync.ticket_last <= 0) {
+				_LOClient_pubAsync.ticket_last = 1;
+			}
+			p->ticket = _LOClient_pubAsync.ticket_last;
+			p->state = PUB_ASYNC_QUEUED;
+			p->qos = qos;
+			p->p_msg = p_msg;
+			p->callback = callback;
+			p->context = context;
+			ret = p->ticket;
+			break;
+		}
+	}
+	/* unlock */
+	MQ_MUTEX_UNLOCK();
+	return ret;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Completion of an asynchronous message (also MQTT completion handler, context is the message slot):
+ * the slot is freed before calling the user callback, which can publish again */
+static void LOCC_pubAsyncCompleted(void* context, unsigned short id, int rc) {
+	LOMPubAsync_t* p = (LOMPubAsync_t*) context;
+	LiveObjectsD_CallbackPublished_t callback;
+	void* user_context;
+	const char* p_msg;
+	int ticket;
+
+#if (LOC_MQTT_DUMP_MSG & 0x01)
+	/* QoS0 message just written: its header is still in the MQTT send buffer */
+	if ((id == 0) && (rc == SUCCESS) && (p->state == PUB_ASYNC_INFLIGHT) && (p->p_msg)
+			&& (_LOClient_dump_mqtt_publish & 0x04)) {
+		mqtt_dump_msg(_LOClient_mqtt_buffer_snd, (const unsigned char*) (p->p_msg + 1));
+	}
+#endif
+#if (LOC_NETW_SND_BUF_SZ > 0)
+	/* QoS0 message written in the network transmit buffer: completed when it is sent (LOCC_pubAsyncFlush) */
+	if ((id == 0) && (rc == SUCCESS) && (p->state == PUB_ASYNC_INFLIGHT)) {
+		p->state = PUB_ASYNC_SENT;
+		return;
+	}
+#endif
+
+	if (MQ_MUTEX_LOCK()) {
+		LOTRACE_ERR("Error to lock mutex");
+		return;
+	}
+	ticket = p->ticket;
+	p_msg = p->p_msg;
+	callback = p->callback;
+	user_context = p->context;
+	memset(p, 0, sizeof(LOMPubAsync_t));
+	MQ_MUTEX_UNLOCK();
+
+	LOTRACE_DBG1("ticket=%d id=%u rc=%d - MEM_FREE %p", ticket, id, rc, p_msg);
+	if (p_msg) {
+		MEM_FREE(p_msg);
+	}
+	if ((ticket) && (callback)) {
+		callback(user_context, ticket, (rc == SUCCESS) ? 0 : -1);
+	}
+}
+
+#if (LOC_NETW_SND_BUF_SZ > 0)
+/* --------------------------------------------------------------------------------- */
+/* Send the network transmit buffer, and complete the QoS0 messages written in it */
+static void LOCC_pubAsyncFlush(void) {
+	int rc = netw_flush(&_LOClient_MQTTClient_network);
+	int i;
+	for (i = 0; i < LOC_MQTT_DEF_PUB_ASYNC_MAX; i++) {
+		if ((_LOClient_pubAsync.msg[i].ticket) && (_LOClient_pubAsync.msg[i].state == PUB_ASYNC_SENT)) {
+			LOCC_pubAsyncCompleted(&_LOClient_pubAsync.msg[i], 0, (rc == 0) ? SUCCESS : FAILURE);
+		}
+	}
+}
+#endif
+
+/* --------------------------------------------------------------------------------- */
+/* Fail the messages not published yet */
+static void LOCC_pubAsyncPurge(void) {
+	int i;
+	for (i = 0; i < LOC_MQTT_DEF_PUB_ASYNC_MAX; i++) {
+		if ((_LOClient_pubAsync.msg[i].ticket) && (_LOClient_pubAsync.msg[i].state == PUB_ASYNC_QUEUED)) {
+			LOTRACE_NOTICE("ticket=%d not published", _LOClient_pubAsync.msg[i].ticket);
+			LOCC_pubAsyncCompleted(&_LOClient_pubAsync.msg[i], 0, FAILURE);
+		}
+	}
+}
+#endif /* LOC_PUB_ASYNC */
+
 /* ================================================================================= */
 /* Callback functions called by MQTT (linked to subscribed topics)
  */
@@ -370,6 +540,29 @@ static void LOCC_ntfDevCfgUpd(MessageData* msg) {
 }
 #endif
 
+/* --------------------------------------------------------------------------------- */
+/* Configuration update larger than the receive buffer, given in pieces */
+#if LOC_FEATURE_LO_PARAMS && LOC_MQTT_RCV_CHUNKED
+static int LOCC_ntfDevCfgUpdPart(MessageData* msg, size_t offset, size_t total) {
+	int ret;
+	uint32_t consumed = 0;
+	uint8_t last = (offset + msg->message->payloadlen >= total) ? 1 : 0;
+	if (offset == 0) {
+		LOTRACE_INF("msg: id=%d, %u bytes in pieces", msg->message->id, (unsigned int) total);
+	}
+
+	ret = LO_msg_decode_params_part((const char*) msg->message->payload, msg->message->payloadlen, offset, last,
+			&_LOClient_Set_Params, &_LOClient_Set_UpdatedParams, &consumed);
+	if ((ret == 0) && (!last)) {
+		return (int) consumed;
+	}
+	if (ret) {
+		LOTRACE_ERR("failed, rc= %d", ret);
+	}
+	return -1;
+}
+#endif
+
 /* --------------------------------------------------------------------------------- */
 /*  */
 #if LOC_FEATURE_LO_RESOURCES
@@ -428,6 +621,43 @@ static void LOCC_ntfDevCmd(MessageData* msg) {
 }
 #endif
 
+/* --------------------------------------------------------------------------------- */
+/* Command request larger than the receive buffer, given in pieces */
+#if LOC_FEATURE_LO_COMMANDS && LOC_MQTT_RCV_CHUNKED
+static int LOCC_ntfDevCmdPart(MessageData* msg, size_t offset, size_t total) {
+	int ret;
+	int32_t cid = 0;
+	uint32_t consumed = 0;
+	uint8_t last = (offset + msg->message->payloadlen >= total) ? 1 : 0;
+	if (offset == 0) {
+		LOTRACE_INF("msg: id=%d, %u bytes in pieces", msg->message->id, (unsigned int) total);
+	}
+
+	ret = LO_msg_decode_cmd_part((const char*) msg->message->payload, msg->message->payloadlen, offset, last,
+			&_LOClient_Set_Cmd, &cid, &consumed);
+	if ((ret == 0) && (!last)) {
+		return (int) consumed;
+	}
+	if (ret < 0) {
+		LOTRACE_ERR("failed, rc= %d, cid=%"PRIi32, ret, cid);
+	}
+
+	if ((cid) && (ret)) {
+		const char* pMsg;
+		/* send immediately a command response */
+		LOTRACE_INF("Send command response cid=%"PRIi32" ret= %d", cid, ret);
+		pMsg = LO_msg_encode_cmd_result(cid, ret);
+		if (pMsg) {
+			LOCC_MqttPublish(QOS0, "dev/cmd/res", pMsg);
+		}
+	}
+	else if (cid) {
+		LOTRACE_NOTICE("! DELAYED CMD RESPONSE (ret=%d) - cid=%" PRIi32, ret, cid);
+	}
+	return -1;
+}
+#endif
+
 /* ================================================================================= */
 
 /* --------------------------------------------------------------------------------- */
@@ -488,6 +718,13 @@ static int LOCC_MqttPublish(enum QoS qos, const char* topic_name, const char* pa
 	mqtt_msg.payloadlen = strlen(payload_data);
 
 	LOTRACE_DBG1("MQTTPublish len=%d ...", mqtt_msg.payloadlen);
+#if LOM_ENCODE_IN_MQTT_BUF
+	if (payload_data == LOC_MQTT_PUB_PAYLOAD) {
+		/* JSON payload already encoded in the MQTT send buffer, just after the room reserved for the header */
+		rc = MQTTPublishInPlace(&_LOClient_mqtt_ctx, topic_name, &mqtt_msg);
+	}
+	else
+#endif
 	rc = MQTTPublish(&_LOClient_mqtt_ctx, topic_name, &mqtt_msg);
 	if (rc) {
 		LOTRACE_ERR("MQTTPublish failed, rc=%d", rc);
@@ -495,7 +732,18 @@ static int LOCC_MqttPublish(enum QoS qos, const char* topic_name, const char* pa
 
 #if (LOC_MQTT_DUMP_MSG & 0x01)
 	if (_LOClient_dump_mqtt_publish & 0x04) {
-		mqtt_dump_msg(_LOClient_mqtt_buffer_snd);
+		const unsigned char* p_packet = _LOClient_mqtt_buffer_snd;
+		const unsigned char* p_payload = (const unsigned char*) payload_data;
+#if LOM_ENCODE_IN_MQTT_BUF
+		if (payload_data == LOC_MQTT_PUB_PAYLOAD) {
+			MQTTString topic = MQTTString_initializer;
+			topic.cstring = (char*) topic_name;
+			p_packet = (const unsigned char*) payload_data
+					- MQTTSerialize_publishHeaderLength(qos, topic, mqtt_msg.payloadlen);
+			p_payload = NULL;
+		}
+#endif
+		mqtt_dump_msg(p_packet, p_payload);
 	}
 #endif
 
@@ -523,6 +771,10 @@ static int LOCC_SubscribeTopic(int i) {
 		else {
 			LOTRACE_NOTICE("Subscribe[%d] %s, qos=%d (granted_qos=%d)", i, _LOClient_TopicSub[i].topicName, rc, QOS0);
 			_LOClient_TopicSub[i].subscribed = 1;
+			if (_LOClient_TopicSub[i].chunk_callback) {
+				MQTTSetMessageChunkHandler(&_LOClient_mqtt_ctx, _LOClient_TopicSub[i].topicName,
+						_LOClient_TopicSub[i].chunk_callback);
+			}
 		}
 	}
 	else {
@@ -638,35 +890,23 @@ static int LOCC_processGetRsc(void) {
 				}
 
 				if (_LOClient_Set_UpdatedRsc.ursc_offset == _LOClient_Set_UpdatedRsc.ursc_size) {
-					unsigned int i;
 					unsigned char computedMd5[16];
+					int md5_ok;
 					MD5Final(computedMd5, &_LOClient_Set_UpdatedRsc.md5_ctx);
 					/* Check computed MD5 value with the value given by the LO server */
-					for (i = 0; i < sizeof(computedMd5); i++) {
-						if (computedMd5[i] != _LOClient_Set_UpdatedRsc.ursc_md5[i]) {
-							LOTRACE_INF(
-									"Computed MD5 %02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x",
-									computedMd5[0], computedMd5[1], computedMd5[2], computedMd5[3], computedMd5[4], computedMd5[5], computedMd5[6],
-									computedMd5[7], computedMd5[8], computedMd5[9], computedMd5[10], computedMd5[11], computedMd5[12], computedMd5[13],
-									computedMd5[14], computedMd5[15]);
-							LOTRACE_INF(
-									"LO Server MD5 %02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x",
-									_LOClient_Set_UpdatedRsc.ursc_md5[0], _LOClient_Set_UpdatedRsc.ursc_md5[1],
-									_LOClient_Set_UpdatedRsc.ursc_md5[2], _LOClient_Set_UpdatedRsc.ursc_md5[3],
-									_LOClient_Set_UpdatedRsc.ursc_md5[4], _LOClient_Set_UpdatedRsc.ursc_md5[5],
-									_LOClient_Set_UpdatedRsc.ursc_md5[6], _LOClient_Set_UpdatedRsc.ursc_md5[7],
-									_LOClient_Set_UpdatedRsc.ursc_md5[8], _LOClient_Set_UpdatedRsc.ursc_md5[9],
-									_LOClient_Set_UpdatedRsc.ursc_md5[10], _LOClient_Set_UpdatedRsc.ursc_md5[11],
-									_LOClient_Set_UpdatedRsc.ursc_md5[12], _LOClient_Set_UpdatedRsc.ursc_md5[13],
-									_LOClient_Set_UpdatedRsc.ursc_md5[14], _LOClient_Set_UpdatedRsc.ursc_md5[15]);
-							LOTRACE_ERR("MD5 ERROR - [%d] %02x != %02x", i, computedMd5[i],
-									_LOClient_Set_UpdatedRsc.ursc_md5[i]);
-							break;
-						}
+					md5_ok = !memcmp(computedMd5, _LOClient_Set_UpdatedRsc.ursc_md5, sizeof(computedMd5));
+					if (!md5_ok) {
+						char md5_str[sizeof(computedMd5) * 2 + 1];
+						LO_hex_encode(md5_str, sizeof(md5_str), computedMd5, sizeof(computedMd5), 0);
+						LOTRACE_INF("Computed MD5 %s", md5_str);
+						LO_hex_encode(md5_str, sizeof(md5_str), _LOClient_Set_UpdatedRsc.ursc_md5,
+								sizeof(_LOClient_Set_UpdatedRsc.ursc_md5), 0);
+						LOTRACE_INF("LO Server MD5 %s", md5_str);
+						LOTRACE_ERR("MD5 ERROR");
 					}
 
 					if (_LOClient_Set_Rsc.rsc_cb_ntfy) {
-						_LOClient_Set_Rsc.rsc_cb_ntfy((i == sizeof(computedMd5)) ? 1 : 2,
+						_LOClient_Set_Rsc.rsc_cb_ntfy((md5_ok) ? 1 : 2,
 								_LOClient_Set_UpdatedRsc.ursc_obj_ptr, _LOClient_Set_UpdatedRsc.ursc_vers_old,
 								_LOClient_Set_UpdatedRsc.ursc_vers_new, _LOClient_Set_UpdatedRsc.ursc_size);
 					}
@@ -734,7 +974,9 @@ static int LOCC_processConfig(void) {
 		const char* pMsg;
 
 		if (_LOClient_Set_UpdatedParams.cid) {
-			if ((_LOClient_Set_UpdatedParams.nb_of_params) && (_LOClient_Set_UpdatedParams.tab_of_param_ptr[0])) {
+			if ((_LOClient_Set_UpdatedParams.nb_of_params)
+					&& (_LOClient_Set_UpdatedParams.nb_of_params <= LOC_MAX_OF_PARSED_PARAMS)
+					&& (_LOClient_Set_UpdatedParams.tab_of_param_ptr[0])) {
 				LOTRACE_INF("cid=%"PRIi32" => PUBLISH CFG_UPDATE response...",
 						_LOClient_Set_UpdatedParams.cid);
 				pMsg = LO_msg_encode_params_update(&_LOClient_Set_UpdatedParams);
@@ -749,8 +991,8 @@ static int LOCC_processConfig(void) {
 				}
 			}
 			else {
-				LOTRACE_INF("EMPTY => PUBLISH all CFG params with cid=%"PRIi32" ...",
-						_LOClient_Set_UpdatedParams.cid);
+				LOTRACE_INF("%"PRIi32" updated => PUBLISH all CFG params with cid=%"PRIi32" ...",
+						_LOClient_Set_UpdatedParams.nb_of_params, _LOClient_Set_UpdatedParams.cid);
 				pMsg = LO_msg_encode_params_all(0, &_LOClient_Set_Params.param_set, _LOClient_Set_UpdatedParams.cid);
 				if (pMsg) {
 					rc = LOCC_MqttPublish(QOS0, "dev/cfg", pMsg);
@@ -814,11 +1056,21 @@ static int LOCC_processData(uint8_t force)
 			/* TODO: set timestamp only if the board has the good date/time  !
 			 * tbx_GetDateTimeStr(_LOClient_Set_Data.timestamp, sizeof(_LOClient_Set_Data.timestamp));
 			 */
+#if LOM_SETOFDATA_CHECK
+			if (LO_msg_data_check(p_dataSet) == 0) {
+				LOTRACE_INF("LOCC_processData: data_hdl=%d unchanged, nothing to publish", data_hdl);
+				p_dataSet->pushtoLOServer = 0;
+				continue;
+			}
+#endif
 			pMsg = LO_msg_encode_data(0, p_dataSet);
 			if (pMsg) {
 				rc = LOCC_MqttPublish(QOS0, "dev/data", pMsg);
 				if (rc == 0) {
 					p_dataSet->pushtoLOServer = 0;
+#if LOM_SETOFDATA_CHECK
+					LO_msg_data_done(p_dataSet);
+#endif
 				}
 			}
 		}
@@ -871,6 +1123,80 @@ static void LOCC_processPendingMesssage() {
 	}
 }
 #endif
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+#if LOC_PUB_ASYNC
+static void LOCC_processPubAsync(void) {
+	while (1) {
+		LOMPubAsync_t* p = NULL;
+		MQTTMessage mqtt_msg;
+		const char* topic_name;
+		int ticket = 0;
+		int rc;
+		int i;
+
+		if (MQ_MUTEX_LOCK()) {
+			LOTRACE_ERR("Error to lock mutex");
+			break;
+		}
+		/* the oldest message waiting to be published */
+		for (i = 0; i < LOC_MQTT_DEF_PUB_ASYNC_MAX; i++) {
+			LOMPubAsync_t* q = &_LOClient_pubAsync.msg[i];
+			if ((q->ticket) && (q->state == PUB_ASYNC_QUEUED) && ((p == NULL) || (q->ticket < p->ticket))) {
+				p = q;
+			}
+		}
+#if (MAX_INFLIGHT_MESSAGES > 0)
+		/* QoS1 in-flight window is full: wait for a PUBACK, in a next loop */
+		if ((p) && (p->qos == QOS1) && (_LOClient_mqtt_ctx.inflightNb >= MAX_INFLIGHT_MESSAGES)) {
+			p = NULL;
+		}
+#endif
+		if (p) {
+			p->state = PUB_ASYNC_INFLIGHT;
+			ticket = p->ticket;
+		}
+		MQ_MUTEX_UNLOCK();
+		if (p == NULL) {
+			break;
+		}
+
+		if (*p->p_msg == MTYPE_PUB_DATA)
+			topic_name = "dev/data";
+		else if (*p->p_msg == MTYPE_PUB_STATUS)
+			topic_name = "dev/info";
+		else
+			topic_name = "dev/cmd/res";
+
+		mqtt_msg.qos = (enum QoS) p->qos;
+		mqtt_msg.retained = 0;
+		mqtt_msg.dup = 0;
+		mqtt_msg.id = 0;
+		mqtt_msg.payload = (void*) (p->p_msg + 1);
+		mqtt_msg.payloadlen = strlen(p->p_msg + 1);
+
+		LOTRACE_INF("Publish ticket=%d t=%s qos=%d len=%d ...", ticket, topic_name, p->qos, mqtt_msg.payloadlen);
+		rc = MQTTPublishAsync(&_LOClient_mqtt_ctx, topic_name, &mqtt_msg, LOCC_pubAsyncCompleted, p);
+		if (rc) {
+			LOTRACE_ERR("MQTTPublishAsync failed, ticket=%d rc=%d", ticket, rc);
+			/* not completed by MQTT (QoS0 is always completed) */
+			if (p->ticket == ticket) {
+				LOCC_pubAsyncCompleted(p, 0, rc);
+			}
+		}
+#if (LOC_MQTT_DUMP_MSG & 0x01)
+		/* QoS1 message in flight (a QoS0 message is dumped by its completion, before its payload is freed) */
+		else if ((p->ticket == ticket) && (_LOClient_dump_mqtt_publish & 0x04)) {
+			mqtt_dump_msg(_LOClient_mqtt_buffer_snd, (const unsigned char*) mqtt_msg.payload);
+		}
+#endif
+	}
+#if (LOC_NETW_SND_BUF_SZ > 0)
+	LOCC_pubAsyncFlush();
+#endif
+}
+#endif /* LOC_PUB_ASYNC */
 /* --------------------------------------------------------------------------------- */
 /*  */
 static int LOCC_setStreamId(uint8_t stream_prefix, LOMSetOfData_t* p_dataSet, const char* stream_id) {
@@ -933,6 +1259,12 @@ static void LOCC_connectInit(uint8_t mode) {
 #if LOM_MQUEUE
 		LOCC_mqPurge();
 #endif /* LOM_MQUEUE */
+#if LOC_PUB_ASYNC
+		LOCC_pubAsyncPurge();
+#endif
+#if LOC_FEATURE_LO_COMMANDS
+		LO_msg_cmd_blk_reset();
+#endif
 	}
 }
 
@@ -1056,6 +1388,11 @@ int LiveObjectsClient_Init(void* net_iface_handler, unsigned long long apikey_p1
 			_LOClient_mqtt_buffer_snd, LOC_MQTT_DEF_SND_SZ,
 			_LOClient_mqtt_buffer_rcv, LOC_MQTT_DEF_RCV_SZ);
 
+#if LOM_ENCODE_IN_MQTT_BUF
+	/* Messages published by the LiveObjects Client thread are encoded directly in the MQTT send buffer */
+	LO_msg_encode_set_buffer(LOC_MQTT_PUB_PAYLOAD, LOC_MQTT_DEF_SND_SZ - LOC_MQTT_PUB_HDR_SZ);
+#endif
+
 	LOTRACE_DBG1("OK");
 
 	return 0;
@@ -1143,6 +1480,9 @@ int LiveObjectsClient_AttachCfgParams(const LiveObjectsD_Param_t* param_ptr, int
 	_LOClient_Set_Params.param_set.param_ptr = param_ptr;
 	_LOClient_Set_Params.param_set.param_nb = param_nb;
 	_LOClient_Set_Params.param_callback = callback;
+	_LOClient_Set_Params.param_batch_callback = NULL;
+	LO_msg_name_index_build(&_LOClient_Set_Params.param_index, param_ptr, param_nb, sizeof(LiveObjectsD_Param_t),
+			offsetof(LiveObjectsD_Param_t, parm_data.data_name));
 
 	LOTRACE_INF("nb=%"PRIi32" callback=%p", param_nb, callback);
 
@@ -1152,6 +1492,26 @@ int LiveObjectsClient_AttachCfgParams(const LiveObjectsD_Param_t* param_ptr, int
 #endif
 }
 
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_AttachCfgParamsBatch(const LiveObjectsD_Param_t* param_ptr, int32_t param_nb,
+		LiveObjectsD_CallbackParamsBatch_t callback) {
+#if LOC_FEATURE_LO_PARAMS
+	_LOClient_Set_Params.param_set.param_ptr = param_ptr;
+	_LOClient_Set_Params.param_set.param_nb = param_nb;
+	_LOClient_Set_Params.param_callback = NULL;
+	_LOClient_Set_Params.param_batch_callback = callback;
+	LO_msg_name_index_build(&_LOClient_Set_Params.param_index, param_ptr, param_nb, sizeof(LiveObjectsD_Param_t),
+			offsetof(LiveObjectsD_Param_t, parm_data.data_name));
+
+	LOTRACE_INF("nb=%"PRIi32" batch callback=%p", param_nb, callback);
+
+	return 0;
+#else
+	return -1;
+#endif
+}
+
 /* --------------------------------------------------------------------------------- */
 /*  */
 int LiveObjectsClient_AttachStatus(const LiveObjectsD_Data_t* data_ptr, int32_t data_nb) {
@@ -1239,6 +1599,23 @@ int LiveObjectsClient_AttachData(uint8_t stream_prefix, const char* stream_id, c
 		p_dataSet->data_set.data_ptr = data_ptr;
 		p_dataSet->data_set.data_nb = data_nb;
 
+		LO_msg_encode_data_skeleton(p_dataSet);
+#if (LOM_SETOFDATA_RBE_NB > 0)
+		p_dataSet->rbe_enabled = 0;
+		p_dataSet->rbe_valid = 0;
+		memset(p_dataSet->rbe_dirty, 0, sizeof(p_dataSet->rbe_dirty));
+#endif
+#if (LOM_SETOFDATA_FILTER_NB > 0)
+		p_dataSet->filter_nb = 0;
+		memset(p_dataSet->filter, 0, sizeof(p_dataSet->filter));
+#endif
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+		p_dataSet->aggr_nb = 0;
+		p_dataSet->aggr_started = 0;
+		p_dataSet->aggr_window_ms = 0;
+		memset(p_dataSet->aggr, 0, sizeof(p_dataSet->aggr));
+#endif
+
 		LOTRACE_INF("handle=%d nb=%"PRIi32" id=%s m=%s t=%s", data_hdl, data_nb,
 				stream_id, model, tags);
 		return data_hdl;
@@ -1256,6 +1633,8 @@ int LiveObjectsClient_AttachCommands(const LiveObjectsD_Command_t* cmd_ptr, int3
 	_LOClient_Set_Cmd.cmd_ptr = cmd_ptr;
 	_LOClient_Set_Cmd.cmd_nb = cmd_nb;
 	_LOClient_Set_Cmd.cmd_callback = callback;
+	LO_msg_name_index_build(&_LOClient_Set_Cmd.cmd_index, cmd_ptr, cmd_nb, sizeof(LiveObjectsD_Command_t),
+			offsetof(LiveObjectsD_Command_t, cmd_name));
 
 	LOTRACE_INF("nb=%"PRIi32, cmd_nb);
 
@@ -1293,6 +1672,8 @@ int LiveObjectsClient_AttachResources(const LiveObjectsD_Resource_t* rsc_ptr, in
 	_LOClient_Set_Rsc.rsc_nb = rsc_nb;
 	_LOClient_Set_Rsc.rsc_cb_ntfy = ntfyCB;
 	_LOClient_Set_Rsc.rsc_cb_data = dataCB;
+	LO_msg_name_index_build(&_LOClient_Set_Rsc.rsc_index, rsc_ptr, rsc_nb, sizeof(LiveObjectsD_Resource_t),
+			offsetof(LiveObjectsD_Resource_t, rsc_name));
 
 	LOTRACE_INF("nb=%"PRIi32, rsc_nb);
 
@@ -1325,6 +1706,9 @@ int LiveObjectsClient_ChangeDataStreamId(uint8_t prefix, int data_hdl, const cha
 	if ((data_hdl >= 0) && (data_hdl < LOC_MAX_OF_DATA_SET) && _LOClient_Set_Data[data_hdl].stream_id[0]
 			&& (stream_id) &&(*stream_id)) {
 		int ret = LOCC_setStreamId(prefix, &_LOClient_Set_Data[data_hdl], stream_id);
+		if (ret == 0) {
+			LO_msg_encode_data_skeleton(&_LOClient_Set_Data[data_hdl]);
+		}
 		return ret;
 	}
 #endif
@@ -1344,6 +1728,108 @@ int LiveObjectsClient_RemoveData(int data_hdl) {
 	return -1;
 }
 
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_ControlDataDelta(int data_hdl, bool enable, uint16_t full_every) {
+#if LOC_FEATURE_LO_DATA && (LOC_MAX_OF_DATA_SET > 0) && (LOM_SETOFDATA_RBE_NB > 0)
+	if ((data_hdl >= 0) && (data_hdl < LOC_MAX_OF_DATA_SET) && _LOClient_Set_Data[data_hdl].stream_id[0]) {
+		LOMSetOfData_t* p_dataSet = &_LOClient_Set_Data[data_hdl];
+		if ((enable) && (p_dataSet->data_set.data_nb > LOM_SETOFDATA_RBE_NB)) {
+			LOTRACE_ERR("handle=%d: too many data items (%d > LOM_SETOFDATA_RBE_NB=%u)", data_hdl,
+					p_dataSet->data_set.data_nb, LOM_SETOFDATA_RBE_NB);
+			return -1;
+		}
+		p_dataSet->rbe_enabled = (enable) ? 1 : 0;
+		p_dataSet->rbe_valid = 0;
+		p_dataSet->rbe_full_every = full_every;
+		p_dataSet->rbe_push_cnt = 0;
+		memset(p_dataSet->rbe_dirty, 0, sizeof(p_dataSet->rbe_dirty));
+		LOTRACE_INF("handle=%d enable=%d full_every=%u", data_hdl, enable, full_every);
+		return 0;
+	}
+#else
+	(void) data_hdl;
+	(void) enable;
+	(void) full_every;
+#endif
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_SetDataFilter(int data_hdl, int item, float deadband, bool percent,
+		uint32_t min_interval_ms, uint32_t max_interval_ms) {
+#if LOC_FEATURE_LO_DATA && (LOC_MAX_OF_DATA_SET > 0) && (LOM_SETOFDATA_FILTER_NB > 0)
+	if ((data_hdl >= 0) && (data_hdl < LOC_MAX_OF_DATA_SET) && _LOClient_Set_Data[data_hdl].stream_id[0]) {
+		int ret = LO_msg_data_filter_set(&_LOClient_Set_Data[data_hdl], item, deadband, percent ? 1 : 0,
+				min_interval_ms, max_interval_ms);
+		LOTRACE_INF("handle=%d item=%d percent=%d min=%"PRIu32" max=%"PRIu32" ms -> %d", data_hdl, item,
+				percent, min_interval_ms, max_interval_ms, ret);
+		return ret;
+	}
+#else
+	(void) data_hdl;
+	(void) item;
+	(void) deadband;
+	(void) percent;
+	(void) min_interval_ms;
+	(void) max_interval_ms;
+#endif
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_SetDataAggregation(int data_hdl, int item, uint8_t fields) {
+#if LOC_FEATURE_LO_DATA && (LOC_MAX_OF_DATA_SET > 0) && (LOM_SETOFDATA_AGGR_NB > 0)
+	if ((data_hdl >= 0) && (data_hdl < LOC_MAX_OF_DATA_SET) && _LOClient_Set_Data[data_hdl].stream_id[0]) {
+		int ret = LO_msg_data_aggr_set(&_LOClient_Set_Data[data_hdl], item, fields);
+		LOTRACE_INF("handle=%d item=%d fields=x%02x -> %d", data_hdl, item, fields, ret);
+		return ret;
+	}
+#else
+	(void) data_hdl;
+	(void) item;
+	(void) fields;
+#endif
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_SetDataWindow(int data_hdl, uint32_t window_ms) {
+#if LOC_FEATURE_LO_DATA && (LOC_MAX_OF_DATA_SET > 0) && (LOM_SETOFDATA_AGGR_NB > 0)
+	if ((data_hdl >= 0) && (data_hdl < LOC_MAX_OF_DATA_SET) && _LOClient_Set_Data[data_hdl].stream_id[0]) {
+		_LOClient_Set_Data[data_hdl].aggr_window_ms = window_ms;
+		_LOClient_Set_Data[data_hdl].aggr_started = 0;
+		LOTRACE_INF("handle=%d window=%"PRIu32" ms", data_hdl, window_ms);
+		return 0;
+	}
+#else
+	(void) data_hdl;
+	(void) window_ms;
+#endif
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_SampleData(int data_hdl) {
+#if LOC_FEATURE_LO_DATA && (LOC_MAX_OF_DATA_SET > 0) && (LOM_SETOFDATA_AGGR_NB > 0)
+	if ((data_hdl >= 0) && (data_hdl < LOC_MAX_OF_DATA_SET) && _LOClient_Set_Data[data_hdl].stream_id[0]
+			&& _LOClient_Set_Data[data_hdl].data_set.data_ptr) {
+		if (LO_msg_data_aggr_sample(&_LOClient_Set_Data[data_hdl])) {
+			/* End of the window: publish the summary */
+			return LiveObjectsClient_PushData(data_hdl);
+		}
+		return 0;
+	}
+#else
+	(void) data_hdl;
+#endif
+	return -1;
+}
+
 /* --------------------------------------------------------------------------------- */
 /*  */
 int LiveObjectsClient_RemoveCommands(void) {
@@ -1383,10 +1869,14 @@ int LiveObjectsClient_Connect(void) {
 /*  */
 int LiveObjectsClient_Disconnect(void) {
 	int rc;
+	/* the in-flight messages are given up by MQTTDisconnect */
 	rc = MQTTDisconnect(&_LOClient_mqtt_ctx);
 	if (rc) {
 		LOTRACE_ERR("MQTTDisconnect failed, rc=%d", rc);
 	}
+#if LOC_PUB_ASYNC
+	LOCC_pubAsyncPurge();
+#endif
 	netw_disconnect(&_LOClient_MQTTClient_network, 0);
 	_LOClient_state_connected = 0;
 	return 0;
@@ -1405,9 +1895,16 @@ int LiveObjectsClient_Yield(int timeout_ms) {
 			LOTRACE_DBG1("ret=%d !", ret);
 		}
 
+		/* the packets written in this cycle (PUBACK, ...) are sent now */
+		if (netw_flush(&_LOClient_MQTTClient_network) < 0) {
+			LOTRACE_ERR("netw_flush failed");
+		}
+
 		if (netw_isLost(&_LOClient_MQTTClient_network)) {
 			LOTRACE_NOTICE("LOST !");
 			netw_disconnect(&_LOClient_MQTTClient_network, 0);
+			/* No MQTTDisconnect: the in-flight QoS1 messages are sent again after the next MQTTConnect */
+			MQTTSetLost(&_LOClient_mqtt_ctx);
 			_LOClient_state_connected = 0;
 			ret = -1;
 		}
@@ -1494,16 +1991,32 @@ int LiveObjectsClient_PushData(int data_hdl) {
 		_LOClient_Set_Data[data_hdl].pushtoLOServer = 1;
 		return 0;
 #else
+		LOMSetOfData_t* p_dataSet = &_LOClient_Set_Data[data_hdl];
 		uint8_t from = LO_sys_threadIsLiveObjectsClient() ? 0 : MTYPE_PUB_DATA;
-		const char *p_msg = LO_msg_encode_data(from, &_LOClient_Set_Data[data_hdl]);
+		const char *p_msg;
+#if LOM_SETOFDATA_CHECK
+		if (LO_msg_data_check(p_dataSet) == 0) {
+			LOTRACE_INF("data_hdl=%d unchanged, nothing to publish", data_hdl);
+			return 0;
+		}
+#endif
+		p_msg = LO_msg_encode_data(from, p_dataSet);
 		if (p_msg) {
 			if (from == 0) {
 				/* Publish now because it is LiveObjects Client thread */
-				return LOCC_MqttPublish(QOS0, "dev/data", p_msg);
+				int rc = LOCC_MqttPublish(QOS0, "dev/data", p_msg);
+#if LOM_SETOFDATA_CHECK
+				if (rc == 0)
+					LO_msg_data_done(p_dataSet);
+#endif
+				return rc;
 			}
 			/* otherwise put it in the queue */
 			if (LOCC_mqPut(p_msg) == 0) {
 				LOTRACE_DBG1("msg is put in queue !");
+#if LOM_SETOFDATA_CHECK
+				LO_msg_data_done(p_dataSet);
+#endif
 				return 0;
 			}
 			LOTRACE_ERR("ERROR to put in queue - MEM_FREE %p x%x", p_msg, *p_msg);
@@ -1550,12 +2063,16 @@ int LiveObjectsClient_PushCfgParams(void) {
 /*  */
 int LiveObjectsClient_CommandResponse(int32_t cid, const LiveObjectsD_Data_t* data_ptr, int data_nb) {
 #if LOC_FEATURE_LO_COMMANDS
+	/* the command block of this delayed command (arguments given in data_ptr) can not be reused while encoding */
+	LO_msg_cmd_blk_hold(cid);
 	if (_LOClient_state_connected) {
 		const char *p_msg ;
 		uint8_t from = LO_sys_threadIsLiveObjectsClient() ? 0 : MTYPE_PUB_CMD_RSP;
 		LOTRACE_INF("from=x%x cid= %"PRIi32" obj_ptr=x%p  obj_nb=%d ...", from, cid,
 				data_ptr, data_nb);
 		p_msg = LO_msg_encode_cmd_resp(from, cid, data_ptr, data_nb);
+		/* the message is encoded: the command block can be reused */
+		LO_msg_cmd_blk_release(cid);
 		if (p_msg) {
 			if (from == 0) {
 				/* Publish now because it is LOM Client thread (negative response ...) */
@@ -1574,6 +2091,9 @@ int LiveObjectsClient_CommandResponse(int32_t cid, const LiveObjectsD_Data_t* da
 #endif
 		}
 	}
+	else {
+		LO_msg_cmd_blk_release(cid);
+	}
 #endif /* LOC_FEATURE_LO_COMMANDS */
 	return -1;
 }
@@ -1634,6 +2154,9 @@ int LiveObjectsClient_Cycle(int timeout_ms) {
 #if LOM_MQUEUE
 	LOCC_processPendingMesssage();
 #endif
+#if LOC_PUB_ASYNC
+	LOCC_processPubAsync();
+#endif
 
 #if LOC_FEATURE_LO_PARAMS
 	/* Something to publish ?  */
@@ -1746,6 +2269,9 @@ void LiveObjectsClient_Run(LiveObjectsD_CallbackState_t callback) {
 #if LOM_MQUEUE
 			LOCC_processPendingMesssage();
 #endif
+#if LOC_PUB_ASYNC
+			LOCC_processPubAsync();
+#endif
 
 #if LOC_FEATURE_LO_PARAMS
 			/* Something to publish ? */
@@ -1847,3 +2373,97 @@ int LiveObjectsClient_Publish(const char* topicName, const char* payload_data) {
 #endif
 	return -1;
 }
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_PushStatusAsync(int handle, uint8_t qos,
+		LiveObjectsD_CallbackPublished_t callback, void* context) {
+#if LOC_PUB_ASYNC && LOC_FEATURE_LO_STATUS && (LOC_MAX_OF_DATA_SET > 0)
+	if ((_LOClient_state_connected) && (qos <= PUB_ASYNC_QOS_MAX) && (handle >= 0) && (handle < LOC_MAX_OF_STATUS_SET)
+			&& (_LOClient_Set_Status[handle].data_set.data_ptr)) {
+		/* always a copy, published by the LiveObjects Client thread */
+		const char *p_msg = LO_msg_encode_status(MTYPE_PUB_STATUS, &_LOClient_Set_Status[handle].data_set);
+		if (p_msg) {
+			int ticket = LOCC_pubAsyncPut(p_msg, qos, callback, context);
+			if (ticket > 0) {
+				LOTRACE_INF("msg is put in queue, ticket=%d", ticket);
+				return ticket;
+			}
+			LOTRACE_ERR("ERROR to put in queue - MEM_FREE %p x%x", p_msg, *p_msg);
+			MEM_FREE(p_msg);
+		}
+	}
+#else
+	LOTRACE_NOTICE("Not supported");
+#endif
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_PushDataAsync(int data_hdl, uint8_t qos,
+		LiveObjectsD_CallbackPublished_t callback, void* context) {
+#if LOC_PUB_ASYNC && LOC_FEATURE_LO_DATA && (LOC_MAX_OF_DATA_SET > 0)
+	if (_LOClient_state_connected && (qos <= PUB_ASYNC_QOS_MAX) && (data_hdl >= 0) && (data_hdl < LOC_MAX_OF_DATA_SET)
+			&& _LOClient_Set_Data[data_hdl].stream_id[0] && _LOClient_Set_Data[data_hdl].data_set.data_ptr) {
+		LOMSetOfData_t* p_dataSet = &_LOClient_Set_Data[data_hdl];
+		const char *p_msg;
+#if LOM_SETOFDATA_CHECK
+		if (LO_msg_data_check(p_dataSet) == 0) {
+			LOTRACE_INF("data_hdl=%d unchanged, nothing to publish", data_hdl);
+			return 0;
+		}
+#endif
+		/* always a copy, published by the LiveObjects Client thread */
+		p_msg = LO_msg_encode_data(MTYPE_PUB_DATA, p_dataSet);
+		if (p_msg) {
+			int ticket = LOCC_pubAsyncPut(p_msg, qos, callback, context);
+			if (ticket > 0) {
+				LOTRACE_DBG1("msg is put in queue, ticket=%d", ticket);
+#if LOM_SETOFDATA_CHECK
+				LO_msg_data_done(p_dataSet);
+#endif
+				return ticket;
+			}
+			LOTRACE_ERR("ERROR to put in queue - MEM_FREE %p x%x", p_msg, *p_msg);
+			MEM_FREE(p_msg);
+		}
+	}
+#else
+	LOTRACE_NOTICE("Not supported");
+#endif
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LiveObjectsClient_CommandResponseAsync(int32_t cid, const LiveObjectsD_Data_t* data_ptr, int data_nb, uint8_t qos,
+		LiveObjectsD_CallbackPublished_t callback, void* context) {
+#if LOC_PUB_ASYNC && LOC_FEATURE_LO_COMMANDS
+	/* the command block of this delayed command (arguments given in data_ptr) can not be reused while encoding */
+	LO_msg_cmd_blk_hold(cid);
+	if ((_LOClient_state_connected) && (qos <= PUB_ASYNC_QOS_MAX)) {
+		const char *p_msg;
+		LOTRACE_INF("cid= %"PRIi32" obj_ptr=x%p  obj_nb=%d qos=%u ...", cid, data_ptr, data_nb, qos);
+		/* always a copy, published by the LiveObjects Client thread */
+		p_msg = LO_msg_encode_cmd_resp(MTYPE_PUB_CMD_RSP, cid, data_ptr, data_nb);
+		/* the message is encoded: the command block can be reused */
+		LO_msg_cmd_blk_release(cid);
+		if (p_msg) {
+			int ticket = LOCC_pubAsyncPut(p_msg, qos, callback, context);
+			if (ticket > 0) {
+				LOTRACE_INF("msg is put in queue, ticket=%d", ticket);
+				return ticket;
+			}
+			LOTRACE_ERR("ERROR to put in queue - MEM_FREE %p x%x", p_msg, *p_msg);
+			MEM_FREE(p_msg);
+		}
+	}
+	else {
+		LO_msg_cmd_blk_release(cid);
+	}
+#else
+	LOTRACE_NOTICE("Not supported");
+#endif
+	return -1;
+}
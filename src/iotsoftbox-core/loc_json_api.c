@@ -17,13 +17,46 @@
 #endif
 #include "liveobjects-sys/loc_trace.h"
 
+#include <float.h>
 #include <stdbool.h>
-#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "liveobjects-client/LiveObjectsClient_Config.h"
+
 #include "liveobjects-sys/LiveObjectsClient_Platform.h"
 #include "platform_default.h"
 
+#if (LOM_JSON_MAX_DEPTH < 1) || (LOM_JSON_MAX_DEPTH > 32)
+#error "LOM_JSON_MAX_DEPTH must be in 1..32"
+#endif
+
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/pgmspace.h>
+#define JSON_PROGMEM          PROGMEM
+#define JSON_DIGIT(i)         ((char) pgm_read_byte(&_LO_json_digits[i]))
+#define JSON_HEX_DIGIT(i)     ((char) pgm_read_byte(&_LO_hex_digits[i]))
+#define JSON_HEX_VALUE(c)     (pgm_read_byte(&_LO_hex_values[c]))
+#else
+#define JSON_PROGMEM
+#define JSON_DIGIT(i)         (_LO_json_digits[i])
+#define JSON_HEX_DIGIT(i)     (_LO_hex_digits[i])
+#define JSON_HEX_VALUE(c)     (_LO_hex_values[c])
+#endif
+
+/* Two decimal digits for each value from 0 to 99 */
+static const char _LO_json_digits[200] JSON_PROGMEM =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
 static const char* _LO_json_dataTypeStr[LOD_TYPE_MAX_NOT_USED] = {
 		"unknown",
 		"i32", "i16", "i8",
@@ -107,12 +140,503 @@ LiveObjectsD_Type_t LO_getDataTypeFromStrL(const char* p, uint32_t len) {
 	return LOD_TYPE_UNKNOWN;
 }
 
+/* --------------------------------------------------------------------------------- */
+/* Append n characters at the write cursor */
+static int json_putn(LOJsonWriter_t* jw, const char* s, uint32_t n) {
+	if (jw->len + n >= jw->buf_sz) {
+		return -1;
+	}
+	memcpy(jw->buf_ptr + jw->len, s, n);
+	jw->len += n;
+	jw->buf_ptr[jw->len] = 0;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int json_puts(LOJsonWriter_t* jw, const char* s) {
+	return json_putn(jw, s, strlen(s));
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int json_putc(LOJsonWriter_t* jw, char c) {
+	if (jw->len + 1 >= jw->buf_sz) {
+		return -1;
+	}
+	jw->buf_ptr[jw->len++] = c;
+	jw->buf_ptr[jw->len] = 0;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Write the decimal digits of value, backward from pend. Return the first digit. */
+static char* json_fmt_u32(char* pend, uint32_t value) {
+	while (value >= 100) {
+		uint32_t q = value / 100;
+		uint32_t r = (value - (q * 100)) * 2;
+		value = q;
+		*--pend = JSON_DIGIT(r + 1);
+		*--pend = JSON_DIGIT(r);
+	}
+	if (value >= 10) {
+		*--pend = JSON_DIGIT((value * 2) + 1);
+		*--pend = JSON_DIGIT(value * 2);
+	}
+	else {
+		*--pend = (char) ('0' + value);
+	}
+	return pend;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Append an unsigned integer, followed by sep (if not null). Same output as "%u" */
+static int json_put_u32(LOJsonWriter_t* jw, uint32_t value, char sep) {
+	char tmp[12];
+	char* pend = tmp + sizeof(tmp);
+	char* p;
+	if (sep) {
+		*--pend = sep;
+	}
+	p = json_fmt_u32(pend, value);
+	return json_putn(jw, p, (uint32_t) ((tmp + sizeof(tmp)) - p));
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Append a signed integer, followed by sep (if not null). Same output as "%d" */
+static int json_put_i32(LOJsonWriter_t* jw, int32_t value, char sep) {
+	char tmp[12];
+	char* pend = tmp + sizeof(tmp);
+	char* p;
+	if (sep) {
+		*--pend = sep;
+	}
+	if (value < 0) {
+		p = json_fmt_u32(pend, 0U - (uint32_t) value);
+		*--p = '-';
+	}
+	else {
+		p = json_fmt_u32(pend, (uint32_t) value);
+	}
+	return json_putn(jw, p, (uint32_t) ((tmp + sizeof(tmp)) - p));
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Remove the separator written after the last element, if any */
+static void json_trim_comma(LOJsonWriter_t* jw) {
+	if ((jw->len > 0) && (jw->buf_ptr[jw->len - 1] == ',')) {
+		jw->buf_ptr[--jw->len] = 0;
+	}
+}
+
+/* ================================================================================= */
+/* Floating point values: shortest representation which reads back to the same
+ * float (or double) value, computed with the Grisu2 algorithm (F. Loitsch,
+ * "Printing Floating-Point Numbers Quickly and Accurately with Integers", 2010).
+ */
+
+typedef struct {
+	uint64_t f;
+	int32_t  e;
+} JsonDiyFp_t;
+
+typedef struct {
+	uint64_t f;
+	int16_t  e;
+} JsonCachedPower_t;
+
+/* Normalized 64-bit approximations of 10^k, for k = -348, -340, ..., 340 */
+static const JsonCachedPower_t _LO_json_cached_powers[87] JSON_PROGMEM = {
+		{ 0xfa8fd5a0081c0288ULL, -1220 }, { 0xbaaee17fa23ebf76ULL, -1193 }, { 0x8b16fb203055ac76ULL, -1166 },
+		{ 0xcf42894a5dce35eaULL, -1140 }, { 0x9a6bb0aa55653b2dULL, -1113 }, { 0xe61acf033d1a45dfULL, -1087 },
+		{ 0xab70fe17c79ac6caULL, -1060 }, { 0xff77b1fcbebcdc4fULL, -1034 }, { 0xbe5691ef416bd60cULL, -1007 },
+		{ 0x8dd01fad907ffc3cULL, -980 }, { 0xd3515c2831559a83ULL, -954 }, { 0x9d71ac8fada6c9b5ULL, -927 },
+		{ 0xea9c227723ee8bcbULL, -901 }, { 0xaecc49914078536dULL, -874 }, { 0x823c12795db6ce57ULL, -847 },
+		{ 0xc21094364dfb5637ULL, -821 }, { 0x9096ea6f3848984fULL, -794 }, { 0xd77485cb25823ac7ULL, -768 },
+		{ 0xa086cfcd97bf97f4ULL, -741 }, { 0xef340a98172aace5ULL, -715 }, { 0xb23867fb2a35b28eULL, -688 },
+		{ 0x84c8d4dfd2c63f3bULL, -661 }, { 0xc5dd44271ad3cdbaULL, -635 }, { 0x936b9fcebb25c996ULL, -608 },
+		{ 0xdbac6c247d62a584ULL, -582 }, { 0xa3ab66580d5fdaf6ULL, -555 }, { 0xf3e2f893dec3f126ULL, -529 },
+		{ 0xb5b5ada8aaff80b8ULL, -502 }, { 0x87625f056c7c4a8bULL, -475 }, { 0xc9bcff6034c13053ULL, -449 },
+		{ 0x964e858c91ba2655ULL, -422 }, { 0xdff9772470297ebdULL, -396 }, { 0xa6dfbd9fb8e5b88fULL, -369 },
+		{ 0xf8a95fcf88747d94ULL, -343 }, { 0xb94470938fa89bcfULL, -316 }, { 0x8a08f0f8bf0f156bULL, -289 },
+		{ 0xcdb02555653131b6ULL, -263 }, { 0x993fe2c6d07b7facULL, -236 }, { 0xe45c10c42a2b3b06ULL, -210 },
+		{ 0xaa242499697392d3ULL, -183 }, { 0xfd87b5f28300ca0eULL, -157 }, { 0xbce5086492111aebULL, -130 },
+		{ 0x8cbccc096f5088ccULL, -103 }, { 0xd1b71758e219652cULL, -77 }, { 0x9c40000000000000ULL, -50 },
+		{ 0xe8d4a51000000000ULL, -24 }, { 0xad78ebc5ac620000ULL, 3 }, { 0x813f3978f8940984ULL, 30 },
+		{ 0xc097ce7bc90715b3ULL, 56 }, { 0x8f7e32ce7bea5c70ULL, 83 }, { 0xd5d238a4abe98068ULL, 109 },
+		{ 0x9f4f2726179a2245ULL, 136 }, { 0xed63a231d4c4fb27ULL, 162 }, { 0xb0de65388cc8ada8ULL, 189 },
+		{ 0x83c7088e1aab65dbULL, 216 }, { 0xc45d1df942711d9aULL, 242 }, { 0x924d692ca61be758ULL, 269 },
+		{ 0xda01ee641a708deaULL, 295 }, { 0xa26da3999aef774aULL, 322 }, { 0xf209787bb47d6b85ULL, 348 },
+		{ 0xb454e4a179dd1877ULL, 375 }, { 0x865b86925b9bc5c2ULL, 402 }, { 0xc83553c5c8965d3dULL, 428 },
+		{ 0x952ab45cfa97a0b3ULL, 455 }, { 0xde469fbd99a05fe3ULL, 481 }, { 0xa59bc234db398c25ULL, 508 },
+		{ 0xf6c69a72a3989f5cULL, 534 }, { 0xb7dcbf5354e9beceULL, 561 }, { 0x88fcf317f22241e2ULL, 588 },
+		{ 0xcc20ce9bd35c78a5ULL, 614 }, { 0x98165af37b2153dfULL, 641 }, { 0xe2a0b5dc971f303aULL, 667 },
+		{ 0xa8d9d1535ce3b396ULL, 694 }, { 0xfb9b7cd9a4a7443cULL, 720 }, { 0xbb764c4ca7a44410ULL, 747 },
+		{ 0x8bab8eefb6409c1aULL, 774 }, { 0xd01fef10a657842cULL, 800 }, { 0x9b10a4e5e9913129ULL, 827 },
+		{ 0xe7109bfba19c0c9dULL, 853 }, { 0xac2820d9623bf429ULL, 880 }, { 0x80444b5e7aa7cf85ULL, 907 },
+		{ 0xbf21e44003acdd2dULL, 933 }, { 0x8e679c2f5e44ff8fULL, 960 }, { 0xd433179d9c8cb841ULL, 986 },
+		{ 0x9e19db92b4e31ba9ULL, 1013 }, { 0xeb96bf6ebadf77d9ULL, 1039 }, { 0xaf87023b9bf0ee6bULL, 1066 },
+};
+
+static const uint64_t _LO_json_pow10[20] JSON_PROGMEM = {
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+		1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+		100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+		1000000000000000000ULL, 10000000000000000000ULL
+};
+
+#if defined(ARDUINO_ARCH_AVR)
+static uint64_t json_pow10(int idx) {
+	uint64_t v;
+	memcpy_P(&v, &_LO_json_pow10[idx], sizeof(v));
+	return v;
+}
+static JsonDiyFp_t json_cached_power(int idx) {
+	JsonCachedPower_t c;
+	JsonDiyFp_t r;
+	memcpy_P(&c, &_LO_json_cached_powers[idx], sizeof(c));
+	r.f = c.f;
+	r.e = c.e;
+	return r;
+}
+#else
+#define json_pow10(idx)      (_LO_json_pow10[idx])
+static JsonDiyFp_t json_cached_power(int idx) {
+	JsonDiyFp_t r;
+	r.f = _LO_json_cached_powers[idx].f;
+	r.e = _LO_json_cached_powers[idx].e;
+	return r;
+}
+#endif
+
+/* --------------------------------------------------------------------------------- */
+/* Shift left until the most significant bit is set */
+static JsonDiyFp_t json_fp_normalize(JsonDiyFp_t x) {
+	while (!(x.f & 0xFF00000000000000ULL)) {
+		x.f <<= 8;
+		x.e -= 8;
+	}
+	while (!(x.f & 0x8000000000000000ULL)) {
+		x.f <<= 1;
+		x.e--;
+	}
+	return x;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Rounded upper 64 bits of the 128-bit product */
+static JsonDiyFp_t json_fp_mul(JsonDiyFp_t x, JsonDiyFp_t y) {
+	const uint64_t M32 = 0xFFFFFFFFULL;
+	uint64_t a = x.f >> 32;
+	uint64_t b = x.f & M32;
+	uint64_t c = y.f >> 32;
+	uint64_t d = y.f & M32;
+	uint64_t ac = a * c;
+	uint64_t bc = b * c;
+	uint64_t ad = a * d;
+	uint64_t bd = b * d;
+	uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+	JsonDiyFp_t r;
+	tmp += 1ULL << 31;
+	r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+	r.e = x.e + y.e + 64;
+	return r;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Remove the excess of the last digit while the result is closer to the exact value */
+static void json_grisu_round(char* buf, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+	while ((rest < wp_w) && ((delta - rest) >= ten_kappa)
+			&& (((rest + ten_kappa) < wp_w) || ((wp_w - rest) > (rest + ten_kappa - wp_w)))) {
+		buf[len - 1]--;
+		rest += ten_kappa;
+	}
+}
+
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_begin(char *pbuf, uint32_t sz) {
+static int json_count_digits(uint32_t n) {
+	int k = 1;
+	while ((k < 10) && (n >= (uint32_t) json_pow10(k))) {
+		k++;
+	}
+	return k;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Generate the shortest digits of W within [Mp - delta, Mp]  */
+static void json_grisu_digits(JsonDiyFp_t W, JsonDiyFp_t Mp, uint64_t delta, char* buf, int* len, int* K) {
+	const int shift = -Mp.e;
+	const uint64_t one = 1ULL << shift;
+	const uint64_t wp_w = Mp.f - W.f;
+	uint32_t p1 = (uint32_t) (Mp.f >> shift);
+	uint64_t p2 = Mp.f & (one - 1);
+	int kappa = json_count_digits(p1);
+
+	*len = 0;
+	while (kappa > 0) {
+		uint32_t p10 = (uint32_t) json_pow10(kappa - 1);
+		uint32_t d = p1 / p10;
+		uint64_t rest;
+		p1 -= d * p10;
+		if (d || *len) {
+			buf[(*len)++] = (char) ('0' + d);
+		}
+		kappa--;
+		rest = ((uint64_t) p1 << shift) + p2;
+		if (rest <= delta) {
+			*K += kappa;
+			json_grisu_round(buf, *len, delta, rest, json_pow10(kappa) << shift, wp_w);
+			return;
+		}
+	}
+	for (;;) {
+		char d;
+		p2 *= 10;
+		delta *= 10;
+		d = (char) (p2 >> shift);
+		if (d || *len) {
+			buf[(*len)++] = (char) ('0' + d);
+		}
+		p2 &= one - 1;
+		kappa--;
+		if (p2 < delta) {
+			*K += kappa;
+			json_grisu_round(buf, *len, delta, p2, one, (-kappa < 20) ? wp_w * json_pow10(-kappa) : 0);
+			return;
+		}
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Shortest digits of v = f * 2^e (f not null): v ~= buf[0..len-1] * 10^K
+ * lower_closer is set when the lower neighbour of v is closer than the upper one
+ * (significand is a power of two).
+ */
+static void json_grisu2(uint64_t f, int32_t e, uint8_t lower_closer, char* buf, int* len, int* K) {
+	JsonDiyFp_t v, mp, mm, c_mk, W, Wp, Wm;
+	int32_t t;
+	int32_t k;
+	int idx;
+
+	/* Boundaries m+ and m- (halfway to the neighbours), with the same exponent */
+	mp.f = (f << 1) + 1;
+	mp.e = e - 1;
+	mp = json_fp_normalize(mp);
+	if (lower_closer) {
+		mm.f = (f << 2) - 1;
+		mm.e = e - 2;
+	}
+	else {
+		mm.f = (f << 1) - 1;
+		mm.e = e - 1;
+	}
+	mm.f <<= mm.e - mp.e;
+	mm.e = mp.e;
+
+	/* Cached power c_mk = 10^-K such that the exponent of m+ * c_mk is in [-60, -32]:
+	 * k = ceil((-61 - e) * log10(2)), with log10(2) ~= 78913 / 2^18 */
+	t = (-61 - mp.e) * 78913L;
+	k = (t >> 18) + (((t & 0x3FFFF) != 0) ? 1 : 0) + 347;
+	idx = (int) ((k >> 3) + 1);
+	*K = -(-348 + idx * 8);
+	c_mk = json_cached_power(idx);
+
+	v.f = f;
+	v.e = e;
+	W = json_fp_mul(json_fp_normalize(v), c_mk);
+	Wp = json_fp_mul(mp, c_mk);
+	Wm = json_fp_mul(mm, c_mk);
+	Wm.f++;
+	Wp.f--;
+	json_grisu_digits(W, Wp, Wp.f - Wm.f, buf, len, K);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Append a floating point value given by its IEEE-754 fields, followed by sep (if not null).
+ * prec > 0 limits the number of decimals.
+ * Output is the shortest JSON number which reads back to the same value, always with
+ * a decimal point or an exponent: 21.5  0.001  -3.0  1500.0  1.5e6  1.5e-7  3.4028235e38
+ * NaN and infinity have no JSON representation: null is written.
+ */
+static int json_put_fp(LOJsonWriter_t* jw, uint8_t neg, uint64_t f, int32_t e, uint8_t lower_closer,
+		uint8_t special, int8_t prec, char sep) {
+	char digits[20];
+	char tmp[48];
+	char* p = tmp;
+	int len;
+	int K;
+	int kk;
+	int i;
+
+	if (special) {
+		if (json_putn(jw, "null", 4))
+			return -1;
+		return (sep) ? json_putc(jw, sep) : 0;
+	}
+
+	if (f == 0) {
+		len = 1;
+		digits[0] = '0';
+		K = 0;
+	}
+	else {
+		json_grisu2(f, e, lower_closer, digits, &len, &K);
+	}
+
+	/* Round to the given number of decimals, then remove the trailing zeros */
+	if ((prec > 0) && (K < -prec)) {
+		int n = len + K + prec;
+		if ((n < 0) || ((n == 0) && (digits[0] < '5'))) {
+			len = 1;
+			digits[0] = '0';
+			K = 0;
+		}
+		else {
+			uint8_t carry = (n == 0) || (digits[n] >= '5');
+			len = n;
+			K = -prec;
+			for (i = len - 1; carry && (i >= 0); i--) {
+				if (digits[i] == '9') {
+					digits[i] = '0';
+				}
+				else {
+					digits[i]++;
+					carry = 0;
+				}
+			}
+			if (carry) {
+				/* 9...9 rounded to 10...0 */
+				digits[0] = '1';
+				K += len;
+				len = 1;
+			}
+			while ((len > 1) && (digits[len - 1] == '0')) {
+				len--;
+				K++;
+			}
+		}
+	}
+
+	if (neg && ((len > 1) || (digits[0] != '0') || (prec <= 0))) {
+		*p++ = '-';
+	}
+
+	/* Position of the decimal point: value = 0.digits * 10^kk
+	 * The exponent notation is used when more than 3 zeros would be needed. */
+	kk = len + K;
+	if ((K >= 0) && (K <= 3)) {
+		/* 1234e7 -> 12340000000.0 */
+		memcpy(p, digits, len);
+		p += len;
+		for (i = 0; i < K; i++) {
+			*p++ = '0';
+		}
+		*p++ = '.';
+		*p++ = '0';
+	}
+	else if ((K < 0) && (kk > 0)) {
+		/* 1234e-2 -> 12.34 */
+		memcpy(p, digits, kk);
+		p += kk;
+		*p++ = '.';
+		memcpy(p, digits + kk, len - kk);
+		p += len - kk;
+	}
+	else if ((K < 0) && (kk >= -3)) {
+		/* 1234e-6 -> 0.001234 */
+		*p++ = '0';
+		*p++ = '.';
+		for (i = kk; i < 0; i++) {
+			*p++ = '0';
+		}
+		memcpy(p, digits, len);
+		p += len;
+	}
+	else {
+		/* 1234e-10 -> 1.234e-7 , 12e5 -> 1.2e6 */
+		int exp10 = kk - 1;
+		*p++ = digits[0];
+		if (len > 1) {
+			*p++ = '.';
+			memcpy(p, digits + 1, len - 1);
+			p += len - 1;
+		}
+		*p++ = 'e';
+		if (exp10 < 0) {
+			*p++ = '-';
+			exp10 = -exp10;
+		}
+		p += json_count_digits((uint32_t) exp10);
+		json_fmt_u32(p, (uint32_t) exp10);
+	}
+	if (sep) {
+		*p++ = sep;
+	}
+	return json_putn(jw, tmp, (uint32_t) (p - tmp));
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Append a float value, followed by sep (if not null) */
+static int json_put_float(LOJsonWriter_t* jw, float value, int8_t prec, char sep) {
+	uint32_t u;
+	uint32_t biased_e;
+	uint32_t sig;
+	memcpy(&u, &value, sizeof(u));
+	biased_e = (u >> 23) & 0xFF;
+	sig = u & 0x7FFFFF;
+	if (biased_e == 0xFF) {
+		return json_put_fp(jw, 0, 0, 0, 0, 1, prec, sep);
+	}
+	if (biased_e) {
+		return json_put_fp(jw, (uint8_t) (u >> 31), sig | 0x800000UL, (int32_t) biased_e - 150, (sig == 0), 0, prec,
+				sep);
+	}
+	return json_put_fp(jw, (uint8_t) (u >> 31), sig, -149, 0, 0, prec, sep);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Append a double value, followed by sep (if not null) */
+static int json_put_double(LOJsonWriter_t* jw, double value, int8_t prec, char sep) {
+#if defined(__SIZEOF_DOUBLE__) && (__SIZEOF_DOUBLE__ == 4)
+	/* double is a 32-bit float (i.e. AVR) */
+	return json_put_float(jw, (float) value, prec, sep);
+#else
+	uint64_t u;
+	uint32_t biased_e;
+	uint64_t sig;
+	memcpy(&u, &value, sizeof(u));
+	biased_e = (uint32_t) (u >> 52) & 0x7FF;
+	sig = u & 0x000FFFFFFFFFFFFFULL;
+	if (biased_e == 0x7FF) {
+		return json_put_fp(jw, 0, 0, 0, 0, 1, prec, sep);
+	}
+	if (biased_e) {
+		return json_put_fp(jw, (uint8_t) (u >> 63), sig | 0x0010000000000000ULL, (int32_t) biased_e - 1075,
+				(sig == 0), 0, prec, sep);
+	}
+	return json_put_fp(jw, (uint8_t) (u >> 63), sig, -1074, 0, 0, prec, sep);
+#endif
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void LO_json_init(LOJsonWriter_t* jw, char *pbuf, uint32_t sz) {
+	jw->buf_ptr = pbuf;
+	jw->buf_sz = (pbuf) ? sz : 0;
+	jw->len = 0;
+	if (jw->buf_sz) {
+		*pbuf = 0;
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_json_begin(LOJsonWriter_t* jw) {
 	int rc;
-	rc = snprintf(pbuf, sz, "{");
-	if (rc != 1) {
+	jw->len = 0;
+	rc = json_putc(jw, '{');
+	if (rc) {
 		LOTRACE_ERR("failed %d", rc);
 		return -1;
 	}
@@ -121,16 +645,11 @@ int LO_json_begin(char *pbuf, uint32_t sz) {
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_end(char *pbuf, uint32_t sz) {
+int LO_json_end(LOJsonWriter_t* jw) {
 	int rc;
-	int len = sz - strlen(pbuf);
-	char* pcur = pbuf + strlen(pbuf);
-	if (*(pcur - 1) == ',') {
-		pcur--;
-		len++;
-	}
-	rc = snprintf(pcur, sz, "}");
-	if (rc != 1) {
+	json_trim_comma(jw);
+	rc = json_putc(jw, '}');
+	if (rc) {
 		LOTRACE_ERR("failed %d", rc);
 		return -1;
 	}
@@ -139,12 +658,14 @@ int LO_json_end(char *pbuf, uint32_t sz) {
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_add_section_start(const char* section_name, char *pbuf, uint32_t sz) {
+int LO_json_add_section_start(LOJsonWriter_t* jw, const char* section_name) {
 	int rc;
-	int len = sz - strlen(pbuf);
-	char* pcur = pbuf + strlen(pbuf);
-	rc = snprintf(pcur, len, "\"%s\": {", section_name);
-	if (rc < 0) {
+	rc = json_putc(jw, '"');
+	if (rc == 0)
+		rc = json_puts(jw, section_name);
+	if (rc == 0)
+		rc = json_putn(jw, "\": {", 4);
+	if (rc) {
 		LOTRACE_ERR("(%s): failed, rc=%d", section_name, rc);
 		return -1;
 	}
@@ -153,16 +674,11 @@ int LO_json_add_section_start(const char* section_name, char *pbuf, uint32_t sz)
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_add_section_end(char *pbuf, uint32_t sz) {
+int LO_json_add_section_end(LOJsonWriter_t* jw) {
 	int rc;
-	int len = sz - strlen(pbuf);
-	char* pcur = pbuf + strlen(pbuf);
-	if (*(pcur - 1) == ',') {
-		pcur--;
-		len++;
-	}
-	rc = snprintf(pcur, len, "},");
-	if (rc != 2) {
+	json_trim_comma(jw);
+	rc = json_putn(jw, "},", 2);
+	if (rc) {
 		LOTRACE_ERR("failed, rc=%d", rc);
 		return -1;
 	}
@@ -171,15 +687,16 @@ int LO_json_add_section_end(char *pbuf, uint32_t sz) {
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_begin_section(char *pbuf, uint32_t sz, const char* section_name) {
+int LO_json_begin_section(LOJsonWriter_t* jw, const char* section_name) {
 	int rc;
-	rc = snprintf(pbuf, sz, "{\"%s\":{", section_name);
-	if (rc <= 0) {
-		LOTRACE_ERR("failed %d", rc);
-		return -1;
-	}
-	if (rc == (int) sz) {
-		LOTRACE_ERR("too short %d", rc);
+	jw->len = 0;
+	rc = json_putn(jw, "{\"", 2);
+	if (rc == 0)
+		rc = json_puts(jw, section_name);
+	if (rc == 0)
+		rc = json_putn(jw, "\":{", 3);
+	if (rc) {
+		LOTRACE_ERR("too short (%s), sz=%"PRIu32, section_name, jw->buf_sz);
 		return -1;
 	}
 	return 0;
@@ -187,17 +704,12 @@ int LO_json_begin_section(char *pbuf, uint32_t sz, const char* section_name) {
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_end_section(char *pbuf, uint32_t sz) {
+int LO_json_end_section(LOJsonWriter_t* jw) {
 	int rc;
-	int len = sz - strlen(pbuf);
-	char* pcur = pbuf + strlen(pbuf);
-	if (*(pcur - 1) == ',') {
-		pcur--;
-		len++;
-	}
-	rc = snprintf(pcur, len, "}}");
-	if (rc != 2) {
-		LOTRACE_ERR("failed %d != 2", rc);
+	json_trim_comma(jw);
+	rc = json_putn(jw, "}}", 2);
+	if (rc) {
+		LOTRACE_ERR("failed %d", rc);
 		return -1;
 	}
 	return 0;
@@ -205,13 +717,16 @@ int LO_json_end_section(char *pbuf, uint32_t sz) {
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_add_name_int(const char* name, int32_t value, char *pbuf, uint32_t sz) {
+int LO_json_add_name_int(LOJsonWriter_t* jw, const char* name, int32_t value) {
 	int rc;
-	int len = sz - strlen(pbuf);
-	char* pcur = pbuf + strlen(pbuf);
-
-	rc = snprintf(pcur, len, "\"%s\":%"PRIi32",", name, value);
-	if (rc < 0) {
+	rc = json_putc(jw, '"');
+	if (rc == 0)
+		rc = json_puts(jw, name);
+	if (rc == 0)
+		rc = json_putn(jw, "\":", 2);
+	if (rc == 0)
+		rc = json_put_i32(jw, value, ',');
+	if (rc) {
 		LOTRACE_ERR("(%s, %"PRIi32"): failed, rc=%d", name, value, rc);
 		return -1;
 	}
@@ -220,13 +735,18 @@ int LO_json_add_name_int(const char* name, int32_t value, char *pbuf, uint32_t s
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_add_name_str(const char* name, const char* value, char *pbuf, uint32_t sz) {
+int LO_json_add_name_str(LOJsonWriter_t* jw, const char* name, const char* value) {
 	int rc;
-	int len = sz - strlen(pbuf);
-	char* pcur = pbuf + strlen(pbuf);
-
-	rc = snprintf(pcur, len, "\"%s\":\"%s\",", name, value);
-	if (rc < 0) {
+	rc = json_putc(jw, '"');
+	if (rc == 0)
+		rc = json_puts(jw, name);
+	if (rc == 0)
+		rc = json_putn(jw, "\":\"", 3);
+	if (rc == 0)
+		rc = json_puts(jw, value);
+	if (rc == 0)
+		rc = json_putn(jw, "\",", 2);
+	if (rc) {
 		LOTRACE_ERR("(%s, %s): failed, rc=%d", name, value, rc);
 		return -1;
 	}
@@ -235,28 +755,38 @@ int LO_json_add_name_str(const char* name, const char* value, char *pbuf, uint32
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_add_name_array(const char* name, const char* array, char *pbuf, uint32_t sz) {
+int LO_json_add_name_array(LOJsonWriter_t* jw, const char* name, const char* array) {
 	int rc;
-	int len = sz - strlen(pbuf);
-	char* pcur = pbuf + strlen(pbuf);
-
-	rc = snprintf(pcur, len, "\"%s\":[%s],", name, array);
-	if (rc < 0) {
+	rc = json_putc(jw, '"');
+	if (rc == 0)
+		rc = json_puts(jw, name);
+	if (rc == 0)
+		rc = json_putn(jw, "\":[", 3);
+	if (rc == 0)
+		rc = json_puts(jw, array);
+	if (rc == 0)
+		rc = json_putn(jw, "],", 2);
+	if (rc) {
 		LOTRACE_ERR("(%s, %s): failed, rc=%d", name, array, rc);
 		return -1;
 	}
 	return 0;
 }
 
+/* --------------------------------------------------------------------------------- */
+/* Add a pre-rendered JSON text */
+int LO_json_add_raw(LOJsonWriter_t* jw, const char* text, uint32_t len) {
+	if (json_putn(jw, text, len)) {
+		LOTRACE_ERR("(len=%"PRIu32"): failed, free len = %"PRIu32, len, jw->buf_sz - jw->len);
+		return -1;
+	}
+	return 0;
+}
+
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_add_item(const LiveObjectsD_Data_t* data_ptr, char *pbuf, uint32_t sz) {
+int LO_json_add_item(LOJsonWriter_t* jw, const LiveObjectsD_Data_t* data_ptr) {
 	int rc;
-	short i;
-	short dim;
-	char* data_value_ptr;
-	int len = sz - strlen(pbuf);
-	char* pcur = pbuf + strlen(pbuf);
 
 	/* Check input parameters */
 	if (data_ptr == NULL) {
@@ -268,125 +798,113 @@ int LO_json_add_item(const LiveObjectsD_Data_t* data_ptr, char *pbuf, uint32_t s
 			data_ptr->data_name, data_ptr->data_value, data_ptr->data_dim);
 		return -1;
 	}
-	
+
 	/* Add data name */
-	rc = snprintf(pcur, len, "\"%s\":", data_ptr->data_name);
-	if (rc < 0) {
+	rc = json_putc(jw, '"');
+	if (rc == 0)
+		rc = json_puts(jw, data_ptr->data_name);
+	if (rc == 0)
+		rc = json_putn(jw, "\":", 2);
+	if (rc) {
 		LOTRACE_ERR("(%d, %s): failed, rc=%d", data_ptr->data_type, data_ptr->data_name, rc);
 		return -1;
 	}
-	len = sz - strlen(pbuf);
-	pcur = pbuf + strlen(pbuf);
-	if (len < 4) { /* at least 4 free bytes remaining in buffer */
-		LOTRACE_ERR("(%d, %s): failed, free len = %d < 4", data_ptr->data_type, data_ptr->data_name, len);
+
+	return LO_json_add_value(jw, data_ptr);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Add the value(s) of a data, without its name */
+int LO_json_add_value(LOJsonWriter_t* jw, const LiveObjectsD_Data_t* data_ptr) {
+	int rc;
+	short i;
+	short dim;
+	const char* data_value_ptr;
+
+	if ((data_ptr == NULL) || (data_ptr->data_value == NULL) || (data_ptr->data_dim <= 0)) {
+		LOTRACE_ERR("Invalid DataDef - data_ptr=%p", data_ptr);
 		return -1;
 	}
 
 	/* Open array if needed */
 	dim = data_ptr->data_dim;
-	if (dim > 1) {
-		*pcur++ = '[';
-		len--;
-	}
-	else if (dim <= 0) {
-		LOTRACE_ERR("(%d, %s): force dim=%d to 1", data_ptr->data_type, data_ptr->data_name, dim);
-		dim = 1;
+	if ((dim > 1) && (json_putc(jw, '['))) {
+		LOTRACE_ERR("(%d, %s): failed, free len = %"PRIu32, data_ptr->data_type, data_ptr->data_name,
+				jw->buf_sz - jw->len);
+		return -1;
 	}
 
-	data_value_ptr = (char*)data_ptr->data_value;
+	data_value_ptr = (const char*)data_ptr->data_value;
 
 	/* Add value(s) */
 	for (i=0; i<dim; i++) {
 		switch (data_ptr->data_type) {
 		case LOD_TYPE_INT32:
-			rc = snprintf(pcur, len, "%"PRIi32",", *((int32_t*) data_value_ptr));
+			rc = json_put_i32(jw, *((const int32_t*) data_value_ptr), ',');
 			data_value_ptr += sizeof(int32_t);
 			break;
 		case LOD_TYPE_INT16:
-			rc = snprintf(pcur, len, "%"PRIi16",", *((int16_t*)data_value_ptr));
+			rc = json_put_i32(jw, *((const int16_t*) data_value_ptr), ',');
 			data_value_ptr += sizeof(int16_t);
 			break;
 		case LOD_TYPE_INT8:
-			rc = snprintf(pcur, len, "%"PRIi8"," , *((int8_t*)data_value_ptr));
+			rc = json_put_i32(jw, *((const int8_t*) data_value_ptr), ',');
 			data_value_ptr += sizeof(int8_t);
 			break;
 		case LOD_TYPE_UINT32:
-			rc = snprintf(pcur, len, "%"PRIu32",", *((uint32_t*)data_value_ptr));
+			rc = json_put_u32(jw, *((const uint32_t*) data_value_ptr), ',');
 			data_value_ptr += sizeof(uint32_t);
 			break;
 		case LOD_TYPE_UINT16:
-			rc = snprintf(pcur, len, "%"PRIu16",", *((uint16_t*)data_value_ptr));
+			rc = json_put_u32(jw, *((const uint16_t*) data_value_ptr), ',');
 			data_value_ptr += sizeof(uint16_t);
 			break;
 		case LOD_TYPE_UINT8:
-			rc = snprintf(pcur, len, "%"PRIu8"," , *((uint8_t*)data_value_ptr));
+			rc = json_put_u32(jw, *((const uint8_t*) data_value_ptr), ',');
 			data_value_ptr += sizeof(uint8_t);
 			break;
 		case LOD_TYPE_FLOAT:
-#ifdef ARDUINO_DTOSTRE
-		    /* Need 1 for sign + 1 digit + 1 decimal-point + 6 digits + 'e' + sign + 2 for exponent */
-		    if (len < 13) {
-		        LOTRACE_ERR("failed - LOD_TYPE_FLOAT - Too short !");
-		        return -1;
-		    }
-	        if (dtostre((double)(*((float*)data_value_ptr)), pcur, 6, 0) != pcur) {
-	            LOTRACE_ERR("failed - LOD_TYPE_FLOAT - dtostre");
-	            return -1;
-	        }
-#else /* Not ARDUINO_DTOSTRE */
-            rc = snprintf(pcur, len, "%f,", *((float*)data_value_ptr));
-#endif
-            data_value_ptr += sizeof(float);
-		    break;
+			rc = json_put_float(jw, *((const float*) data_value_ptr), data_ptr->data_prec, ',');
+			data_value_ptr += sizeof(float);
+			break;
 		case LOD_TYPE_DOUBLE:
-#ifdef ARDUINO_DTOSTRE
-            /* Need 1 for sign + 1 digit + 1 decimal-point + 6 digits + 'e' + sign + 2 for exponent */
-		    if (len < 13) {
-		        LOTRACE_ERR("failed - LOD_TYPE_DOUBLE - Too short !");
-		        return -1;
-		    }
-	        if (dtostre(*((double*)data_ptr->data_value), pcur, 6, 0) != pcur) {
-	            LOTRACE_ERR("failed - LOD_TYPE_DOUBLE - dtostre");
-	            return -1;
-	        }
-#else /* Not ARDUINO_DTOSTRE */
-		    rc = snprintf(pcur, len, "%lf,", *((double*)data_value_ptr));
-#endif
-		    data_value_ptr += sizeof(double);
-            break;
+			rc = json_put_double(jw, *((const double*) data_value_ptr), data_ptr->data_prec, ',');
+			data_value_ptr += sizeof(double);
+			break;
 		case LOD_TYPE_BOOL:
-			rc = snprintf(pcur, len, "%s,", *((uint8_t*)data_value_ptr) ? "true" : "false");
+			if (*((const uint8_t*) data_value_ptr))
+				rc = json_putn(jw, "true,", 5);
+			else
+				rc = json_putn(jw, "false,", 6);
 			data_value_ptr += sizeof(uint8_t);
 			break;
 		case LOD_TYPE_STRING_C:
-			rc = snprintf(pcur, len, "\"%s\",", (const char*)data_value_ptr);
+			rc = json_putc(jw, '"');
+			if (rc == 0)
+				rc = json_puts(jw, (const char*)data_value_ptr);
+			if (rc == 0)
+				rc = json_putn(jw, "\",", 2);
 			data_value_ptr += sizeof(char*);
 			break;
 		default:
 			LOTRACE_ERR("failed - unknown type %d", data_ptr->data_type);
 			return -1;
 		}
-		/* Update remaining buffer size */
-		if (dim > 1) {
-			len = sz - strlen(pbuf);
-			pcur = pbuf + strlen(pbuf);
-			if (len < 2) { /* at least 2 free bytes remaining in buffer */
-				LOTRACE_ERR("(%d, %s)[%d]: failed, free len = %d < 2", data_ptr->data_type, data_ptr->data_name, i, len);
-				return -1;
-			}		
+		if (rc) {
+			LOTRACE_ERR("(%d, %s)[%d]: failed, free len = %"PRIu32, data_ptr->data_type, data_ptr->data_name, i,
+					jw->buf_sz - jw->len);
+			return -1;
 		}
 	}
 
-	/* Close array if needed */
+	/* Close array if needed: replace the last separator */
 	if (dim > 1) {
-		pcur--;
-		if ((*pcur != ',')  || (len < 2)){
-			LOTRACE_ERR("(%d, %s): failed, unexpected char %c or free len = %d", data_ptr->data_type, data_ptr->data_name, *pcur, len);
+		json_trim_comma(jw);
+		if (json_putn(jw, "],", 2)) {
+			LOTRACE_ERR("(%d, %s): failed, free len = %"PRIu32, data_ptr->data_type, data_ptr->data_name,
+					jw->buf_sz - jw->len);
 			return -1;
 		}
-		*pcur++ = ']';
-		*pcur++ = ',';
-		*pcur = 0;
 	}
 
 	LOTRACE_DBG1("OK - type=%d=%s name=%s", data_ptr->data_type, LO_getDataTypeToStr(data_ptr->data_type), data_ptr->data_name);
@@ -396,64 +914,63 @@ int LO_json_add_item(const LiveObjectsD_Data_t* data_ptr, char *pbuf, uint32_t s
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-int LO_json_add_param(const LiveObjectsD_Data_t* data_ptr, char *pbuf, uint32_t sz) {
+int LO_json_add_param(LOJsonWriter_t* jw, const LiveObjectsD_Data_t* data_ptr) {
 
     if ((data_ptr->data_type == LOD_TYPE_INT32) || (data_ptr->data_type == LOD_TYPE_UINT32) ||
         (data_ptr->data_type == LOD_TYPE_STRING_C) || (data_ptr->data_type == LOD_TYPE_FLOAT))
     {
         int rc;
-        int len = sz - strlen(pbuf);
-        char* pcur = pbuf + strlen(pbuf);
 
         /* Add param name */
-        rc = snprintf(pcur, len, "\"%s\":{", data_ptr->data_name);
-        if (rc < 0) {
+        rc = json_putc(jw, '"');
+        if (rc == 0)
+            rc = json_puts(jw, data_ptr->data_name);
+        if (rc == 0)
+            rc = json_putn(jw, "\":{", 3);
+        if (rc) {
             LOTRACE_ERR("(%d, %s): failed, rc=%d", data_ptr->data_type, data_ptr->data_name, rc);
             return -1;
         }
 
-        len = sz - strlen(pbuf);
-        pcur = pbuf + strlen(pbuf);
-
         /* Add param type and value */
         switch (data_ptr->data_type) {
         case LOD_TYPE_INT32:
-            rc = snprintf(pcur, len, "\"t\":\"i32\",\"v\":%d},", *((int*) data_ptr->data_value));
+            rc = json_putn(jw, "\"t\":\"i32\",\"v\":", 14);
+            if (rc == 0)
+                rc = json_put_i32(jw, *((const int32_t*) data_ptr->data_value), '}');
+            if (rc == 0)
+                rc = json_putc(jw, ',');
             break;
         case LOD_TYPE_UINT32:
-            rc = snprintf(pcur, len, "\"t\":\"u32\",\"v\":%u},", *((unsigned int*) data_ptr->data_value));
+            rc = json_putn(jw, "\"t\":\"u32\",\"v\":", 14);
+            if (rc == 0)
+                rc = json_put_u32(jw, *((const uint32_t*) data_ptr->data_value), '}');
+            if (rc == 0)
+                rc = json_putc(jw, ',');
             break;
         case LOD_TYPE_FLOAT:
-#ifdef ARDUINO_DTOSTRE
-            /* Need 14 for param type
-             *     + 1 for sign + 1 digit + 1 decimal-point + 6 digits + 'e' + sign + 2 for exponent
-             *     + 2 for ending brace and comma */
-            if (len < (14+13+2)) {
-                LOTRACE_ERR("failed - LOD_TYPE_FLOAT - Too short !");
-                return -1;
-            }
-
-            strcpy(pcur, "\"t\":\"f64\",\"v\":");
-            pcur += 14;
-            len -= 14;
-            if (dtostre((double)(*((float*) data_ptr->data_value)), pcur, 6, DTOSTR_ALWAYS_SIGN) != pcur) {
-                LOTRACE_ERR("failed - LOD_TYPE_FLOAT - dtostre");
-                return -1;
-            }
-            pcur += 13;
-            len -= 13;
-            strcpy(pcur, "},");
-#else /* Not ARDUINO_DTOSTRE */
-            rc = snprintf(pcur, len, "\"t\":\"f64\",\"v\":%f},", *((float*) data_ptr->data_value));
-#endif
+            rc = json_putn(jw, "\"t\":\"f64\",\"v\":", 14);
+            if (rc == 0)
+                rc = json_put_float(jw, *((const float*) data_ptr->data_value), data_ptr->data_prec, '}');
+            if (rc == 0)
+                rc = json_putc(jw, ',');
             break;
         case LOD_TYPE_STRING_C:
-            rc = snprintf(pcur, len, "\"t\":\"str\",\"v\":\"%s\"},", (const char*) data_ptr->data_value);
+            rc = json_putn(jw, "\"t\":\"str\",\"v\":\"", 15);
+            if (rc == 0)
+                rc = json_puts(jw, (const char*) data_ptr->data_value);
+            if (rc == 0)
+                rc = json_putn(jw, "\"},", 3);
             break;
         default:
             LOTRACE_ERR("LO_json_add_param: failed - type %d not implemented", data_ptr->data_type);
             return -1;
         }
+        if (rc) {
+            LOTRACE_ERR("(%d, %s): failed, free len = %"PRIu32, data_ptr->data_type, data_ptr->data_name,
+                    jw->buf_sz - jw->len);
+            return -1;
+        }
         LOTRACE_DBG1("OK - type=%d=%s name=%s", data_ptr->data_type, LO_getDataTypeToStr(data_ptr->data_type),
                 data_ptr->data_name);
         return 0;
@@ -463,3 +980,611 @@ int LO_json_add_param(const LiveObjectsD_Data_t* data_ptr, char *pbuf, uint32_t
             LO_getDataTypeToStr(data_ptr->data_type));
     return -1;
 }
+
+/* ================================================================================= */
+/* JSON reader
+ */
+
+/* What the reader expects after the white spaces */
+#define JSON_RD_VALUE     0    /* a value (or ']' to close an empty array) */
+#define JSON_RD_NAME      1    /* a member name (or '}' to close an empty object) */
+#define JSON_RD_COLON     2    /* ':' after a member name */
+#define JSON_RD_NEXT      3    /* ',' or the end of the current object/array */
+#define JSON_RD_DONE      4    /* nothing but white spaces, after the root value */
+
+#define JSON_IS_SPACE(c)  (((c) == ' ') || ((c) == '\t') || ((c) == '\r') || ((c) == '\n'))
+
+/* Vector scan: the reader looks for the next interesting byte (end of a string, of a primitive or of
+ * white spaces) JSON_VEC_SZ bytes at a time, and only goes back to the byte loop to handle it.
+ * JSON_VEC_EQ(v,c) : lanes equal to c, JSON_VEC_LE(v,c) : lanes (unsigned) not greater than c,
+ * json_vec_first(m) : index of the first set lane (JSON_VEC_SZ if none).
+ */
+#if (LOM_JSON_SIMD) && defined(__GNUC__)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define JSON_VEC_SZ           32
+typedef __m256i JsonVec_t;
+#define JSON_VEC_LOAD(p)      _mm256_loadu_si256((const __m256i*) (p))
+#define JSON_VEC_EQ(v, c)     _mm256_cmpeq_epi8((v), _mm256_set1_epi8(c))
+#define JSON_VEC_LE(v, c)     _mm256_cmpeq_epi8(_mm256_max_epu8((v), _mm256_set1_epi8(c)), _mm256_set1_epi8(c))
+#define JSON_VEC_OR(a, b)     _mm256_or_si256((a), (b))
+#define JSON_VEC_NOT(a)       _mm256_xor_si256((a), _mm256_set1_epi8(-1))
+static inline uint32_t json_vec_first(JsonVec_t m) {
+	uint32_t bits = (uint32_t) _mm256_movemask_epi8(m);
+	return (bits) ? (uint32_t) __builtin_ctz(bits) : JSON_VEC_SZ;
+}
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define JSON_VEC_SZ           16
+typedef __m128i JsonVec_t;
+#define JSON_VEC_LOAD(p)      _mm_loadu_si128((const __m128i*) (p))
+#define JSON_VEC_EQ(v, c)     _mm_cmpeq_epi8((v), _mm_set1_epi8(c))
+#define JSON_VEC_LE(v, c)     _mm_cmpeq_epi8(_mm_max_epu8((v), _mm_set1_epi8(c)), _mm_set1_epi8(c))
+#define JSON_VEC_OR(a, b)     _mm_or_si128((a), (b))
+#define JSON_VEC_NOT(a)       _mm_xor_si128((a), _mm_set1_epi8(-1))
+static inline uint32_t json_vec_first(JsonVec_t m) {
+	uint32_t bits = (uint32_t) _mm_movemask_epi8(m);
+	return (bits) ? (uint32_t) __builtin_ctz(bits) : JSON_VEC_SZ;
+}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define JSON_VEC_SZ           16
+typedef uint8x16_t JsonVec_t;
+#define JSON_VEC_LOAD(p)      vld1q_u8((const uint8_t*) (p))
+#define JSON_VEC_EQ(v, c)     vceqq_u8((v), vdupq_n_u8(c))
+#define JSON_VEC_LE(v, c)     vcleq_u8((v), vdupq_n_u8(c))
+#define JSON_VEC_OR(a, b)     vorrq_u8((a), (b))
+#define JSON_VEC_NOT(a)       vmvnq_u8(a)
+static inline uint32_t json_vec_first(JsonVec_t m) {
+	/* no movemask: narrow each lane to 4 bits */
+	uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+	return (bits) ? (uint32_t) (__builtin_ctzll(bits) >> 2) : JSON_VEC_SZ;
+}
+#endif
+#endif
+
+/* --------------------------------------------------------------------------------- */
+/* Skip white spaces. Return the pointer on the first other character (or end). */
+static const char* json_skip_spaces(const char* p, const char* end) {
+#if defined(JSON_VEC_SZ)
+	while (p + JSON_VEC_SZ <= end) {
+		JsonVec_t v = JSON_VEC_LOAD(p);
+		uint32_t i = json_vec_first(JSON_VEC_NOT(JSON_VEC_OR(JSON_VEC_OR(JSON_VEC_EQ(v, ' '), JSON_VEC_EQ(v, '\t')),
+				JSON_VEC_OR(JSON_VEC_EQ(v, '\r'), JSON_VEC_EQ(v, '\n')))));
+		p += i;
+		if (i < JSON_VEC_SZ)
+			return p;
+	}
+#endif
+	while ((p < end) && JSON_IS_SPACE(*p)) {
+		p++;
+	}
+	return p;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Scan a string from its opening quote. Return the pointer on the closing quote, end if the string is
+ * truncated, or NULL on a control character.
+ */
+static const char* json_scan_string(const char* p, const char* end) {
+	for (p++; p < end; p++) {
+#if defined(JSON_VEC_SZ)
+		// Jump to the next quote, backslash or control character
+		while (p + JSON_VEC_SZ <= end) {
+			JsonVec_t v = JSON_VEC_LOAD(p);
+			uint32_t i = json_vec_first(JSON_VEC_OR(JSON_VEC_OR(JSON_VEC_EQ(v, '"'), JSON_VEC_EQ(v, '\\')),
+					JSON_VEC_LE(v, 0x1F)));
+			p += i;
+			if (i < JSON_VEC_SZ)
+				break;
+		}
+		if (p >= end)
+			break;
+#endif
+		if (*p == '"')
+			return p;
+		if (*p == '\\') {
+			if (++p >= end)
+				break;
+		}
+		else if ((unsigned char) *p < 0x20) {
+			return NULL;
+		}
+	}
+	return end;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Scan a primitive (number, true, false, null). Return the pointer after the last character. */
+static const char* json_scan_primitive(const char* p, const char* end) {
+#if defined(JSON_VEC_SZ)
+	while (p + JSON_VEC_SZ <= end) {
+		JsonVec_t v = JSON_VEC_LOAD(p);
+		uint32_t i = json_vec_first(JSON_VEC_OR(
+				JSON_VEC_OR(JSON_VEC_OR(JSON_VEC_EQ(v, 0), JSON_VEC_EQ(v, ',')),
+						JSON_VEC_OR(JSON_VEC_EQ(v, '}'), JSON_VEC_EQ(v, ']'))),
+				JSON_VEC_OR(JSON_VEC_OR(JSON_VEC_EQ(v, ' '), JSON_VEC_EQ(v, '\t')),
+						JSON_VEC_OR(JSON_VEC_EQ(v, '\r'), JSON_VEC_EQ(v, '\n')))));
+		p += i;
+		if (i < JSON_VEC_SZ)
+			return p;
+	}
+#endif
+	while ((p < end) && (*p != 0) && (*p != ',') && (*p != '}') && (*p != ']') && !JSON_IS_SPACE(*p)) {
+		p++;
+	}
+	return p;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int json_check_primitive(const char* p, uint32_t len) {
+	uint32_t i;
+	if ((len == 4) && (!memcmp(p, "true", 4) || !memcmp(p, "null", 4)))
+		return 0;
+	if ((len == 5) && !memcmp(p, "false", 5))
+		return 0;
+	if ((*p != '-') && ((*p < '0') || (*p > '9')))
+		return -1;
+	for (i = 1; i < len; i++) {
+		if (((p[i] < '0') || (p[i] > '9')) && (p[i] != '.') && (p[i] != 'e') && (p[i] != 'E') && (p[i] != '-')
+				&& (p[i] != '+'))
+			return -1;
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void LO_json_reader_init(LOJsonReader_t* rd) {
+	rd->arrays = 0;
+	rd->depth = 0;
+	rd->state = JSON_RD_VALUE;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* When the piece is not the last one, the reader stops at the last position where nothing is pending
+ * (resume): after an event or a comma, but before a member name whose value is not complete.
+ */
+int LO_json_parse_part(LOJsonReader_t* rd, const char* text, uint32_t len, uint8_t last, LOJsonHandler_t handler,
+		void* ctx, uint32_t* pConsumed) {
+	uint16_t* count = rd->count;  /* number of values in each open object/array */
+	uint32_t arrays = rd->arrays; /* bit n set: the open container at depth n is an array */
+	uint8_t depth = rd->depth;
+	uint8_t state = rd->state;
+	const char* p = text;
+	const char* end = text + len;
+	const char* resume = text;
+	uint8_t resume_state = state;
+	const char* pc;
+	LOJsonToken_t tk;
+	int ret;
+
+	if ((text == NULL) || (handler == NULL)) {
+		LOTRACE_ERR("Invalid params - text=x%p handler=x%p", text, handler);
+		return LOJSON_ERR_INVAL;
+	}
+
+	tk.name_ptr = NULL;
+	tk.name_len = 0;
+
+	while ((p < end) && (*p != 0)) {
+		if (JSON_IS_SPACE(*p)) {
+			p = json_skip_spaces(p + 1, end);
+			continue;
+		}
+
+		switch (state) {
+		case JSON_RD_NAME:
+			if ((*p == '}') && (count[depth - 1] == 0))
+				goto json_close;
+			if (*p != '"')
+				goto json_inval;
+			pc = json_scan_string(p, end);
+			if (pc == NULL)
+				goto json_inval;
+			if (pc == end)
+				goto json_more;
+			tk.name_ptr = p + 1;
+			tk.name_len = pc - p - 1;
+			p = pc + 1;
+			state = JSON_RD_COLON;
+			continue;
+
+		case JSON_RD_COLON:
+			if (*p != ':')
+				goto json_inval;
+			p++;
+			state = JSON_RD_VALUE;
+			continue;
+
+		case JSON_RD_NEXT:
+			if (*p == ',') {
+				p++;
+				state = (arrays & (1UL << (depth - 1))) ? JSON_RD_VALUE : JSON_RD_NAME;
+				resume = p;
+				resume_state = state;
+				continue;
+			}
+			if (*p == ((arrays & (1UL << (depth - 1))) ? ']' : '}'))
+				goto json_close;
+			goto json_inval;
+
+		case JSON_RD_VALUE:
+			if ((*p == ']') && (depth) && (arrays & (1UL << (depth - 1))) && (count[depth - 1] == 0))
+				goto json_close;
+			break;
+
+		default:
+			goto json_inval;
+		}
+
+		/* a value */
+		tk.depth = depth;
+		tk.index = (depth) ? count[depth - 1] : 0;
+		if ((*p == '{') || (*p == '[')) {
+			if (depth >= LOM_JSON_MAX_DEPTH) {
+				LOTRACE_ERR("Too deep (max %u) at offset %u", LOM_JSON_MAX_DEPTH, (unsigned int) (p - text));
+				return LOJSON_ERR_DEPTH;
+			}
+			tk.evt = (*p == '{') ? LOJSON_EVT_OBJECT_BEGIN : LOJSON_EVT_ARRAY_BEGIN;
+			tk.val_ptr = p;
+			tk.val_len = 1;
+			ret = handler(ctx, &tk);
+			if (ret)
+				return ret;
+			if (*p == '[')
+				arrays |= (1UL << depth);
+			else
+				arrays &= ~(1UL << depth);
+			count[depth++] = 0;
+			state = (*p == '{') ? JSON_RD_NAME : JSON_RD_VALUE;
+			tk.name_ptr = NULL;
+			tk.name_len = 0;
+			p++;
+			resume = p;
+			resume_state = state;
+			continue;
+		}
+		if (*p == '"') {
+			pc = json_scan_string(p, end);
+			if (pc == NULL)
+				goto json_inval;
+			if (pc == end)
+				goto json_more;
+			tk.evt = LOJSON_EVT_STRING;
+			tk.val_ptr = p + 1;
+			tk.val_len = pc - p - 1;
+			p = pc + 1;
+		}
+		else {
+			pc = json_scan_primitive(p, end);
+			if ((pc == end) && (!last))
+				goto json_more;
+			if (json_check_primitive(p, pc - p))
+				goto json_inval;
+			tk.evt = LOJSON_EVT_PRIMITIVE;
+			tk.val_ptr = p;
+			tk.val_len = pc - p;
+			p = pc;
+		}
+		ret = handler(ctx, &tk);
+		if (ret)
+			return ret;
+		goto json_value_done;
+
+json_close:
+		depth--;
+		tk.evt = (arrays & (1UL << depth)) ? LOJSON_EVT_ARRAY_END : LOJSON_EVT_OBJECT_END;
+		tk.depth = depth;
+		tk.index = count[depth];
+		tk.name_ptr = NULL;
+		tk.name_len = 0;
+		tk.val_ptr = p;
+		tk.val_len = 1;
+		p++;
+		ret = handler(ctx, &tk);
+		if (ret)
+			return ret;
+
+json_value_done:
+		tk.name_ptr = NULL;
+		tk.name_len = 0;
+		if (depth) {
+			count[depth - 1]++;
+			state = JSON_RD_NEXT;
+		}
+		else {
+			state = JSON_RD_DONE;
+		}
+		resume = p;
+		resume_state = state;
+	}
+
+	if ((p == end) && (!last))
+		goto json_more;
+	if ((state == JSON_RD_DONE) || ((state == JSON_RD_VALUE) && (depth == 0))) {
+		if (pConsumed)
+			*pConsumed = len;
+		return 0;
+	}
+
+json_part:
+	LOTRACE_DBG1("Truncated JSON text, len=%"PRIu32, len);
+	return LOJSON_ERR_PART;
+
+json_more:
+	if (last)
+		goto json_part;
+	/* wait for the next piece, from the resume position */
+	rd->arrays = arrays;
+	rd->depth = depth;
+	rd->state = resume_state;
+	*pConsumed = resume - text;
+	return 0;
+
+json_inval:
+	LOTRACE_DBG1("Invalid JSON text - x%02x at offset %u", (unsigned char) *p, (unsigned int) (p - text));
+	return LOJSON_ERR_INVAL;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_json_parse(const char* text, uint32_t len, LOJsonHandler_t handler, void* ctx) {
+	LOJsonReader_t rd;
+	LO_json_reader_init(&rd);
+	return LO_json_parse_part(&rd, text, len, 1, handler, ctx, NULL);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Number parsers
+ * Length-bounded and locale-free, on the JSON number grammar:  -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+ * The integer parsers accept only the integer part, and fail if the value does not fit.
+ */
+
+/* Exact powers of ten (up to 10^22, exactly representable in a double) */
+static const double _LO_json_exact_pow10[23] JSON_PROGMEM = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+#if defined(ARDUINO_ARCH_AVR)
+static double json_exact_pow10(int idx) {
+	double v;
+	memcpy_P(&v, &_LO_json_exact_pow10[idx], sizeof(v));
+	return v;
+}
+#else
+#define json_exact_pow10(idx)  (_LO_json_exact_pow10[idx])
+#endif
+
+#define JSON_IS_DIGIT(c)   (((c) >= '0') && ((c) <= '9'))
+
+/* --------------------------------------------------------------------------------- */
+/* Unsigned integer part, not greater than max */
+static int json_get_uint(const char* p, uint32_t len, uint32_t max, uint32_t* pValue) {
+	const char* end = p + len;
+	uint32_t v = 0;
+
+	if ((len == 0) || !JSON_IS_DIGIT(*p) || ((*p == '0') && (len > 1)))
+		return -1;
+	while (p < end) {
+		uint32_t d = (uint32_t) (*p++ - '0');
+		if (d > 9)
+			return -1;
+		if (v > (max - d) / 10)
+			return -1;
+		v = v * 10 + d;
+	}
+	*pValue = v;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_json_get_uint32(const char* p, uint32_t len, uint32_t* pValue) {
+	if ((p == NULL) || (pValue == NULL))
+		return -1;
+	return json_get_uint(p, len, UINT32_MAX, pValue);
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_json_get_int32(const char* p, uint32_t len, int32_t* pValue) {
+	uint32_t v;
+	if ((p == NULL) || (pValue == NULL) || (len == 0))
+		return -1;
+	if (*p == '-') {
+		if (json_get_uint(p + 1, len - 1, (uint32_t) INT32_MAX + 1, &v))
+			return -1;
+		*pValue = (v > (uint32_t) INT32_MAX) ? INT32_MIN : -(int32_t) v;
+		return 0;
+	}
+	if (json_get_uint(p, len, INT32_MAX, &v))
+		return -1;
+	*pValue = (int32_t) v;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Exact (one rounding) when the mantissa fits in 53 bits and the decimal exponent is in -22..22, that is
+ * nearly all the received values. Otherwise strtod on a local copy, or within a few ulps for a very long text.
+ * Fails on overflow (infinity).
+ */
+int LO_json_get_double(const char* p, uint32_t len, double* pValue) {
+	const char* end = p + len;
+	uint64_t mant = 0;
+	int32_t exp10 = 0;
+	uint8_t ndigits = 0;
+	uint8_t neg = 0;
+	double d;
+
+	if ((p == NULL) || (pValue == NULL))
+		return -1;
+
+	if ((p < end) && (*p == '-')) {
+		neg = 1;
+		p++;
+	}
+	if ((p == end) || !JSON_IS_DIGIT(*p))
+		return -1;
+
+	// Integer part (no leading zero)
+	if (*p == '0') {
+		p++;
+	}
+	else {
+		while ((p < end) && JSON_IS_DIGIT(*p)) {
+			if (ndigits < 19) {
+				mant = mant * 10 + (uint64_t) (*p - '0');
+				ndigits++;
+			}
+			else {
+				exp10++;
+			}
+			p++;
+		}
+	}
+
+	// Fraction part
+	if ((p < end) && (*p == '.')) {
+		p++;
+		if ((p == end) || !JSON_IS_DIGIT(*p))
+			return -1;
+		while ((p < end) && JSON_IS_DIGIT(*p)) {
+			if (ndigits < 19) {
+				mant = mant * 10 + (uint64_t) (*p - '0');
+				if (mant)
+					ndigits++;
+				exp10--;
+			}
+			p++;
+		}
+	}
+
+	// Exponent part
+	if ((p < end) && ((*p == 'e') || (*p == 'E'))) {
+		int32_t e = 0;
+		uint8_t eneg = 0;
+		p++;
+		if ((p < end) && ((*p == '+') || (*p == '-'))) {
+			eneg = (*p == '-');
+			p++;
+		}
+		if ((p == end) || !JSON_IS_DIGIT(*p))
+			return -1;
+		while ((p < end) && JSON_IS_DIGIT(*p)) {
+			if (e < 10000)
+				e = e * 10 + (*p - '0');
+			p++;
+		}
+		exp10 += (eneg) ? -e : e;
+	}
+
+	if (p != end)
+		return -1;
+
+	d = (double) mant;
+	if ((mant) && (exp10)) {
+		if ((mant <= (1ULL << 53)) && (exp10 >= -22) && (exp10 <= 22)) {
+			// Both values are exact: a single correctly rounded operation
+			d = (exp10 > 0) ? d * json_exact_pow10(exp10) : d / json_exact_pow10(-exp10);
+		}
+		else if (len < 48) {
+			// Rare (long mantissa or large exponent): strtod is correctly rounded, the grammar is already checked
+			char buf[48];
+			memcpy(buf, end - len, len);
+			buf[len] = 0;
+			d = strtod((neg) ? buf + 1 : buf, NULL);
+			if (d > DBL_MAX)
+				return -1;
+		}
+		else {
+			while ((exp10 > 22) && (d <= DBL_MAX)) {
+				d *= 1e22;
+				exp10 -= 22;
+			}
+			while ((exp10 < -22) && (d > 0)) {
+				d /= 1e22;
+				exp10 += 22;
+			}
+			if (exp10 > 0)
+				d *= json_exact_pow10(exp10);
+			else if (exp10 < 0)
+				d /= json_exact_pow10(-exp10);
+			if (d > DBL_MAX)
+				return -1;
+		}
+	}
+	*pValue = (neg) ? -d : d;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_json_get_float(const char* p, uint32_t len, float* pValue) {
+	double d;
+	if ((pValue == NULL) || LO_json_get_double(p, len, &d))
+		return -1;
+	if ((d > FLT_MAX) || (d < -FLT_MAX))
+		return -1;
+	*pValue = (float) d;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Hexadecimal strings
+ */
+
+static const char _LO_hex_digits[16] JSON_PROGMEM = {
+		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+
+/* Value of each hexadecimal digit, with the bit 0x10 set (0: not a digit) */
+static const uint8_t _LO_hex_values[128] JSON_PROGMEM = {
+		['0'] = 0x10, ['1'] = 0x11, ['2'] = 0x12, ['3'] = 0x13, ['4'] = 0x14,
+		['5'] = 0x15, ['6'] = 0x16, ['7'] = 0x17, ['8'] = 0x18, ['9'] = 0x19,
+		['A'] = 0x1A, ['B'] = 0x1B, ['C'] = 0x1C, ['D'] = 0x1D, ['E'] = 0x1E, ['F'] = 0x1F,
+		['a'] = 0x1A, ['b'] = 0x1B, ['c'] = 0x1C, ['d'] = 0x1D, ['e'] = 0x1E, ['f'] = 0x1F };
+
+#define JSON_HEX(c)   ((((unsigned char) (c)) < 128) ? JSON_HEX_VALUE((unsigned char) (c)) : 0)
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_hex_decode(const char* p, uint32_t len, uint8_t* buf_ptr, uint32_t buf_sz) {
+	const char* end = p + len;
+
+	if ((p == NULL) || (buf_ptr == NULL) || (len & 1) || ((len / 2) > buf_sz))
+		return -1;
+
+	while (p < end) {
+		uint8_t hi = JSON_HEX(p[0]);
+		uint8_t lo = JSON_HEX(p[1]);
+		if (((hi & lo) & 0x10) == 0)
+			return -1;
+		*buf_ptr++ = (uint8_t) ((hi << 4) | (lo & 0x0F));
+		p += 2;
+	}
+	return (int) (len / 2);
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_hex_encode(char* buf_ptr, uint32_t buf_sz, const uint8_t* data, uint32_t len, char sep) {
+	char* pc = buf_ptr;
+	uint32_t i;
+
+	if ((buf_ptr == NULL) || (buf_sz == 0) || ((data == NULL) && (len)))
+		return -1;
+	if ((len) && ((len * 2 + ((sep) ? len - 1 : 0)) >= buf_sz)) {
+		*buf_ptr = 0;
+		return -1;
+	}
+
+	for (i = 0; i < len; i++) {
+		if ((sep) && (i))
+			*pc++ = sep;
+		*pc++ = JSON_HEX_DIGIT(data[i] >> 4);
+		*pc++ = JSON_HEX_DIGIT(data[i] & 0x0F);
+	}
+	*pc = 0;
+	return (int) (pc - buf_ptr);
+}
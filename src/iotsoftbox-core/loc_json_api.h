@@ -15,37 +15,193 @@
 #ifndef __loc_json_api_H_
 #define __loc_json_api_H_
 
+#include "liveobjects-client/LiveObjectsClient_Config.h"
 #include "liveobjects-client/LiveObjectsClient_Defs.h"
 
 #if defined(__cplusplus)
 extern "C" {
 #endif
 
+/**
+ * @brief JSON writer context.
+ *
+ * Keeps the write cursor and the capacity of the output buffer, so that
+ * each LO_json_xxx call appends at the cursor without rescanning the buffer.
+ * The output buffer is always terminated by a null character.
+ */
+typedef struct {
+	char*    buf_ptr;  /*!< Output buffer */
+	uint32_t buf_sz;   /*!< Size (in bytes) of the output buffer */
+	uint32_t len;      /*!< Current length of the JSON text (write cursor) */
+} LOJsonWriter_t;
+
+/**
+ * @brief JSON reader events (see LO_json_parse).
+ */
+typedef enum {
+	LOJSON_EVT_OBJECT_BEGIN = 1,  /*!< '{' */
+	LOJSON_EVT_OBJECT_END,        /*!< '}' */
+	LOJSON_EVT_ARRAY_BEGIN,       /*!< '[' */
+	LOJSON_EVT_ARRAY_END,         /*!< ']' */
+	LOJSON_EVT_STRING,            /*!< "..." */
+	LOJSON_EVT_PRIMITIVE          /*!< number, true, false or null */
+} LOJsonEvent_t;
+
+/**
+ * @brief JSON reader token, given to the event handler.
+ *
+ * Pointers refer to the parsed text, nothing is copied. A string value is given
+ * without its quotes, and its escape sequences are not decoded.
+ */
+typedef struct {
+	LOJsonEvent_t evt;       /*!< Event */
+	uint8_t       depth;     /*!< Depth of the value: 0 for the root value, 1 for the members of the root object, ... */
+	uint16_t      index;     /*!< Position of the value in its container, or number of values of the container (xxx_END) */
+	const char*   name_ptr;  /*!< Member name, NULL in an array, for the root value and for the xxx_END events */
+	uint32_t      name_len;  /*!< Length of the member name */
+	const char*   val_ptr;   /*!< Value text (STRING, PRIMITIVE), or position of the bracket (xxx_BEGIN, xxx_END) */
+	uint32_t      val_len;   /*!< Length of the value text */
+} LOJsonToken_t;
+
+/**
+ * @brief JSON reader event handler.
+ *
+ * @return 0 to continue, or a positive value to stop the parsing (returned by LO_json_parse)
+ */
+typedef int (*LOJsonHandler_t)(void* ctx, const LOJsonToken_t* tk);
+
+/**
+ * @brief JSON reader state, kept between the pieces of a JSON text received in several parts
+ * (see LO_json_parse_part).
+ */
+typedef struct {
+	uint16_t count[LOM_JSON_MAX_DEPTH];  /*!< Number of values in each open object/array */
+	uint32_t arrays;                     /*!< Bit n set: the open container at depth n is an array */
+	uint8_t  depth;                      /*!< Number of open objects/arrays */
+	uint8_t  state;                      /*!< What the reader expects next */
+} LOJsonReader_t;
+
+#define LOJSON_ERR_INVAL     -1   /*!< Invalid character or bad JSON structure */
+#define LOJSON_ERR_PART      -2   /*!< Truncated JSON text */
+#define LOJSON_ERR_DEPTH     -3   /*!< Nesting depth over LOM_JSON_MAX_DEPTH */
+
 const char* LO_getDataTypeToStr(LiveObjectsD_Type_t objType);
 
 LiveObjectsD_Type_t LO_getDataTypeFromStrL(const char* p, uint32_t len);
 
-int LO_json_begin(char *pbuf, uint32_t sz);
+void LO_json_init(LOJsonWriter_t* jw, char *pbuf, uint32_t sz);
+
+int LO_json_begin(LOJsonWriter_t* jw);
+
+int LO_json_end(LOJsonWriter_t* jw);
 
-int LO_json_end(char *pbuf, uint32_t sz);
+int LO_json_begin_section(LOJsonWriter_t* jw, const char* name);
 
-int LO_json_begin_section(char *pbuf, uint32_t sz, const char* name);
+int LO_json_end_section(LOJsonWriter_t* jw);
 
-int LO_json_end_section(char *pbuf, uint32_t sz);
+int LO_json_add_section_start(LOJsonWriter_t* jw, const char* section_name);
 
-int LO_json_add_section_start(const char* section_name, char *pbuf, uint32_t sz);
+int LO_json_add_section_end(LOJsonWriter_t* jw);
 
-int LO_json_add_section_end(char *pbuf, uint32_t sz);
+int LO_json_add_name_int(LOJsonWriter_t* jw, const char* name, int32_t value);
 
-int LO_json_add_name_int(const char* name, int32_t value, char *pbuf, uint32_t sz);
+int LO_json_add_name_str(LOJsonWriter_t* jw, const char* name, const char* value);
 
-int LO_json_add_name_str(const char* name, const char* value, char *pbuf, uint32_t sz);
+int LO_json_add_name_array(LOJsonWriter_t* jw, const char* name, const char* array);
 
-int LO_json_add_name_array(const char* name, const char* array, char *pbuf, uint32_t sz);
+int LO_json_add_raw(LOJsonWriter_t* jw, const char* text, uint32_t len);
 
-int LO_json_add_item(const LiveObjectsD_Data_t* p, char *pbuf, uint32_t sz);
+int LO_json_add_value(LOJsonWriter_t* jw, const LiveObjectsD_Data_t* data_ptr);
 
-int LO_json_add_param(const LiveObjectsD_Data_t* p, char *pbuf, uint32_t sz);
+int LO_json_add_item(LOJsonWriter_t* jw, const LiveObjectsD_Data_t* p);
+
+int LO_json_add_param(LOJsonWriter_t* jw, const LiveObjectsD_Data_t* p);
+
+/**
+ * @brief Parse a JSON text in a single pass, calling the handler for each value (SAX-style).
+ *
+ * No token array: the reader state is bounded by LOM_JSON_MAX_DEPTH, whatever the size of the text.
+ * The parsing stops at the end of the text, or at the first null character.
+ *
+ * @param text    JSON text (not necessarily null terminated)
+ * @param len     Length of the JSON text
+ * @param handler Event handler
+ * @param ctx     Context given to the event handler
+ *
+ * @return 0 if successful (also when the text is empty), a LOJSON_ERR_xxx negative value if the text is
+ *         not valid JSON, or the positive value returned by the handler to stop the parsing.
+ */
+int LO_json_parse(const char* text, uint32_t len, LOJsonHandler_t handler, void* ctx);
+
+/**
+ * @brief Initialize the state of the JSON reader, before the first piece of a JSON text.
+ */
+void LO_json_reader_init(LOJsonReader_t* rd);
+
+/**
+ * @brief Parse a piece of a JSON text received in several parts (same events as LO_json_parse).
+ *
+ * The reader stops before a member or a value which is not complete in the piece: the bytes not consumed
+ * must be given again, followed by the next received bytes, at the beginning of the next piece.
+ * So a string value (or a member name and its value) must fit in one piece.
+ * The token pointers refer to the piece: the handler must copy what it keeps after the call.
+ *
+ * @param rd        Reader state (see LO_json_reader_init)
+ * @param text      Piece of the JSON text
+ * @param len       Length of the piece
+ * @param last      1 if the piece ends the JSON text
+ * @param handler   Event handler
+ * @param ctx       Context given to the event handler
+ * @param pConsumed Number of bytes consumed in the piece (can be NULL when last is 1)
+ *
+ * @return 0 if successful, a LOJSON_ERR_xxx negative value if the text is not valid JSON, or the positive
+ *         value returned by the handler to stop the parsing.
+ */
+int LO_json_parse_part(LOJsonReader_t* rd, const char* text, uint32_t len, uint8_t last, LOJsonHandler_t handler,
+		void* ctx, uint32_t* pConsumed);
+
+/**
+ * @brief Convert a JSON number (not necessarily null terminated), without sscanf/strtod.
+ *
+ * @param p       First character of the number, e.g. val_ptr of a LOJSON_EVT_PRIMITIVE token
+ * @param len     Length of the number
+ * @param pValue  Converted value
+ *
+ * @return 0 if successful, -1 if it is not a JSON number of the expected type, or if the value does not fit.
+ */
+int LO_json_get_int32(const char* p, uint32_t len, int32_t* pValue);
+
+int LO_json_get_uint32(const char* p, uint32_t len, uint32_t* pValue);
+
+int LO_json_get_float(const char* p, uint32_t len, float* pValue);
+
+int LO_json_get_double(const char* p, uint32_t len, double* pValue);
+
+/**
+ * @brief Convert a string of hexadecimal digits (upper or lower case, not necessarily null terminated)
+ *        to bytes, e.g. a MD5 digest.
+ *
+ * @param p        First hexadecimal digit
+ * @param len      Number of digits (even)
+ * @param buf_ptr  Buffer to receive the bytes
+ * @param buf_sz   Size of this buffer
+ *
+ * @return Number of bytes, or -1 if a character is not an hexadecimal digit or if the buffer is too small.
+ */
+int LO_hex_decode(const char* p, uint32_t len, uint8_t* buf_ptr, uint32_t buf_sz);
+
+/**
+ * @brief Write bytes as a null terminated string of lower case hexadecimal digits.
+ *
+ * @param buf_ptr  Buffer to receive the string
+ * @param buf_sz   Size of this buffer: at least 2*len+1, or 3*len with a separator
+ * @param data     Bytes to write
+ * @param len      Number of bytes
+ * @param sep      Character written between two bytes (0: none)
+ *
+ * @return Length of the string, or -1 if the buffer is too small.
+ */
+int LO_hex_encode(char* buf_ptr, uint32_t buf_sz, const uint8_t* data, uint32_t len, char sep);
 
 #if defined(__cplusplus)
 }
@@ -20,6 +20,10 @@
 
 #include "loc_md5.h"
 
+#if (LOM_SETOFDATA_FILTER_NB > 0) || (LOM_SETOFDATA_AGGR_NB > 0)
+#include "paho-mqttclient-embedded-c/timer_interface.h"
+#endif
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -28,6 +32,10 @@ extern "C" {
 #define LOM_PUSH_FLAG         1
 #endif
 
+#if (LOM_SETOFDATA_RBE_NB > 0) || (LOM_SETOFDATA_FILTER_NB > 0) || (LOM_SETOFDATA_AGGR_NB > 0)
+#define LOM_SETOFDATA_CHECK   1
+#endif
+
 /**
  * @brief Define an array of simple LiveObjects data elements
  */
@@ -54,6 +62,40 @@ typedef struct {
 #endif
 } LOMSetOfStatus_t;
 
+#if (LOM_SETOFDATA_FILTER_NB > 0)
+/**
+ * @brief Define the publish filter of a numeric data item (deadband and min/max publish interval)
+ */
+typedef struct {
+	uint8_t  used;           /*!< Filter is set */
+	uint8_t  item;           /*!< Index of the data item in the data set */
+	uint8_t  percent;        /*!< deadband is a percentage of the last published value */
+	uint8_t  valid;          /*!< last_value is set, i.e. the data item has been published */
+	float    deadband;       /*!< The data item is published when its value changes by more than deadband */
+	uint32_t min_ms;         /*!< Minimal interval between two publishes of a changed value (0: none) */
+	uint32_t max_ms;         /*!< Maximal interval between two publishes, even if unchanged (0: none) */
+	Timer    tmr_min;        /*!< Expires min_ms after the last publish */
+	Timer    tmr_max;        /*!< Expires max_ms after the last publish */
+	double   last_value;     /*!< Last published value */
+} LOMDataFilter_t;
+#endif
+
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+/**
+ * @brief Define the aggregation window of a numeric data item, updated at each sample
+ */
+typedef struct {
+	uint8_t  used;           /*!< Aggregation is set */
+	uint8_t  item;           /*!< Index of the data item in the data set */
+	uint8_t  fields;         /*!< Published summary fields (LOD_AGGR_xxx) */
+	uint32_t count;          /*!< Number of samples in the current window */
+	double   min;            /*!< Minimum sampled value */
+	double   max;            /*!< Maximum sampled value */
+	double   mean;           /*!< Running mean of the sampled values */
+	double   last;           /*!< Last sampled value */
+} LOMDataAggr_t;
+#endif
+
 /**
  * @brief Define a set of user data to be published to the LOM server
  *        in a same stream flow (and also in the same time)
@@ -74,8 +116,56 @@ typedef struct {
 #if LOM_PUSH_FLAG
 	uint8_t pushtoLOServer; /*!< flag to forward 'collected data' to the LiveObject Server */
 #endif
+#if (LOM_SETOFDATA_SKEL_SZ > 0)
+	uint16_t skel_head_len; /*!< Length of the pre-rendered head {"s":..,"m":.., (0: no skeleton) */
+	uint16_t skel_tail_len; /*!< Length of the pre-rendered tail "t":[..], */
+	char skel[LOM_SETOFDATA_SKEL_SZ]; /*!< Pre-rendered head, tail, then each "name": key preceded by its length */
+#endif
+#if (LOM_SETOFDATA_RBE_NB > 0)
+	uint8_t  rbe_enabled;    /*!< Report-by-exception: publish only the data items changed since the last publish */
+	uint8_t  rbe_valid;      /*!< rbe_hash is set, i.e. a first full snapshot has been encoded */
+	uint16_t rbe_full_every; /*!< Publish a full snapshot every N push requests (0: only the first one) */
+	uint16_t rbe_push_cnt;   /*!< Number of push requests since the last full snapshot */
+	uint8_t  rbe_dirty[(LOM_SETOFDATA_RBE_NB + 7) / 8]; /*!< Bit per data item: to be published */
+	uint32_t rbe_hash[LOM_SETOFDATA_RBE_NB];            /*!< Hash of the last encoded value of each data item */
+#endif
+#if (LOM_SETOFDATA_FILTER_NB > 0)
+	uint8_t  filter_nb;      /*!< Number of filters set */
+	LOMDataFilter_t filter[LOM_SETOFDATA_FILTER_NB]; /*!< Publish filters of numeric data items */
+#endif
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+	uint8_t  aggr_nb;        /*!< Number of aggregated data items */
+	uint8_t  aggr_started;   /*!< A window is started, i.e. at least one sample since the last publish */
+	uint32_t aggr_window_ms; /*!< Duration of a window (0: the window ends at each push request) */
+	Timer    aggr_tmr;       /*!< Expires at the end of the current window */
+	LOMDataAggr_t aggr[LOM_SETOFDATA_AGGR_NB]; /*!< Aggregation windows of numeric data items */
+#endif
 } LOMSetOfData_t;
 
+#if (LOM_NAME_INDEX_SZ > 256) || (LOM_NAME_INDEX_SZ & (LOM_NAME_INDEX_SZ - 1))
+#error "LOM_NAME_INDEX_SZ must be a power of 2, max 256"
+#endif
+
+/**
+ * @brief One slot of a name index
+ */
+typedef struct {
+	uint8_t item;            /*!< Index of the named element + 1 (0: free slot) */
+	uint8_t tag;             /*!< 8 most significant bits of the name hash */
+	uint8_t len;             /*!< Length of the name */
+} LOMNameSlot_t;
+
+/**
+ * @brief Hash index on the names of an array of user elements (commands, resources, ...), built when the array
+ *        is attached. Open addressing with linear probing, at most half full.
+ */
+typedef struct {
+	uint16_t slot_nb;                       /*!< Number of slots (0: no index, the names are searched one by one) */
+#if (LOM_NAME_INDEX_SZ > 0)
+	LOMNameSlot_t slot[LOM_NAME_INDEX_SZ];  /*!< Slots */
+#endif
+} LOMNameIndex_t;
+
 /**
  * @brief Define the full set of user configuration parameters to be published to the LOM server
  *
@@ -83,6 +173,8 @@ typedef struct {
 typedef struct {
 	LOMArrayOfParams_t param_set;                 /*!< Array of configuration parameters */
 	LiveObjectsD_CallbackParams_t param_callback; /*!< User callback function, called when parameter is updated */
+	LiveObjectsD_CallbackParamsBatch_t param_batch_callback; /*!< Or, called once per batch of updated parameters */
+	LOMNameIndex_t param_index;                   /*!< Index of the parameter names */
 #if LOM_PUSH_FLAG
 	uint8_t pushtoLOServer;                       /*!< flag to publish 'config parameter' to the LiveObject Server */
 #endif
@@ -94,7 +186,7 @@ typedef struct {
  */
 typedef struct {
 	int32_t cid;                      /*!< Correlation Identigfier */
-	int32_t nb_of_params;             /*!< Number of elements in tab_of_param_ptr */
+	int32_t nb_of_params;             /*!< Number of updated parameters, only the first ones are in tab_of_param_ptr */
 	const LiveObjectsD_Param_t* tab_of_param_ptr[LOC_MAX_OF_PARSED_PARAMS]; /*!< array of configuration parameters */
 } LOMSetofUpdatedParams_t;
 
@@ -107,6 +199,7 @@ typedef struct {
 	const LiveObjectsD_Command_t* cmd_ptr;         /*!< Address of the first LiveObjects command element in array */
 	int cmd_nb;                                    /*!< Number of elements in array */
 	LiveObjectsD_CallbackCommand_t cmd_callback;   /*!< User callback function called to process the received command */
+	LOMNameIndex_t cmd_index;                      /*!< Index on the command names */
 } LOMSetofCommands_t;
 
 /**
@@ -119,6 +212,7 @@ typedef struct {
 	int rsc_nb;                                        /*!< Number of elements in array */
 	LiveObjectsD_CallbackResourceNotify_t rsc_cb_ntfy; /*!< User callback function called to notify begin/end of transfer */
 	LiveObjectsD_CallbackResourceData_t rsc_cb_data;   /*!< User callback function called to notify that data can be read */
+	LOMNameIndex_t rsc_index;                          /*!< Index on the resource names */
 //LOM_PUSH_FLAG
 	uint8_t pushtoLOServer;
 } LOMSetOfResources_t;
@@ -145,10 +239,76 @@ typedef struct {
 
 } LOMSetOfUpdatedResource_t;
 
+#if LOM_ENCODE_IN_MQTT_BUF
+/**
+ * @brief Set the buffer used to encode the messages sent by the LiveObjects Client thread (from = 0),
+ *        i.e. the payload area of the MQTT send buffer.
+ */
+void LO_msg_encode_set_buffer(char* buf_ptr, uint32_t buf_sz);
+#endif
+
 const char* LO_msg_encode_status(uint8_t from, const LOMArrayOfData_t* p);
 
 const char* LO_msg_encode_data(uint8_t from, const LOMSetOfData_t* p);
 
+/**
+ * @brief Pre-render the constant parts of the JSON message of a data set.
+ *        To be called each time the stream id, model, tags or data set are changed.
+ *
+ * @return 0 if successful, -1 if the skeleton is not used (the full message is then encoded at each push)
+ */
+int LO_msg_encode_data_skeleton(LOMSetOfData_t* p);
+
+#if LOM_SETOFDATA_CHECK
+/**
+ * @brief Decide which data items have to be published:
+ *        - items with a filter (see LO_msg_data_filter_set) when their value is out of the deadband
+ *          (and min interval elapsed), or when their max interval elapsed,
+ *        - in report-by-exception mode, the aggregated items with samples in the current window, the other items
+ *          when their value changed since the last publish, and all items when a full snapshot is due,
+ *        - otherwise, the items neither filtered nor aggregated, at each push.
+ *        In report-by-exception mode, only these items are encoded by LO_msg_encode_data.
+ *
+ * @return the number of data items to be encoded (0: nothing to publish),
+ *         data_nb if neither filter nor report-by-exception is used.
+ */
+int LO_msg_data_check(LOMSetOfData_t* p);
+
+/**
+ * @brief The message encoded after LO_msg_data_check is published (or queued): update the last published
+ *        values and start new aggregation windows. Otherwise, changed items stay marked and are published
+ *        at the next push.
+ */
+void LO_msg_data_done(LOMSetOfData_t* p);
+#endif
+
+#if (LOM_SETOFDATA_FILTER_NB > 0)
+/**
+ * @brief Set (or remove if deadband < 0) the publish filter of a numeric data item (data_dim = 1).
+ *
+ * @return 0 if successful, otherwise a negative value (invalid item, or no more free filter).
+ */
+int LO_msg_data_filter_set(LOMSetOfData_t* p, int item, float deadband, uint8_t percent,
+		uint32_t min_ms, uint32_t max_ms);
+#endif
+
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+/**
+ * @brief Set (or remove if fields = 0) the aggregation of a numeric data item (data_dim = 1):
+ *        the given summary fields (LOD_AGGR_xxx) are encoded instead of the current value.
+ *
+ * @return 0 if successful, otherwise a negative value (invalid item, or no more free aggregation).
+ */
+int LO_msg_data_aggr_set(LOMSetOfData_t* p, int item, uint8_t fields);
+
+/**
+ * @brief Add the current value of each aggregated data item to the current window.
+ *
+ * @return 1 if the window (aggr_window_ms) is elapsed, i.e. the summary has to be published, otherwise 0.
+ */
+int LO_msg_data_aggr_sample(LOMSetOfData_t* p);
+#endif
+
 const char* LO_msg_encode_resources(uint8_t from, const LOMSetOfResources_t* p);
 
 const char* LO_msg_encode_params_all(uint8_t from, const LOMArrayOfParams_t* p, int32_t cid);
@@ -161,6 +321,26 @@ const char* LO_msg_encode_params_update(const LOMSetofUpdatedParams_t* p);
 
 const char* LO_msg_encode_cmd_result(int32_t cid, int result);
 
+/**
+ * @brief Build the name index of an array of user elements (no index if LOM_NAME_INDEX_SZ is too small).
+ *
+ * @param pIdx         Name index
+ * @param items        Address of the first element of the array
+ * @param item_nb      Number of elements
+ * @param item_sz      Size of one element
+ * @param name_offset  Offset of the name pointer in one element
+ */
+void LO_msg_name_index_build(LOMNameIndex_t* pIdx, const void* items, int item_nb, uint32_t item_sz,
+		uint32_t name_offset);
+
+/**
+ * @brief Find an element of an array of user elements by its name, using the name index if it is built.
+ *
+ * @return the position of the element in the array, or -1 if not found
+ */
+int LO_msg_name_find(const LOMNameIndex_t* pIdx, const void* items, int item_nb, uint32_t item_sz, uint32_t name_offset,
+		const char* name, uint32_t len);
+
 LiveObjectsD_ResourceRespCode_t LO_msg_decode_rsc_req(const char* payload_data, uint32_t payload_len,
 		const LOMSetOfResources_t* p, LOMSetOfUpdatedResource_t* r, int32_t* cid);
 
@@ -173,6 +353,61 @@ int LO_msg_decode_params_req(const char* payload_data, uint32_t payload_len, con
 
 int LO_msg_decode_cmd_req(const char* payload_data, uint32_t payload_len, const LOMSetofCommands_t* p, int32_t* pCid);
 
+#if LOC_MQTT_RCV_CHUNKED
+/**
+ * @brief Decode a configuration update request received in pieces (payload larger than the MQTT receive buffer).
+ *
+ * The pieces are given in order. The bytes not consumed must be given again, followed by the next received bytes,
+ * at the beginning of the next piece (see LO_json_parse_part).
+ *
+ * @param data       Piece of the payload
+ * @param len        Length of the piece
+ * @param offset     Offset of the piece in the payload (0: first piece)
+ * @param last       1 if the piece ends the payload
+ * @param p          Set of configuration parameters
+ * @param r          Updated parameters
+ * @param pConsumed  Number of bytes consumed in the piece
+ *
+ * @return 0 while the request is not complete, otherwise the result of LO_msg_decode_params_req
+ *         (always negative before the last piece).
+ */
+int LO_msg_decode_params_part(const char* data, uint32_t len, uint32_t offset, uint8_t last,
+		const LOMSetOfParams_t* p, LOMSetofUpdatedParams_t* r, uint32_t* pConsumed);
+
+/**
+ * @brief Decode a command request received in pieces, as LO_msg_decode_params_part.
+ *
+ * @return 0 while the request is not complete, otherwise the result of LO_msg_decode_cmd_req
+ *         (always negative before the last piece).
+ */
+int LO_msg_decode_cmd_part(const char* data, uint32_t len, uint32_t offset, uint8_t last,
+		const LOMSetofCommands_t* p, int32_t* pCid, uint32_t* pConsumed);
+#endif
+
+/**
+ * @brief Hold the command block kept for the delayed response of a command,
+ *        while the response is encoded: it is not released when the client is (re)connected.
+ *
+ * @param cid  Correlation Identifier of the command
+ *
+ * @return 0 if successful, -1 if there is no block for this command.
+ */
+int LO_msg_cmd_blk_hold(int32_t cid);
+
+/**
+ * @brief Release the command block kept for the delayed response of a command
+ *
+ * @param cid  Correlation Identifier of the command
+ *
+ * @return 0 if successful, -1 if there is no block for this command.
+ */
+int LO_msg_cmd_blk_release(int32_t cid);
+
+/**
+ * @brief Release all command blocks kept for a delayed response (when the client is (re)connected)
+ */
+void LO_msg_cmd_blk_reset(void);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -12,15 +12,15 @@
 
 #include "loc_msg.h"
 #include "loc_json_api.h"
+#include "loc_sys.h"
 
 #ifndef TRACE_GROUP
 #define TRACE_GROUP "JMSG"
 #endif
 #include "liveobjects-sys/loc_trace.h"
 
-#include "jsmn/jsmn.h"
-
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -32,114 +32,125 @@
 
 #define MSG_DBG       2
 #define MSG_DUMP      1
-#define SANITY_CHECK  0
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-static const char* conv_jsmntypeToString(jsmntype_t jtype) {
-	switch (jtype) {
-	case JSMN_UNDEFINED:
-		return "JSMN_UNDEFINED";
-	case JSMN_OBJECT:
-		return "JSMN_OBJECT";
-	case JSMN_ARRAY:
-		return "JSMN_ARRAY";
-	case JSMN_STRING:
-		return "JSMN_STRING";
-	case JSMN_PRIMITIVE:
-		return "JSMN_PRIMITIVE";
-	}
-	return "JSMN_BAD_TYPE";
+static int isName(const LOJsonToken_t* tk, const char* name, uint32_t len) {
+	return ((tk->name_ptr) && (tk->name_len == len) && !memcmp(tk->name_ptr, name, len));
 }
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-#ifdef SUPPORT_CMD_ARGS
-static jsmntype_t conv_objTypeTojsmntype(LOMObjType_t objType)
-{
-	switch (objType) {
-		case LOD_TYPE_INT32:
-		case LOD_TYPE_INT16:
-		case LOD_TYPE_INT8:
-
-		case LOD_TYPE_UINT32:
-		case LOD_TYPE_UINT16:
-		case LOD_TYPE_UINT8:
-
-		case LOD_TYPE_FLOAT:
-		case LOD_TYPE_DOUBLE:
-		case LOD_TYPE_BOOL:
-		return JSMN_PRIMITIVE;
-
-		case LOD_TYPE_STRING_C:
-		return JSMN_STRING;
-
-		case LOD_TYPE_UNKNOWN:
-		case LOD_TYPE_MAX_NOT_USED:
-		return JSMN_UNDEFINED;
-	}
-	return JSMN_UNDEFINED;
+#if (MSG_DUMP)
+static void dump_json_evt(const char* from, const LOJsonToken_t* tk) {
+	LOTRACE_DBG1("%s: evt=%d depth=%u index=%u [%.*s] [%.*s]", from, tk->evt, tk->depth, tk->index,
+			(int) tk->name_len, (tk->name_ptr) ? tk->name_ptr : "", (int) tk->val_len, tk->val_ptr);
 }
 #endif
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-static int check_token(const char* payload_json, const jsmntok_t* token, const char* name) {
-	if ((payload_json == NULL) || (token == NULL) || (name == NULL) || (*name == 0)) {
-		LOTRACE_ERR("Invalid params - payload=x%p token=x%p name=x%p", payload_json, token, name);
-		return -1;
+static const char* getItemName(const void* items, int item, uint32_t item_sz, uint32_t name_offset) {
+	return *((const char* const *) ((const char*) items + item * item_sz + name_offset));
+}
+
+#if (LOM_NAME_INDEX_SZ > 0)
+/* --------------------------------------------------------------------------------- */
+/* FNV-1a hash of a name */
+static uint32_t getNameHash(const char* name, uint32_t len) {
+	uint32_t h = 2166136261UL;
+	while (len--) {
+		h ^= (uint8_t) *name++;
+		h *= 16777619UL;
 	}
-	if (token->type == JSMN_STRING) {
-#if (SANITY_CHECK)
-		int len = strlen(payload_json);
-		if ((token->start > token->end) || (token->end >= len)) {
-			LOTRACE_ERR("bad token - start=%d end=%d len=%d", token->start, token->end, len);
-			return -1;
-		}
+	return h;
+}
 #endif
-		unsigned int tk_len = token->end - token->start;
-		const char* tk_ptr = payload_json + token->start;
-		if ((tk_len == strlen(name)) && !strncmp(tk_ptr, name, tk_len)) {
-			LOTRACE_DBG1("found %.*s", tk_len, tk_ptr);
-			return 1;
-		}
-		LOTRACE_ERR("%s not found - token is %.*s", name, tk_len, tk_ptr);
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void LO_msg_name_index_build(LOMNameIndex_t* pIdx, const void* items, int item_nb, uint32_t item_sz,
+		uint32_t name_offset) {
+	pIdx->slot_nb = 0;
+#if (LOM_NAME_INDEX_SZ > 0)
+	int i;
+	memset(pIdx->slot, 0, sizeof(pIdx->slot));
+	if ((items == NULL) || (item_nb <= 0)) {
+		return;
 	}
-	else {
-		LOTRACE_ERR("token type (%d %s) is not JSMN_STRING", token->type,
-				conv_jsmntypeToString(token->type));
+	if (item_nb > (LOM_NAME_INDEX_SZ / 2)) {
+		LOTRACE_NOTICE("%d names, over the index capacity (%u): search one by one", item_nb, LOM_NAME_INDEX_SZ / 2);
+		return;
 	}
-	return 0;
+	for (i = 0; i < item_nb; i++) {
+		const char* name = getItemName(items, i, item_sz, name_offset);
+		uint32_t len = (name) ? strlen(name) : 0;
+		uint32_t h;
+		uint32_t s;
+		if ((name == NULL) || (len > 255)) {
+			LOTRACE_NOTICE("[%d] no name, or too long: search one by one", i);
+			memset(pIdx->slot, 0, sizeof(pIdx->slot));
+			return;
+		}
+		h = getNameHash(name, len);
+		s = h & (LOM_NAME_INDEX_SZ - 1);
+		while (pIdx->slot[s].item) {
+			s = (s + 1) & (LOM_NAME_INDEX_SZ - 1);
+		}
+		pIdx->slot[s].item = (uint8_t) (i + 1);
+		pIdx->slot[s].tag = (uint8_t) (h >> 24);
+		pIdx->slot[s].len = (uint8_t) len;
+	}
+	pIdx->slot_nb = LOM_NAME_INDEX_SZ;
+#else
+	(void) items;
+	(void) item_nb;
+	(void) item_sz;
+	(void) name_offset;
+#endif
 }
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-static int isValidTokenPrimitive(const char* from, const char* payload_json, const jsmntok_t* token) {
-	if ((payload_json == NULL) || (token == NULL)) {
-		LOTRACE_ERR("%s: Invalid params - payload=x%p token=x%p", from, payload_json, token);
+int LO_msg_name_find(const LOMNameIndex_t* pIdx, const void* items, int item_nb, uint32_t item_sz,
+		uint32_t name_offset, const char* name, uint32_t len) {
+	int i;
+	if ((items == NULL) || (name == NULL)) {
 		return -1;
 	}
-#if (SANITY_CHECK)
-	int len = strlen(payload_json);
-	if ((token->start > token->end) || (token->end >= len)) {
-		LOTRACE_ERR("%s: Bad token - start=%d end=%d len=%d", from, token->start, token->end, len);
+#if (LOM_NAME_INDEX_SZ > 0)
+	if ((pIdx) && (pIdx->slot_nb)) {
+		uint32_t h = getNameHash(name, len);
+		uint32_t s = h & (LOM_NAME_INDEX_SZ - 1);
+		/* at most half full: there is always a free slot to end the probing */
+		while (pIdx->slot[s].item) {
+			if ((pIdx->slot[s].tag == (uint8_t) (h >> 24)) && (pIdx->slot[s].len == len)
+					&& !memcmp(getItemName(items, pIdx->slot[s].item - 1, item_sz, name_offset), name, len)) {
+				return pIdx->slot[s].item - 1;
+			}
+			s = (s + 1) & (LOM_NAME_INDEX_SZ - 1);
+		}
 		return -1;
 	}
+#else
+	(void) pIdx;
 #endif
-	if (token->type != JSMN_PRIMITIVE) {
-		LOTRACE_WARN("%s: Unexpected type %d != %d", from, token->type, JSMN_PRIMITIVE);
-		return -1;
+	for (i = 0; i < item_nb; i++) {
+		const char* item_name = getItemName(items, i, item_sz, name_offset);
+		if ((item_name) && (len == strlen(item_name)) && !strncmp(item_name, name, len)) {
+			return i;
+		}
 	}
-	return 0;
+	return -1;
 }
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-static int getValueINT32(int32_t* value, const char* payload_json, const jsmntok_t* token) {
-	if (isValidTokenPrimitive("getValueINT32", payload_json, token)) {
+static int getValueINT32(int32_t* value, const char* val_ptr, uint32_t val_len) {
+	if ((val_ptr == NULL) || (val_len == 0)) {
 		return -1;
 	}
-	if (1 != sscanf(payload_json + token->start, "%" SCNi32, value)) {
+	if (LO_json_get_int32(val_ptr, val_len, value)) {
 		LOTRACE_WARN("%s: Bad token value.", "getValueINT32");
 		return -1;
 	}
@@ -147,29 +158,33 @@ static int getValueINT32(int32_t* value, const char* payload_json, const jsmntok
 }
 
 #ifdef SUPPORT_CMD_ARGS
-static int getValueINT16(int16_t* value, const char* payload_json, const jsmntok_t* token) {
-	if (isValidTokenPrimitive("getValueINT16", payload_json, token)) return -1;
-	if (1 != sscanf(payload_json + token->start, "%" SCNi16, value)) {
+static int getValueINT16(int16_t* value, const char* val_ptr, uint32_t val_len) {
+	int32_t v;
+	if ((val_ptr == NULL) || (val_len == 0)) return -1;
+	if (LO_json_get_int32(val_ptr, val_len, &v) || (v < INT16_MIN) || (v > INT16_MAX)) {
 		LOTRACE_WARN("%s: Bad token value.", "getValueINT16");
 		return -1;
 	}
+	*value = (int16_t) v;
 	return 0;
 }
 
-static int getValueINT8(int8_t* value, const char* payload_json, const jsmntok_t* token) {
-	if (isValidTokenPrimitive("getValueINT8", payload_json, token)) return -1;
-	if (1 != sscanf(payload_json + token->start, "%" SCNi8, value)) {
+static int getValueINT8(int8_t* value, const char* val_ptr, uint32_t val_len) {
+	int32_t v;
+	if ((val_ptr == NULL) || (val_len == 0)) return -1;
+	if (LO_json_get_int32(val_ptr, val_len, &v) || (v < INT8_MIN) || (v > INT8_MAX)) {
 		LOTRACE_WARN("%s: Bad token value.", "getValueINT8");
 		return -1;
 	}
+	*value = (int8_t) v;
 	return 0;
 }
 #endif
 
-static int getValueUINT32(uint32_t* value, const char* payload_json, const jsmntok_t* token) {
-	if (isValidTokenPrimitive("getValueUINT32", payload_json, token))
+static int getValueUINT32(uint32_t* value, const char* val_ptr, uint32_t val_len) {
+	if ((val_ptr == NULL) || (val_len == 0))
 		return -1;
-	if (1 != sscanf(payload_json + token->start, "%" SCNu32, value)) {
+	if (LO_json_get_uint32(val_ptr, val_len, value)) {
 		LOTRACE_WARN("%s: Bad token value.", "getValueUINT32");
 		return -1;
 	}
@@ -177,217 +192,314 @@ static int getValueUINT32(uint32_t* value, const char* payload_json, const jsmnt
 }
 
 #ifdef SUPPORT_CMD_ARGS
-static int getValueUINT16(uint16_t* value, const char* payload_json, const jsmntok_t* token) {
-	if (isValidTokenPrimitive("getValueUINT16", payload_json, token)) return -1;
-	if (1 != sscanf(payload_json + token->start, "%" SCNu16, value)) {
+static int getValueUINT16(uint16_t* value, const char* val_ptr, uint32_t val_len) {
+	uint32_t v;
+	if ((val_ptr == NULL) || (val_len == 0)) return -1;
+	if (LO_json_get_uint32(val_ptr, val_len, &v) || (v > UINT16_MAX)) {
 		LOTRACE_WARN("%s: Bad token value.", "getValueUINT16");
 		return -1;
 	}
+	*value = (uint16_t) v;
 	return 0;
 }
 
-static int getValueUINT8(uint8_t* value, const char* payload_json, const jsmntok_t* token) {
-	if (isValidTokenPrimitive("getValueUINT8", payload_json, token)) return -1;
-	if (1 != sscanf(payload_json + token->start, "%" SCNu8, value)) {
+static int getValueUINT8(uint8_t* value, const char* val_ptr, uint32_t val_len) {
+	uint32_t v;
+	if ((val_ptr == NULL) || (val_len == 0)) return -1;
+	if (LO_json_get_uint32(val_ptr, val_len, &v) || (v > UINT8_MAX)) {
 		LOTRACE_WARN("%s: Bad token value.", "getValueUINT8");
 		return -1;
 	}
+	*value = (uint8_t) v;
 	return 0;
 }
 #endif
 
-static int getValueFLOAT(float* value, const char* payload_json, const jsmntok_t* token) {
-	if (isValidTokenPrimitive("getValueFLOAT", payload_json, token)) {
+static int getValueFLOAT(float* value, const char* val_ptr, uint32_t val_len) {
+	if ((val_ptr == NULL) || (val_len == 0)) {
 		return -1;
 	}
-#ifdef ARDUINO
-	double df;
-	df = atof(payload_json + token->start);
-	*value = df;
-#else
-	if (1 != sscanf(payload_json + token->start, "%f", value)) {
+	if (LO_json_get_float(val_ptr, val_len, value)) {
 		LOTRACE_WARN("%s: Bad token value.", "getValueFLOAT");
 		return -1;
 	}
-#endif
 	return 0;
 }
 
-static int getValueDOUBLE(double* value, const char* payload_json, const jsmntok_t* token) {
-	if (isValidTokenPrimitive("getValueDOUBLE", payload_json, token)) {
+static int getValueDOUBLE(double* value, const char* val_ptr, uint32_t val_len) {
+	if ((val_ptr == NULL) || (val_len == 0)) {
 		return -1;
 	}
-#ifdef ARDUINO
-	*value = atof(payload_json + token->start);
-#else
-	if (1 != sscanf(payload_json + token->start, "%lf", value)) {
+	if (LO_json_get_double(val_ptr, val_len, value)) {
 		LOTRACE_WARN("%s: Bad token value.", "getValueDOUBLE");
 		return -1;
 	}
-#endif
 	return 0;
+}
 
+/* --------------------------------------------------------------------------------- */
+/* Get the Correlation Id, value of a "cid" member. Must be a primitive value (implicit, it is an integer) */
+static int get_CorrelationId(int32_t* pCid, const LOJsonToken_t* tk) {
+	if (tk->evt != LOJSON_EVT_PRIMITIVE) {
+		LOTRACE_NOTICE("Unexpected VALUE for cid - evt=%d depth=%u", tk->evt, tk->depth);
+		return -1;
+	}
+	LOTRACE_DBG1("FOUND cid %.*s", (int) tk->val_len, tk->val_ptr);
+	return getValueINT32(pCid, tk->val_ptr, tk->val_len);
 }
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-static int get_CorrelationId(int32_t* pCid, const char* payload_data, const jsmntok_t* tokens, int32_t token_cnt) {
-	int idx;
-	if ((payload_data == NULL) || (tokens == NULL) || (pCid == NULL)) {
-		LOTRACE_ERR("Invalid params - payload=x%p tokens=x%p pCid=x%p", payload_data, tokens, pCid);
+#if LOC_FEATURE_LO_PARAMS
+
+/* Numeric value of a configuration parameter */
+typedef union {
+	uint32_t u32;
+	int32_t  i32;
+	float    f32;
+	double   f64;
+} LOMCfgNum_t;
+
+/* --------------------------------------------------------------------------------- */
+/* Convert the received value of the configuration parameter pUpd->param_ptr.
+ * The numeric value is stored in pNum. Return 0 if there is a value to update.
+ */
+static int getCnfValue(LiveObjectsD_ParamUpdate_t* pUpd, LOMCfgNum_t* pNum, const char* val_ptr, uint32_t val_len,
+		uint8_t val_str) {
+	int ret;
+	const LiveObjectsD_Param_t* param_ptr = pUpd->param_ptr;
+	if ((val_ptr == NULL) || (param_ptr == NULL)) {
+		LOTRACE_ERR("Invalid params - val_ptr=x%p param_ptr=x%p", val_ptr, param_ptr);
 		return -1;
 	}
 
-	if (token_cnt < 2) {
-		LOTRACE_ERR("require at least 2 tokens (cnt=%"PRIi32")", token_cnt);
+	if (param_ptr->parm_data.data_type == LOD_TYPE_STRING_C) {
+		if (!val_str) {
+			LOTRACE_ERR("(%s): bad value type, STRING expected", param_ptr->parm_data.data_name);
+			return -1;
+		}
+		pUpd->val_ptr = (const void*) val_ptr;
+		pUpd->val_len = val_len;
+		return 0;
+	}
+
+	if (val_str) {
+		LOTRACE_ERR("(%s): bad value type, PRIMITIVE expected", param_ptr->parm_data.data_name);
 		return -1;
 	}
-	token_cnt--;
-	for (idx = 0; idx < token_cnt; idx++) {
-#if (MSG_DBG > 3)
-		LOTRACE_DBG1("TK[%d] type=%d %s size=%d start=%d end=%d (len=%d)",
-				idx, tokens[idx].type, conv_jsmntypeToString(tokens[idx].type), tokens[idx].size,
-				tokens[idx].start, tokens[idx].end, tokens[idx].end - tokens[idx].start);
-#endif
-		if ((tokens[idx].type == JSMN_STRING) && (tokens[idx].size == 1) && (3 == (tokens[idx].end - tokens[idx].start))
-				&& (!strncmp("cid", payload_data + tokens[idx].start, 3))) {
 
-			LOTRACE_DBG1("FOUND at TK[%d]", idx);
+	pUpd->val_ptr = (const void*) pNum;
+	if (param_ptr->parm_data.data_type == LOD_TYPE_UINT32) {
+		ret = getValueUINT32(&pNum->u32, val_ptr, val_len);
+		pUpd->val_len = sizeof(uint32_t);
+	}
+	else if (param_ptr->parm_data.data_type == LOD_TYPE_INT32) {
+		ret = getValueINT32(&pNum->i32, val_ptr, val_len);
+		pUpd->val_len = sizeof(int32_t);
+	}
+	else if (param_ptr->parm_data.data_type == LOD_TYPE_FLOAT) {
+		ret = getValueFLOAT(&pNum->f32, val_ptr, val_len);
+		pUpd->val_len = sizeof(float);
+	}
+	else if (param_ptr->parm_data.data_type == LOD_TYPE_DOUBLE) {
+		ret = getValueDOUBLE(&pNum->f64, val_ptr, val_len);
+		pUpd->val_len = sizeof(double);
+	}
+	else {
+		LOTRACE_ERR("(%s): unsupported type %d ", param_ptr->parm_data.data_name, param_ptr->parm_data.data_type);
+		return -1;
+	}
+	if ((ret == 0) && (param_ptr->parm_data.data_value == NULL)) {
+		/* nothing to update */
+		return 1;
+	}
+	return ret;
+}
 
-			// Get next. Must be a primitive value (implicit, it is an integer)
-			idx++;
-			if ((tokens[idx].type == JSMN_PRIMITIVE) && (tokens[idx].size == 0)) {
-				int ret = getValueINT32(pCid, payload_data, &tokens[idx]);
-				return ret;
-			}
-			LOTRACE_NOTICE("Unexpected VALUE token TK[%d] type=%d %s size=%d", idx, tokens[idx].type,
-					conv_jsmntypeToString(tokens[idx].type), tokens[idx].size);
-			return -1;
-		}
+/* --------------------------------------------------------------------------------- */
+/* Store a value accepted by user (a string value is stored by the user callback) */
+static void setCnfValue(const LiveObjectsD_ParamUpdate_t* pUpd) {
+	if (pUpd->param_ptr->parm_data.data_type != LOD_TYPE_STRING_C) {
+		memcpy(pUpd->param_ptr->parm_data.data_value, pUpd->val_ptr, pUpd->val_len);
 	}
-	return -1;
 }
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-#if LOC_FEATURE_LO_PARAMS
-static int updateCnfParam(const char* payload_json, const jsmntok_t* token, const LiveObjectsD_Param_t* param_ptr,
+static int updateCnfParam(const char* val_ptr, uint32_t val_len, uint8_t val_str, const LiveObjectsD_Param_t* param_ptr,
 		LiveObjectsD_CallbackParams_t cfgCB) {
 	int ret;
-	if ((payload_json == NULL) || (token == NULL) || (param_ptr == NULL)) {
-		LOTRACE_ERR("Invalid params - payload=x%p token=x%p param_ptr=x%p", payload_json, token,
-				param_ptr);
-		return -1;
+	LiveObjectsD_ParamUpdate_t upd;
+	LOMCfgNum_t num;
+
+	upd.param_ptr = param_ptr;
+	ret = getCnfValue(&upd, &num, val_ptr, val_len, val_str);
+	if (ret) {
+		return (ret > 0) ? 0 : ret;
+	}
+	ret = (cfgCB) ? cfgCB(param_ptr, upd.val_ptr, upd.val_len) : 0;
+	if (ret == 0) {
+		setCnfValue(&upd);
 	}
+	return ret;
+}
+#endif /* LOC_FEATURE_LO_PARAMS */
 
-	if (param_ptr->parm_data.data_type == LOD_TYPE_STRING_C) {
-		if (token->type != JSMN_STRING) {
-			LOTRACE_ERR("bad token type  %d != %d (STRING)", token->type, JSMN_STRING);
-			return -1;
-		}
-		ret = cfgCB(param_ptr, (const void*) (payload_json + token->start), token->end - token->start);
+#if LOC_FEATURE_LO_RESOURCES
+
+/* --------------------------------------------------------------------------------- */
+/* State of the resource request decoder (see LO_msg_decode_rsc_req)
+ */
+typedef struct {
+	const LOMSetOfResources_t* pSetRsc;
+	LOMSetOfUpdatedResource_t* pRscUpd;  /* NULL if busy with another resource update */
+	const LiveObjectsD_Resource_t* rsc_ptr;
+	int32_t  cid;
+	int8_t   cid_rc;       /* 1: found, -1: bad value, 0: not found */
+	int8_t   id_rc;        /* 1: found, -1: bad value, 0: not found */
+	uint8_t  root;         /* 1: the root value is an object */
+	uint8_t  in_m;         /* 1: in the metadata section */
+	uint16_t root_nb;      /* number of members of the root object */
+	LiveObjectsD_ResourceRespCode_t err;
+} LOMRscDecode_t;
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void decode_rsc_copy(char* dst, uint32_t dst_len, const LOJsonToken_t* tk) {
+	uint32_t len = tk->val_len;
+	if (len > dst_len) {
+		len = dst_len;
 	}
-	else {
-		if (token->type != JSMN_PRIMITIVE) {
-			LOTRACE_ERR("(%s): bad token type %d != %d (PRIMITIVE) ", param_ptr->parm_data.data_name,
-					token->type, JSMN_PRIMITIVE);
-			return -1;
-		}
+	memcpy(dst, tk->val_ptr, len);
+	dst[len] = 0;
+}
 
-		if (param_ptr->parm_data.data_type == LOD_TYPE_UINT32) {
-			uint32_t value;
-			ret = getValueUINT32(&value, payload_json, token);
-			if ((ret == 0) && (param_ptr->parm_data.data_value)) {
-				ret = cfgCB(param_ptr, (const void*) &value, sizeof(uint32_t));
-				if (ret == 0)
-					*((uint32_t*) param_ptr->parm_data.data_value) = value;
-			}
-		}
-		else if (param_ptr->parm_data.data_type == LOD_TYPE_INT32) {
-			int32_t value;
-			ret = getValueINT32(&value, payload_json, token);
-			if ((ret == 0) && (param_ptr->parm_data.data_value)) {
-				ret = cfgCB(param_ptr, (const void*) &value, sizeof(int32_t));
-				if (ret == 0)
-					*((int32_t*) param_ptr->parm_data.data_value) = value;
-			}
-		}
-		else if (param_ptr->parm_data.data_type == LOD_TYPE_FLOAT) {
-			float value;
-			ret = getValueFLOAT(&value, payload_json, token);
-			if ((ret == 0) && (param_ptr->parm_data.data_value)) {
-				ret = cfgCB(param_ptr, (const void*) &value, sizeof(float));
-				if (ret == 0)
-					*((float*) param_ptr->parm_data.data_value) = value;
-			}
+/* --------------------------------------------------------------------------------- */
+/* One member of the metadata section "m" */
+static void decode_rsc_metadata(LOMRscDecode_t* pDec, const LOJsonToken_t* tk) {
+	LOMSetOfUpdatedResource_t* pRscUpd = pDec->pRscUpd;
+
+	if (tk->evt != LOJSON_EVT_STRING) {
+		LOTRACE_ERR("%.*s - unexpected value in metadata section (evt=%d)", (int) tk->name_len, tk->name_ptr,
+				tk->evt);
+		pDec->err = RSC_RSP_ERR_INTERNAL_ERROR;
+		return;
+	}
+	LOTRACE_DBG1("%.*s - %.*s", (int) tk->name_len, tk->name_ptr, (int) tk->val_len, tk->val_ptr);
+	if (pRscUpd == NULL) {
+		return;
+	}
+
+	if (isName(tk, "size", 4)) {
+		if (getValueUINT32(&pRscUpd->ursc_size, tk->val_ptr, tk->val_len)) {
+			LOTRACE_ERR("size= %.*s , bad value", (int) tk->val_len, tk->val_ptr);
+			pDec->err = RSC_RSP_ERR_INTERNAL_ERROR;
 		}
-		else if (param_ptr->parm_data.data_type == LOD_TYPE_DOUBLE) {
-			double value;
-			ret = getValueDOUBLE(&value, payload_json, token);
-			if ((ret == 0) && (param_ptr->parm_data.data_value)) {
-				ret = cfgCB(param_ptr, (const void*) &value, sizeof(double));
-				if (ret == 0)
-					*((double*) param_ptr->parm_data.data_value) = value;
+	}
+	else if (isName(tk, "uri", 3)) {
+		decode_rsc_copy(pRscUpd->ursc_uri, sizeof(pRscUpd->ursc_uri) - 1, tk);
+	}
+	else if (isName(tk, "md5", 3)) {
+		if (tk->val_len == (sizeof(pRscUpd->ursc_md5) * 2)) {
+			if (LO_hex_decode(tk->val_ptr, tk->val_len, pRscUpd->ursc_md5, sizeof(pRscUpd->ursc_md5)) < 0) {
+				LOTRACE_ERR("md5= %.*s , bad value", (int) tk->val_len, tk->val_ptr);
 			}
 		}
 		else {
-			LOTRACE_ERR("(%s): unsupported type %d ", param_ptr->parm_data.data_name,
-					param_ptr->parm_data.data_type);
-			ret = -1;
+			LOTRACE_ERR("md5= %.*s, bad length %"PRIu32, (int) tk->val_len, tk->val_ptr, tk->val_len);
 		}
 	}
-	return ret;
+	else {
+		LOTRACE_NOTICE("%.*s - unknown field in metadata section", (int) tk->name_len, tk->name_ptr);
+	}
 }
-#endif /* LOC_FEATURE_LO_PARAMS */
 
 /* --------------------------------------------------------------------------------- */
 /*  */
+static int decode_rsc_event(void* ctx, const LOJsonToken_t* tk) {
+	LOMRscDecode_t* pDec = (LOMRscDecode_t*) ctx;
+
 #if (MSG_DUMP)
-static void dump_json_msg(const char* from, const char* payload_data, const jsmntok_t* tokens, int32_t token_cnt) {
-	int idx;
-	int len;
-	LOTRACE_DBG1("%s: %"PRIi32" tokens", from, token_cnt);
-	for (idx = 0; idx < token_cnt; idx++) {
-		len = tokens[idx].end - tokens[idx].start;
-		LOTRACE_DBG1("TK[%d] type=%d %s size=%d start=%d end=%d (len=%d)", idx, tokens[idx].type,
-				conv_jsmntypeToString(tokens[idx].type), tokens[idx].size, tokens[idx].start, tokens[idx].end, len);
-		if (len > 0) {
-			LOTRACE_DBG1("TK[%d]  ---> [%.*s]", idx, len, payload_data + tokens[idx].start);
-		}
-	}
-}
+	dump_json_evt("decode_rsc", tk);
 #endif
 
-#if LOC_FEATURE_LO_RESOURCES
-
-/* --------------------------------------------------------------------------------- */
-/*  */
-static int get_md5FromString(const unsigned char *s, unsigned char *buf_ptr, uint32_t buf_len) {
-	uint32_t i, j, k;
-	if ((s == NULL) || (buf_ptr == NULL) || (buf_len == 0)) {
-		LOTRACE_ERR("Invalid params, s=x%p buf_ptr=x%p buf_len=%"PRIu32, s, buf_ptr, buf_len);
-		return -1;
+	if (tk->depth == 0) {
+		if (tk->evt == LOJSON_EVT_OBJECT_END) {
+			pDec->root_nb = tk->index;
+			return 0;
+		}
+		if (tk->evt != LOJSON_EVT_OBJECT_BEGIN) {
+			LOTRACE_ERR("unexpected root value - evt=%d", tk->evt);
+			return 1;
+		}
+		pDec->root = 1;
+		return 0;
 	}
-	memset(buf_ptr, 0, buf_len);
-	for (i = 0; i < buf_len * 2; i++, s++) {
-		if (*s >= '0' && *s <= '9') {
-			j = *s - '0';
+
+	if (tk->depth == 1) {
+		if ((tk->evt == LOJSON_EVT_OBJECT_END) || (tk->evt == LOJSON_EVT_ARRAY_END)) {
+			if (pDec->in_m) {
+				/* end of the metadata section */
+				if (tk->index < 3) {
+					LOTRACE_ERR("METADATA - %u elements, at least 3 expected", tk->index);
+					pDec->err = RSC_RSP_ERR_INTERNAL_ERROR;
+				}
+				pDec->in_m = 0;
+			}
+		}
+		else if (isName(tk, "m", 1)) {
+			if (tk->evt != LOJSON_EVT_OBJECT_BEGIN) {
+				LOTRACE_ERR("METADATA - unexpected value after \"m\" - evt=%d", tk->evt);
+				pDec->err = RSC_RSP_ERR_INTERNAL_ERROR;
+				return 0;
+			}
+			pDec->in_m = 1;
 		}
-		else if (*s >= 'A' && *s <= 'F') {
-			j = *s - '7';
+		else if ((tk->evt != LOJSON_EVT_STRING) && (tk->evt != LOJSON_EVT_PRIMITIVE)) {
+			LOTRACE_ERR("%.*s - unexpected value in main section (evt=%d)", (int) tk->name_len, tk->name_ptr,
+					tk->evt);
+			pDec->err = RSC_RSP_ERR_INTERNAL_ERROR;
 		}
-		else if (*s >= 'a' && *s <= 'f') {
-			j = *s - 'W';
+		else if (isName(tk, "cid", 3)) {
+			pDec->cid_rc = (get_CorrelationId(&pDec->cid, tk)) ? -1 : 1;
+		}
+		else if (isName(tk, "id", 2)) {
+			int jw;
+			if (tk->evt != LOJSON_EVT_STRING) {
+				LOTRACE_ERR("Unexpected VALUE for id - evt=%d", tk->evt);
+				pDec->id_rc = -1;
+				return 0;
+			}
+			pDec->id_rc = 1;
+			jw = LO_msg_name_find(&pDec->pSetRsc->rsc_index, pDec->pSetRsc->rsc_ptr, pDec->pSetRsc->rsc_nb,
+					sizeof(LiveObjectsD_Resource_t), offsetof(LiveObjectsD_Resource_t, rsc_name), tk->val_ptr,
+					tk->val_len);
+			if (jw >= 0) {
+				LOTRACE_DBG1("Resource %.*s attached", (int) tk->val_len, tk->val_ptr);
+				pDec->rsc_ptr = &pDec->pSetRsc->rsc_ptr[jw];
+			}
+			else
+				LOTRACE_ERR("Resource %.*s unknown", (int) tk->val_len, tk->val_ptr);
+		}
+		else if (isName(tk, "old", 3)) {
+			if (pDec->pRscUpd)
+				decode_rsc_copy(pDec->pRscUpd->ursc_vers_old, sizeof(pDec->pRscUpd->ursc_vers_old) - 1, tk);
+		}
+		else if (isName(tk, "new", 3)) {
+			if (pDec->pRscUpd)
+				decode_rsc_copy(pDec->pRscUpd->ursc_vers_new, sizeof(pDec->pRscUpd->ursc_vers_new) - 1, tk);
 		}
 		else {
-			/* 'a' (97) - 10 = */
-			return -1;
+			LOTRACE_NOTICE("%.*s - unknown field in core section", (int) tk->name_len, tk->name_ptr);
 		}
+		return 0;
+	}
 
-		k = ((i & 1) != 0) ? j : j << 4;
-		buf_ptr[i >> 1] = (unsigned char) (buf_ptr[i >> 1] | k);
+	if ((tk->depth == 2) && (pDec->in_m)) {
+		decode_rsc_metadata(pDec, tk);
 	}
-	return (0);
+	/* deeper values are already reported by the BEGIN event of their container */
+	return 0;
 }
 
 /* --------------------------------------------------------------------------------- */
@@ -399,12 +511,7 @@ LiveObjectsD_ResourceRespCode_t LO_msg_decode_rsc_req(const char* payload_data,
 LiveObjectsD_ResourceRespCode_t LO_msg_decode_rsc_req(const char* payload_data, uint32_t payload_len,
 		const LOMSetOfResources_t* pSetRsc, LOMSetOfUpdatedResource_t* pRscUpd, int32_t* pCid) {
 	int ret;
-	int token_cnt;
-	jsmn_parser parser;
-	jsmntok_t tokens[20];
-	int idx;
-	int len;
-	int size;
+	LOMRscDecode_t dec;
 
 	if ((pSetRsc == NULL) || (payload_data == NULL) || (payload_len == 0) || (pRscUpd == NULL) || (pCid == NULL)) {
 		LOTRACE_ERR("Invalid params, pSetCfg=x%p payload_data=x%p (%"PRIu32")", pSetRsc, payload_data,
@@ -414,248 +521,56 @@ LiveObjectsD_ResourceRespCode_t LO_msg_decode_rsc_req(const char* payload_data,
 
 	*pCid = 0;
 
-	memset(&tokens, 0, sizeof(tokens));
-	jsmn_init(&parser);
-	token_cnt = jsmn_parse(&parser, payload_data, payload_len, tokens, 20);
-	if (token_cnt < 0) {
-		LOTRACE_ERR("ERROR %d returned by jsmn_parse", token_cnt);
-		LOTRACE_ERR("'%s'", payload_data);
+	memset(&dec, 0, sizeof(dec));
+	dec.pSetRsc = pSetRsc;
+	if (pRscUpd->ursc_cid == 0) {
+		/* Not busy: the fields are decoded directly in the resource update block */
+		memset(pRscUpd, 0, sizeof(LOMSetOfUpdatedResource_t));
+		dec.pRscUpd = pRscUpd;
+	}
+
+	ret = LO_json_parse(payload_data, payload_len, decode_rsc_event, &dec);
+	if (ret < 0) {
+		LOTRACE_ERR("ERROR %d returned by LO_json_parse", ret);
+		LOTRACE_ERR("'%.*s'", (int) payload_len, payload_data);
 		return RSC_RSP_ERR_INTERNAL_ERROR;
 	}
-	if (token_cnt == 0) {
+	if ((ret == 0) && (dec.root == 0)) {
 		LOTRACE_ERR("EMPTY !");
 		return RSC_RSP_OK;
 	}
-
-#if (MSG_DUMP)
-	dump_json_msg("decode_rsc", payload_data, tokens, token_cnt);
-#endif
-
-	if (token_cnt < 1) {
-		LOTRACE_ERR("Bad format - token_cnt=%d < 1 too short !", token_cnt);
+	if ((dec.root == 0) || (dec.root_nb == 0)) {
+		LOTRACE_ERR("unexpected first value - root=%u nb=%u", dec.root, dec.root_nb);
 		return RSC_RSP_ERR_INTERNAL_ERROR;
 	}
 
-	if ((tokens[0].type != JSMN_OBJECT) || (tokens[0].size <= 0)) {
-		LOTRACE_ERR("unexpected  first token - type=%d size=%d", tokens[0].type, tokens[0].size);
-		return RSC_RSP_ERR_INTERNAL_ERROR;
-	}
-
-	// Get the Correlation Id
-	ret = get_CorrelationId(pCid, payload_data, &tokens[1], token_cnt);
-	if (ret) {
+	if (dec.cid_rc <= 0) {
 		LOTRACE_ERR("Error to get the correlation id");
 		return RSC_RSP_ERR_INTERNAL_ERROR;
 	}
+	*pCid = dec.cid;
 	LOTRACE_DBG1("cid= %"PRIi32, *pCid);
 
-	if (pRscUpd->ursc_cid) {
+	if (dec.pRscUpd == NULL) {
 		LOTRACE_ERR("Error - Busy with cid=%"PRIi32, pRscUpd->ursc_cid);
 		return RSC_RSP_ERR_NOT_AUTHORIZED; // RSC_RSP_ERR_BUSY
 	}
 
-	memset(pRscUpd, 0, sizeof(LOMSetOfUpdatedResource_t));
-
-	pRscUpd->ursc_cid = *pCid;
-
-	// get resource id
-	for (idx = 0; idx < (token_cnt - 1); idx++) {
-		if ((tokens[idx].type == JSMN_STRING) && (tokens[idx].size == 1) && (2 == (tokens[idx].end - tokens[idx].start))
-				&& (!strncmp("id", payload_data + tokens[idx].start, 2))) {
-			int jw;
-			const LiveObjectsD_Resource_t* rsc_ptr;
-
-			LOTRACE_DBG1("TK[%d]: Found JSON TAG %.*s", idx, tokens[idx].end - tokens[idx].start,
-					payload_data + tokens[idx].start);
-
-			// Get next. Must be a string value
-			idx++;
-			if ((tokens[idx].type != JSMN_STRING) || (tokens[idx].size != 0)) {
-				LOTRACE_ERR("Unexpected VALUE token TK[%d] type=%d %s size=%d", idx, tokens[idx].type,
-						conv_jsmntypeToString(tokens[idx].type), tokens[idx].size);
-				return RSC_RSP_ERR_INTERNAL_ERROR;
-			}
-			// found
-			rsc_ptr = pSetRsc->rsc_ptr;
-			len = tokens[idx].end - tokens[idx].start;
-			for (jw = 0; jw < pSetRsc->rsc_nb; jw++, rsc_ptr++) {
-				if ((len == (int) strlen(rsc_ptr->rsc_name))
-						&& (!strncmp(rsc_ptr->rsc_name, payload_data + tokens[idx].start, len))) {
-					LOTRACE_DBG1("Resource %.*s attached", tokens[idx].end - tokens[idx].start,
-							payload_data + tokens[idx].start);
-					pRscUpd->ursc_obj_ptr = rsc_ptr;
-					break;
-				}
-			}
-			if (pRscUpd->ursc_obj_ptr == NULL)
-				LOTRACE_ERR("Resource %.*s unknown", tokens[idx].end - tokens[idx].start,
-						payload_data + tokens[idx].start);
-			break;
-		}
+	if (dec.id_rc < 0) {
+		return RSC_RSP_ERR_INTERNAL_ERROR;
 	}
-	if (pRscUpd->ursc_obj_ptr == NULL) {
-		if (idx == token_cnt)
+	if (dec.rsc_ptr == NULL) {
+		if (dec.id_rc == 0)
 			LOTRACE_NOTICE("Json tag \"id\" not found");
 		return RSC_RSP_ERR_INVALID_RESOURCE;
 	}
-
-	// Now, get each  parameter
-	size = tokens[0].size;
-	idx = 1;
-
-	while ((size > 0) && (token_cnt > 0)) {
-		int8_t val_type;
-		char* val_ptr;
-		int32_t val_len;
-		int len = tokens[idx].end - tokens[idx].start;
-		if ((tokens[idx].type != JSMN_STRING) || (tokens[idx].size != 1)) {
-			// error;
-			LOTRACE_ERR("ERROR TK[%d] type=%d %s size=%d", idx, tokens[idx].type,
-					conv_jsmntypeToString(tokens[idx].type), tokens[idx].size);
-			return RSC_RSP_ERR_INTERNAL_ERROR;
-		}
-		size--;
-
-		if ((len == 1) && !strncmp("m", payload_data + tokens[idx].start, len)) {
-			int ms;
-			if ((tokens[idx + 1].type != JSMN_OBJECT) || (tokens[idx + 1].size < 3)) {
-				LOTRACE_ERR("TK[%d] METADATA - unexpected token after \"m\" - type=%d size=%d", idx + 1,
-						tokens[idx + 1].type, tokens[idx + 1].size);
-				return RSC_RSP_ERR_INTERNAL_ERROR;
-			}
-			ms = tokens[idx + 1].size;
-			LOTRACE_DBG1("TK[%d] --- METADATA - %d elements ...", idx, ms);
-
-			idx += 2;
-			token_cnt -= 2;
-			while (ms > 0) {
-				if ((tokens[idx].type != JSMN_STRING) || (tokens[idx].size != 1)
-						|| (tokens[idx + 1].type != JSMN_STRING) || (tokens[idx + 1].size != 0)) {
-					LOTRACE_ERR("ERROR TK[%d] in metadata section", idx);
-					return RSC_RSP_ERR_INTERNAL_ERROR;
-				}
-				len = tokens[idx].end - tokens[idx].start;
-				ms--;
-				val_type = 0;
-				if ((len == 4) && !strncmp("size", payload_data + tokens[idx].start, len)) {
-					val_type = 3;
-					val_ptr = (char*) &pRscUpd->ursc_size;
-					val_len = 0;
-				}
-				else if ((len == 3) && !strncmp("uri", payload_data + tokens[idx].start, len)) {
-					val_type = 2;
-					val_ptr = pRscUpd->ursc_uri;
-					val_len = sizeof(pRscUpd->ursc_uri) - 1;
-				}
-				else if ((len == 3) && !strncmp("md5", payload_data + tokens[idx].start, len)) {
-					val_type = 4;
-					val_ptr = (char*)pRscUpd->ursc_md5;
-					val_len = sizeof(pRscUpd->ursc_md5);
-				}
-				else {
-					LOTRACE_NOTICE("TK[%d] %.*s - unknown field in metadata section", idx,
-							tokens[idx].end - tokens[idx].start, payload_data + tokens[idx].start);
-				}
-
-				if (val_type) {
-					LOTRACE_DBG1("TK[%d] %.*s - %.*s", idx, tokens[idx].end - tokens[idx].start,
-							payload_data + tokens[idx].start, tokens[idx + 1].end - tokens[idx + 1].start,
-							payload_data + tokens[idx + 1].start);
-					if (val_ptr) {
-						if (val_type == 2) {
-							len = tokens[idx + 1].end - tokens[idx + 1].start;
-							if (len > val_len) {
-								len = val_len;
-							}
-							strncpy(val_ptr, payload_data + tokens[idx + 1].start, len);
-							val_ptr[len] = 0;
-						}
-						else if (val_type == 3) {
-							if (1 != sscanf(payload_data + tokens[idx + 1].start, "%" SCNu32, (uint32_t*) val_ptr)) {
-								LOTRACE_ERR("TK[%d] %.*s , bad value", idx + 1,
-										tokens[idx + 1].end - tokens[idx + 1].start,
-										payload_data + tokens[idx + 1].start);
-								return RSC_RSP_ERR_INTERNAL_ERROR;
-							}
-						}
-						else if (val_type == 4) {
-							if ((tokens[idx + 1].end - tokens[idx + 1].start) == (val_len * 2)) {
-								if (get_md5FromString((const unsigned char*) (payload_data + tokens[idx + 1].start),
-										(unsigned char*) val_ptr, val_len)) {
-									LOTRACE_ERR("TK[%d] md5= %.*s , bad value", idx + 1,
-											tokens[idx + 1].end - tokens[idx + 1].start,
-											payload_data + tokens[idx + 1].start);
-									//return 2;
-								}
-							}
-							else {
-								LOTRACE_ERR("TK[%d] md5= %.*s, bad length %d", idx + 1,
-										tokens[idx + 1].end - tokens[idx + 1].start,
-										payload_data + tokens[idx + 1].start,
-										tokens[idx + 1].end - tokens[idx + 1].start);
-								//return 2;
-							}
-						}
-						else {
-							LOTRACE_ERR("TK[%d] %.*s , bad type", idx + 1,
-									tokens[idx + 1].end - tokens[idx + 1].start, payload_data + tokens[idx + 1].start);
-							return RSC_RSP_ERR_INTERNAL_ERROR;
-						}
-					}
-				}
-				idx += 2;
-				token_cnt -= 2;
-			}
-		}
-		else {
-			if ((tokens[idx].type != JSMN_STRING) || (tokens[idx].size != 1) || (tokens[idx + 1].size != 0)
-					|| ((tokens[idx + 1].type != JSMN_STRING) && (tokens[idx + 1].type != JSMN_PRIMITIVE))) {
-				LOTRACE_ERR("ERROR TK[%d] in main section", idx);
-				return RSC_RSP_ERR_INTERNAL_ERROR;
-			}
-
-			val_type = 0;
-			if ((len == 2) && !strncmp("id", payload_data + tokens[idx].start, len)) {
-				// skip, already processed
-				val_type = 1;
-			}
-			else if ((len == 3) && !strncmp("old", payload_data + tokens[idx].start, len)) {
-				val_type = 2;
-				val_ptr = pRscUpd->ursc_vers_old;
-				val_len = sizeof(pRscUpd->ursc_vers_old) - 1;
-			}
-			else if ((len == 3) && !strncmp("new", payload_data + tokens[idx].start, len)) {
-				val_type = 2;
-				val_ptr = pRscUpd->ursc_vers_new;
-				val_len = sizeof(pRscUpd->ursc_vers_new) - 1;
-			}
-			else if ((len == 3) && !strncmp("cid", payload_data + tokens[idx].start, len)) {
-				// skip, already processed
-				val_type = 1;
-			}
-			else {
-				// error;
-				LOTRACE_NOTICE("TK[%d] %.*s - unknown field in core section", idx,
-						tokens[idx].end - tokens[idx].start, payload_data + tokens[idx].start);
-			}
-			if (val_type) {
-				LOTRACE_DBG1("TK[%d] %.*s - %.*s", idx, tokens[idx].end - tokens[idx].start,
-						payload_data + tokens[idx].start, tokens[idx + 1].end - tokens[idx + 1].start,
-						payload_data + tokens[idx + 1].start);
-				if ((val_type == 2) && (val_ptr)) {
-					int len = tokens[idx + 1].end - tokens[idx + 1].start;
-					if (len > val_len) {
-						len = val_len;
-					}
-					strncpy(val_ptr, payload_data + tokens[idx + 1].start, len);
-					val_ptr[len] = 0;
-				}
-			}
-			idx += 2;
-			token_cnt -= 2;
-		}
+	if (dec.err) {
+		return dec.err;
 	}
 
+	pRscUpd->ursc_cid = *pCid;
+	pRscUpd->ursc_obj_ptr = dec.rsc_ptr;
+
 	if (pSetRsc->rsc_cb_ntfy) { // User callback function
 		LiveObjectsD_ResourceRespCode_t rsc_resp_code;
 		rsc_resp_code = pSetRsc->rsc_cb_ntfy(0, pRscUpd->ursc_obj_ptr, pRscUpd->ursc_vers_old, pRscUpd->ursc_vers_new,
@@ -667,11 +582,11 @@ LiveObjectsD_ResourceRespCode_t LO_msg_decode_rsc_req(const char* payload_data,
 		}
 	}
 
-	LOTRACE_INF("md5= %02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x",
-			pRscUpd->ursc_md5[0], pRscUpd->ursc_md5[1], pRscUpd->ursc_md5[2], pRscUpd->ursc_md5[3],
-			pRscUpd->ursc_md5[4], pRscUpd->ursc_md5[5], pRscUpd->ursc_md5[6], pRscUpd->ursc_md5[7],
-			pRscUpd->ursc_md5[8], pRscUpd->ursc_md5[9], pRscUpd->ursc_md5[10], pRscUpd->ursc_md5[11],
-			pRscUpd->ursc_md5[12], pRscUpd->ursc_md5[13], pRscUpd->ursc_md5[14], pRscUpd->ursc_md5[15]);
+	{
+		char md5_str[sizeof(pRscUpd->ursc_md5) * 2 + 1];
+		LO_hex_encode(md5_str, sizeof(md5_str), pRscUpd->ursc_md5, sizeof(pRscUpd->ursc_md5), 0);
+		LOTRACE_INF("md5= %s", md5_str);
+	}
 
 	pRscUpd->ursc_connected = 0;
 	pRscUpd->ursc_offset = 0;
@@ -684,398 +599,824 @@ LiveObjectsD_ResourceRespCode_t LO_msg_decode_rsc_req(const char* payload_data,
 /* Decode a received JSON message to update configuration parameters
  */
 #if LOC_FEATURE_LO_PARAMS
-int LO_msg_decode_params_req(const char* payload_data, uint32_t payload_len, const LOMSetOfParams_t* pSetCfg,
-		LOMSetofUpdatedParams_t* pSetCfgUpdate) {
-#ifndef LOC_MAX_OF_PARSED_PARAMS
-#warning "LOC_MAX_OF_PARSED_PARAMS not defined -> set to 5"
-#define LOC_MAX_OF_PARSED_PARAMS   5
-#endif
-#define NB_TK_FOR_PARMS    (5+6*LOC_MAX_OF_PARSED_PARAMS+1)  //  6 tokens by parameter
-	int ret;
-	int token_cnt;
-	jsmn_parser parser;
-	jsmntok_t tokens[NB_TK_FOR_PARMS];
-	int idx;
-	int size;
-	const char* pc;
-	int len;
 
-	if ((pSetCfg == NULL) || (payload_data == NULL) || (payload_len == 0) || (pSetCfgUpdate == NULL)) {
-		LOTRACE_ERR("Invalid params, pSetCfg=x%p payload_data=x%p (%"PRIu32") pSetCfgUpdate=x%p",
-				pSetCfg, payload_data, payload_len, pSetCfgUpdate);
-		return -1;
+/* State of the configuration request decoder (see LO_msg_decode_params_req)
+ * Nothing refers to the JSON text after an event, except the string values of the pending batch.
+ */
+typedef struct {
+	const LOMSetOfParams_t* pSetCfg;
+	LOMSetofUpdatedParams_t* pSetCfgUpdate;
+	const LiveObjectsD_Param_t* param_ptr;  /* current parameter (NULL if unknown) */
+	LiveObjectsD_Type_t type;  /* "t" of the current parameter */
+	uint8_t  tv;           /* members of the current parameter: bit 0 "t", bit 1 "v" */
+	int8_t   cid_rc;       /* 1: found, -1: bad value, 0: not found */
+	int8_t   err;          /* first format error */
+	uint8_t  root;         /* 1: the root value is an object */
+	uint8_t  in_cfg;       /* 1: in the "cfg" section */
+	uint8_t  batch_nb;     /* number of pending updates in batch */
+	uint16_t root_nb;      /* number of members of the root object */
+	int32_t  cid;
+	LiveObjectsD_ParamUpdate_t batch[LOC_PARAMS_BATCH_SZ];  /* pending updates (batch callback) */
+	LOMCfgNum_t batch_num[LOC_PARAMS_BATCH_SZ];             /* and their numeric values */
+} LOMCfgDecode_t;
+
+/* --------------------------------------------------------------------------------- */
+/* Give the pending updates to the batch callback, and store them if accepted */
+static void decode_cfg_flush(LOMCfgDecode_t* pDec) {
+	int i;
+	if (pDec->batch_nb == 0) {
+		return;
+	}
+	LOTRACE_DBG1("batch of %u params ...", pDec->batch_nb);
+	if (pDec->pSetCfg->param_batch_callback(pDec->batch, pDec->batch_nb)) {
+		LOTRACE_NOTICE("batch of %u params refused by user", pDec->batch_nb);
 	}
+	else {
+		for (i = 0; i < pDec->batch_nb; i++) {
+			setCnfValue(&pDec->batch[i]);
+		}
+	}
+	pDec->batch_nb = 0;
+}
 
-	pSetCfgUpdate->cid = 0;
-	pSetCfgUpdate->nb_of_params = 0;
+/* --------------------------------------------------------------------------------- */
+/* Value of a parameter ("v", after "t"): check the received type, and update the parameter */
+static void decode_cfg_param(LOMCfgDecode_t* pDec, const LOJsonToken_t* tk) {
+	const LiveObjectsD_Param_t* param_ptr = pDec->param_ptr;
+	LOMSetofUpdatedParams_t* pSetCfgUpdate = pDec->pSetCfgUpdate;
+	uint8_t val_str = (tk->evt == LOJSON_EVT_STRING) ? 1 : 0;
+
+	if (param_ptr == NULL) {
+		return;
+	}
+	if (pDec->type == LOD_TYPE_UNKNOWN) {
+		LOTRACE_NOTICE("param %s - Unknown received type", param_ptr->parm_data.data_name);
+		return;
+	}
+	if (pDec->type != param_ptr->parm_data.data_type) {
+		LOTRACE_NOTICE("param %s - bad type - received %d != expected %d", param_ptr->parm_data.data_name, pDec->type,
+				param_ptr->parm_data.data_type);
+		return;
+	}
+	if ((pDec->type == LOD_TYPE_STRING_C) && (!val_str)) {
+		LOTRACE_NOTICE("param %s - string type with a primitive value", param_ptr->parm_data.data_name);
+		return;
+	}
+#if (MSG_DBG > 1)
+	LOTRACE_PRINTF("   *** param value = %.*s\r\n", (int) tk->val_len, tk->val_ptr);
+#endif
 
-	memset(&tokens, 0, sizeof(tokens));
-	jsmn_init(&parser);
-	token_cnt = jsmn_parse(&parser, payload_data, payload_len, tokens, NB_TK_FOR_PARMS);
-	if (token_cnt < 0) {
-		LOTRACE_ERR("ERROR %d returned by jsmn_parse (max params=%u)", token_cnt, LOC_MAX_OF_PARSED_PARAMS);
-		LOTRACE_ERR("'%s'", payload_data);
-		return -1;
+	if (pDec->pSetCfg->param_batch_callback) {
+		LiveObjectsD_ParamUpdate_t* pUpd = &pDec->batch[pDec->batch_nb];
+		pUpd->param_ptr = param_ptr;
+		if (getCnfValue(pUpd, &pDec->batch_num[pDec->batch_nb], tk->val_ptr, tk->val_len, val_str) == 0) {
+			if (++pDec->batch_nb == LOC_PARAMS_BATCH_SZ) {
+				decode_cfg_flush(pDec);
+			}
+		}
 	}
-#undef NB_TK_FOR_PARMS
-	if (token_cnt == 0) {
-		LOTRACE_ERR("EMPTY !");
-		return 0;
+	else {
+		updateCnfParam(tk->val_ptr, tk->val_len, val_str, param_ptr, pDec->pSetCfg->param_callback);
 	}
 
+	// Only the first updated params are listed in the response, otherwise all params are published.
+	if (pSetCfgUpdate->nb_of_params < LOC_MAX_OF_PARSED_PARAMS) {
+		pSetCfgUpdate->tab_of_param_ptr[pSetCfgUpdate->nb_of_params] = param_ptr;
+	}
+	pSetCfgUpdate->nb_of_params++;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int decode_cfg_event(void* ctx, const LOJsonToken_t* tk) {
+	LOMCfgDecode_t* pDec = (LOMCfgDecode_t*) ctx;
+
 #if (MSG_DUMP)
-	dump_json_msg("decode_cfg", payload_data, tokens, token_cnt);
+	dump_json_evt("decode_cfg", tk);
 #endif
 
-	if (token_cnt < 2) {
-		LOTRACE_ERR("Bad format - token_cnt=%d < 2 too short !", token_cnt);
-		return -1;
+	switch (tk->depth) {
+	case 0:
+		if (tk->evt == LOJSON_EVT_OBJECT_END) {
+			pDec->root_nb = tk->index;
+			return 0;
+		}
+		if (tk->evt != LOJSON_EVT_OBJECT_BEGIN) {
+			LOTRACE_ERR("Bad format - unexpected root value, evt=%d", tk->evt);
+			return 1;
+		}
+		pDec->root = 1;
+		return 0;
+
+	case 1:
+		if ((tk->evt == LOJSON_EVT_OBJECT_END) || (tk->evt == LOJSON_EVT_ARRAY_END)) {
+			pDec->in_cfg = 0;
+			return 0;
+		}
+		if (isName(tk, "cid", 3)) {
+			pDec->cid_rc = (get_CorrelationId(&pDec->cid, tk)) ? -1 : 1;
+		}
+		if (tk->index == 0) {
+			// should be '"cfg" : {'
+			if ((tk->evt != LOJSON_EVT_OBJECT_BEGIN) || !isName(tk, "cfg", 3)) {
+				LOTRACE_ERR("Bad header format, expected 'cfg' - evt=%d [%.*s]", tk->evt, (int) tk->name_len,
+						tk->name_ptr);
+				pDec->err = -1;
+				return 0;
+			}
+			pDec->in_cfg = 1;
+		}
+		return 0;
+
+	case 2:
+		if ((!pDec->in_cfg) || (pDec->err)) {
+			return 0;
+		}
+		if (tk->evt == LOJSON_EVT_OBJECT_END) {
+			if ((tk->index != 2) || (pDec->tv != 3)) {
+				LOTRACE_ERR("Bad param format, %u members (\"t\" and \"v\" expected)", tk->index);
+				pDec->err = -2;
+			}
+			return 0;
+		}
+		if (tk->evt != LOJSON_EVT_OBJECT_BEGIN) {
+			LOTRACE_ERR("Bad param format, at param[%u] (evt=%d)", tk->index, tk->evt);
+			pDec->err = -2;
+			return 0;
+		}
+		// Parameter Name
+#if (MSG_DBG > 1)
+		LOTRACE_PRINTF("   *** param name = %.*s\r\n", (int) tk->name_len, tk->name_ptr);
+#endif
+		pDec->tv = 0;
+		pDec->param_ptr = NULL;
+		if (pDec->pSetCfg->param_set.param_nb) {
+			int i = LO_msg_name_find(&pDec->pSetCfg->param_index, pDec->pSetCfg->param_set.param_ptr,
+					pDec->pSetCfg->param_set.param_nb, sizeof(LiveObjectsD_Param_t),
+					offsetof(LiveObjectsD_Param_t, parm_data.data_name), tk->name_ptr, tk->name_len);
+			if (i >= 0) {
+				// Config Parameter Name is found in the user list
+				pDec->param_ptr = &pDec->pSetCfg->param_set.param_ptr[i];
+			}
+		}
+		return 0;
+
+	case 3:
+		if ((!pDec->in_cfg) || (pDec->err)) {
+			return 0;
+		}
+		if ((tk->index == 0) && (tk->evt == LOJSON_EVT_STRING) && isName(tk, "t", 1)) {
+			// Parameter type : "u32" , "u16", ...
+			pDec->type = LO_getDataTypeFromStrL(tk->val_ptr, tk->val_len);
+			pDec->tv = 1;
+		}
+		else if ((tk->index == 1) && ((tk->evt == LOJSON_EVT_STRING) || (tk->evt == LOJSON_EVT_PRIMITIVE))
+				&& isName(tk, "v", 1)) {
+			// Value : either PRIMITIVE or STRING
+			pDec->tv |= 2;
+			decode_cfg_param(pDec, tk);
+		}
+		else if ((tk->evt != LOJSON_EVT_OBJECT_END) && (tk->evt != LOJSON_EVT_ARRAY_END)) {
+			LOTRACE_ERR("Bad param format, expected 't' and 'v' - evt=%d index=%u", tk->evt, tk->index);
+			pDec->err = -2;
+		}
+		return 0;
 	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Result of a decoded configuration request (ret: value returned by the JSON reader) */
+static int decode_cfg_result(LOMCfgDecode_t* pDec, int ret) {
+	LOMSetofUpdatedParams_t* pSetCfgUpdate = pDec->pSetCfgUpdate;
+
+	decode_cfg_flush(pDec);
 
-	if ((tokens[0].type != JSMN_OBJECT) || (tokens[0].size <= 0)) {
-		LOTRACE_ERR("Bad format - %d [0]=(%d,%d)", token_cnt, tokens[0].type, tokens[0].size);
+	if ((ret == 0) && (pDec->root == 0)) {
+		LOTRACE_ERR("EMPTY !");
+		return 0;
+	}
+	if ((pDec->root == 0) || (pDec->root_nb == 0)) {
+		LOTRACE_ERR("Bad format - root=%u nb=%u", pDec->root, pDec->root_nb);
 		return -1;
 	}
 
-	// Get the Correlation Id
-	ret = get_CorrelationId(&pSetCfgUpdate->cid, payload_data, &tokens[1], token_cnt);
-	if (ret) {
+	if (pDec->cid_rc <= 0) {
 		LOTRACE_ERR("Error to get the correlation id");
 		return -1;
 	}
+	pSetCfgUpdate->cid = pDec->cid;
 
-	if ((tokens[1].type != JSMN_STRING) || (tokens[1].size != 1) // should be 'cfg'
-			|| (tokens[2].type != JSMN_OBJECT) || (tokens[2].size < 0)) // should be {
-			{
-		LOTRACE_ERR("Bad header format - [1]=(%d,%d) [2]=(%d,%d)", tokens[1].type, tokens[1].size,
-				tokens[2].type, tokens[2].size);
+	LOTRACE_DBG1("%"PRIi32" params updated", pSetCfgUpdate->nb_of_params);
+
+	return pDec->err;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void decode_cfg_init(LOMCfgDecode_t* pDec, const LOMSetOfParams_t* pSetCfg,
+		LOMSetofUpdatedParams_t* pSetCfgUpdate) {
+	pSetCfgUpdate->cid = 0;
+	pSetCfgUpdate->nb_of_params = 0;
+
+	memset(pDec, 0, sizeof(LOMCfgDecode_t));
+	pDec->pSetCfg = pSetCfg;
+	pDec->pSetCfgUpdate = pSetCfgUpdate;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* The parameters are updated while the message is decoded, without limit on their number:
+ * one by one with the user callback, or by batches of LOC_PARAMS_BATCH_SZ with the batch callback.
+ */
+int LO_msg_decode_params_req(const char* payload_data, uint32_t payload_len, const LOMSetOfParams_t* pSetCfg,
+		LOMSetofUpdatedParams_t* pSetCfgUpdate) {
+	int ret;
+	LOMCfgDecode_t dec;
+
+	if ((pSetCfg == NULL) || (payload_data == NULL) || (payload_len == 0) || (pSetCfgUpdate == NULL)) {
+		LOTRACE_ERR("Invalid params, pSetCfg=x%p payload_data=x%p (%"PRIu32") pSetCfgUpdate=x%p",
+				pSetCfg, payload_data, payload_len, pSetCfgUpdate);
 		return -1;
 	}
 
-	ret = check_token(payload_data, &tokens[1], "cfg");
-	if (ret <= 0) {
-		LOTRACE_ERR("Bad format, expected 'cfg'");
+	decode_cfg_init(&dec, pSetCfg, pSetCfgUpdate);
+
+	ret = LO_json_parse(payload_data, payload_len, decode_cfg_event, &dec);
+	if (ret < 0) {
+		LOTRACE_ERR("ERROR %d returned by LO_json_parse", ret);
+		LOTRACE_ERR("'%.*s'", (int) payload_len, payload_data);
 		return -1;
 	}
-	// skip the first tokens '{ "cfg" : {'
-	idx = 3;
-	token_cnt -= 3;
-
-	// Get the number of parameters
-	size = tokens[2].size;
-	LOTRACE_DBG1("%d params (token_cnt=%d) ...", size, token_cnt);
-
-	// Now, get each configuration parameter
-	while (size > 0) {
-		if ((token_cnt < 6) || (tokens[idx].type != JSMN_STRING) // 0: should be the Parameter Name
-				|| (tokens[idx + 1].type != JSMN_OBJECT) // 1: should be {
-				|| (tokens[idx + 2].type != JSMN_STRING) // 2: Should be equal to "t"
-				|| (tokens[idx + 3].type != JSMN_STRING) // 3: Should be the parameter type : "u32" , "u16", ...
-				|| (tokens[idx + 4].type != JSMN_STRING) // 4: Should be equal to "v"
-														 // 5: Value : either JSMN_PRIMITIVE or JSMN_STRING
-				|| !((tokens[idx + 5].type == JSMN_PRIMITIVE) || (tokens[idx + 5].type == JSMN_STRING))) {
-			LOTRACE_ERR("Bad param format, at idx=%d (param[%d] token_cnt=%d)", idx, tokens[2].size - size,
-					token_cnt);
-			return -2;
-		}
+	return decode_cfg_result(&dec, ret);
+}
 
-		ret = check_token(payload_data, &tokens[idx + 2], "t");
-		if (ret <= 0) {
-			LOTRACE_ERR("Bad param format at idx=%d - expected 't'", idx + 2);
-			return -2;
-		}
+#if LOC_MQTT_RCV_CHUNKED
+/* State of the configuration request being received in pieces */
+static struct {
+	LOJsonReader_t rd;
+	LOMCfgDecode_t dec;
+} _LOM_cfg_part;
 
-		ret = check_token(payload_data, &tokens[idx + 4], "v");
-		if (ret <= 0) {
-			LOTRACE_NOTICE("Bad param format at idx=%d - expected 'v'", idx + 4);
-			return -2;
-		}
+/* --------------------------------------------------------------------------------- */
+/* The pending batch refers to the current piece: it is given to the batch callback at the end of each piece. */
+int LO_msg_decode_params_part(const char* data, uint32_t len, uint32_t offset, uint8_t last,
+		const LOMSetOfParams_t* pSetCfg, LOMSetofUpdatedParams_t* pSetCfgUpdate, uint32_t* pConsumed) {
+	int ret;
 
-		// Parameter Name
-		len = tokens[idx].end - tokens[idx].start;
-		pc = payload_data + tokens[idx].start;
+	if ((pSetCfg == NULL) || (data == NULL) || (pSetCfgUpdate == NULL) || (pConsumed == NULL)) {
+		LOTRACE_ERR("Invalid params, pSetCfg=x%p data=x%p pSetCfgUpdate=x%p", pSetCfg, data, pSetCfgUpdate);
+		return -1;
+	}
+	if (offset == 0) {
+		decode_cfg_init(&_LOM_cfg_part.dec, pSetCfg, pSetCfgUpdate);
+		LO_json_reader_init(&_LOM_cfg_part.rd);
+	}
+	LOTRACE_DBG1("piece at %"PRIu32", len=%"PRIu32"%s", offset, len, (last) ? " (last)" : "");
 
-#if (MSG_DBG > 1)
-		if (len > 0) {
-			LOTRACE_PRINTF("   *** param name = %.*s\r\n", len, pc);
-		}
-#endif
+	*pConsumed = len;
+	ret = LO_json_parse_part(&_LOM_cfg_part.rd, data, len, last, decode_cfg_event, &_LOM_cfg_part.dec, pConsumed);
+	if (ret < 0) {
+		LOTRACE_ERR("ERROR %d returned by LO_json_parse_part, at offset %"PRIu32, ret, offset);
+		return -1;
+	}
+	if ((ret == 0) && (!last)) {
+		decode_cfg_flush(&_LOM_cfg_part.dec);
+		return 0;
+	}
+	ret = decode_cfg_result(&_LOM_cfg_part.dec, ret);
+	return ((ret == 0) && (!last)) ? -1 : ret;
+}
+#endif /* LOC_MQTT_RCV_CHUNKED */
+#endif /* LOC_FEATURE_LO_PARAMS */
 
-		if (pSetCfg->param_set.param_nb) {
-			int i;
-			const LiveObjectsD_Param_t* param_ptr = pSetCfg->param_set.param_ptr;
-			for (i = 0; i < pSetCfg->param_set.param_nb; i++, param_ptr++) {
-				int param_name_len = strlen(param_ptr->parm_data.data_name);
-				if ((len == param_name_len) && (!strncmp(pc, param_ptr->parm_data.data_name, param_name_len))) {
-					// Config Parameter Name is found in the user list
-					// Get the type of this config parameter
-					LiveObjectsD_Type_t type = LO_getDataTypeFromStrL(payload_data + tokens[idx + 3].start,
-							tokens[idx + 3].end - tokens[idx + 3].start);
-					if (type == LOD_TYPE_UNKNOWN) {
-						LOTRACE_NOTICE("param %s - Unknown received type",
-								param_ptr->parm_data.data_name);
-					}
-					else if (type != param_ptr->parm_data.data_type) {
-						LOTRACE_NOTICE("param %s - bad type - received %d != expected %d",
-								param_ptr->parm_data.data_name, type, param_ptr->parm_data.data_type);
-					}
-					else if ((type == LOD_TYPE_STRING_C) && (tokens[idx + 5].type != JSMN_STRING)) {
-						LOTRACE_NOTICE("param %s - string type with unexpected jsmntype %d != %d",
-								param_ptr->parm_data.data_name, tokens[idx + 5].type, JSMN_STRING);
-					}
-					else {
-#if (MSG_DBG > 1)
-						LOTRACE_PRINTF("   *** param value = %.*s\r\n", tokens[idx + 5].end - tokens[idx + 5].start,
-								payload_data + tokens[idx + 5].start);
+/* --------------------------------------------------------------------------------- */
+/*  */
+#if LOC_FEATURE_LO_COMMANDS
+
+/* --------------------------------------------------------------------------------- */
+/* Command blocks
+ * The static blocks are taken by the LiveObjects Client thread, and released either by this thread after
+ * the user callback, or by the user thread which sends the delayed response (LiveObjectsClient_CommandResponse).
+ * The blocks of delayed commands are also released when the client (re)connects (LO_msg_cmd_blk_reset).
+ * A command received while all blocks are in use gets a 'Busy' response.
+ */
+#if (LOC_CMD_BLK_SZ < 64)
+#error "LOC_CMD_BLK_SZ must be at least 64 bytes"
 #endif
-						ret = updateCnfParam(payload_data, &tokens[idx + 5], param_ptr, pSetCfg->param_callback);
 
-						if (pSetCfgUpdate->nb_of_params < LOC_MAX_OF_PARSED_PARAMS) {
-							pSetCfgUpdate->tab_of_param_ptr[pSetCfgUpdate->nb_of_params++] = param_ptr;
-						}
-					}
-					break;
-				}
-			}
+#if (LOC_CMD_BLK_NB > 0)
+
+typedef union {
+	LiveObjectsD_CommandRequestBlock_t blk;
+	char buf[LOC_CMD_BLK_SZ];
+} LOMCmdBlk_t;
+
+static LOMCmdBlk_t      _LOM_cmd_blk[LOC_CMD_BLK_NB];
+static volatile int32_t _LOM_cmd_blk_cid[LOC_CMD_BLK_NB];
+static volatile uint8_t _LOM_cmd_blk_used[LOC_CMD_BLK_NB]; /* 1: being filled, 2: given to user, 3: response being encoded */
+
+/* --------------------------------------------------------------------------------- */
+/* Return a free command block of LOC_CMD_BLK_SZ bytes, or NULL if all blocks are in use (Busy) */
+static LiveObjectsD_CommandRequestBlock_t* cmd_blk_alloc(void) {
+	int i;
+	if (MSG_MUTEX_LOCK()) {
+		LOTRACE_ERR("Error to lock mutex");
+		return NULL;
+	}
+	for (i = 0; i < LOC_CMD_BLK_NB; i++) {
+		if (!_LOM_cmd_blk_used[i]) {
+			_LOM_cmd_blk_used[i] = 1;
+			MSG_MUTEX_UNLOCK();
+			LOTRACE_DBG1("command block %d", i);
+			return &_LOM_cmd_blk[i].blk;
 		}
-		size--;
-		token_cnt -= 6;
-		idx += 6;
 	}
+	MSG_MUTEX_UNLOCK();
+	LOTRACE_ERR("BUSY, %u command blocks in use", LOC_CMD_BLK_NB);
+	return NULL;
+}
 
-	return 0;
+/* --------------------------------------------------------------------------------- */
+/* The block is given to user: it can be released by LO_msg_cmd_blk_release() */
+static void cmd_blk_set_cid(LiveObjectsD_CommandRequestBlock_t* pReqBlk, int32_t cid) {
+	int i = (LOMCmdBlk_t*) pReqBlk - _LOM_cmd_blk;
+	_LOM_cmd_blk_cid[i] = cid;
+	_LOM_cmd_blk_used[i] = 2;
 }
-#endif /* LOC_FEATURE_LO_PARAMS */
 
 /* --------------------------------------------------------------------------------- */
 /*  */
-#if LOC_FEATURE_LO_COMMANDS
-int LO_msg_decode_cmd_req(const char* payload_data, uint32_t payload_len, const LOMSetofCommands_t* pSetCmd,
-		int32_t* pCid) {
-	int ret;
-	int token_cnt;
-	jsmn_parser parser;
-	jsmntok_t tokens[20];
-	int idx;
-	int size;
-	const LiveObjectsD_Command_t* cmd_ptr;
+static void cmd_blk_free(LiveObjectsD_CommandRequestBlock_t* pReqBlk) {
+	int i = (LOMCmdBlk_t*) pReqBlk - _LOM_cmd_blk;
+	_LOM_cmd_blk_used[i] = 0;
+}
 
-	if ((pSetCmd == NULL) || (payload_data == NULL) || (pCid == NULL)) {
-		LOTRACE_ERR("Invalid params, pSetCmd=x%p payload_data=x%p pCid=x%p", pSetCmd, payload_data,
-				pCid);
+/* --------------------------------------------------------------------------------- */
+/* Change the state of the block given to user for this command */
+static int cmd_blk_change(int32_t cid, uint8_t state) {
+	int i;
+	int ret = -1;
+	if (MSG_MUTEX_LOCK()) {
+		LOTRACE_ERR("Error to lock mutex");
 		return -1;
 	}
+	for (i = 0; i < LOC_CMD_BLK_NB; i++) {
+		if ((_LOM_cmd_blk_used[i] >= 2) && (_LOM_cmd_blk_cid[i] == cid)) {
+			LOTRACE_DBG1("cid=%"PRIi32" - %s command block %d", cid, (state) ? "hold" : "release", i);
+			_LOM_cmd_blk_used[i] = state;
+			ret = 0;
+			break;
+		}
+	}
+	MSG_MUTEX_UNLOCK();
+	return ret;
+}
 
-	*pCid = 0;
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_cmd_blk_hold(int32_t cid) {
+	return cmd_blk_change(cid, 3);
+}
 
-	memset(&tokens, 0, sizeof(tokens));
-	jsmn_init(&parser);
-	token_cnt = jsmn_parse(&parser, payload_data, payload_len, tokens, 20);
-	if (token_cnt < 0) {
-		LOTRACE_ERR("ERROR %d returned by jsmn_parse", token_cnt);
-		LOTRACE_ERR("'%.*s'", (int) payload_len, payload_data);
-		return -1;
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_cmd_blk_release(int32_t cid) {
+	return cmd_blk_change(cid, 0);
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void LO_msg_cmd_blk_reset(void) {
+	int i;
+	if (MSG_MUTEX_LOCK()) {
+		LOTRACE_ERR("Error to lock mutex");
+		return;
 	}
-	if (token_cnt == 0) {
-		LOTRACE_NOTICE("EMPTY !");
-		return 0;
+	for (i = 0; i < LOC_CMD_BLK_NB; i++) {
+		if (_LOM_cmd_blk_used[i] == 2) {
+			LOTRACE_DBG1("cid=%"PRIi32" - release command block %d", _LOM_cmd_blk_cid[i], i);
+			_LOM_cmd_blk_used[i] = 0;
+		}
+	}
+	MSG_MUTEX_UNLOCK();
+}
+
+#else /* LOC_CMD_BLK_NB == 0 */
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static LiveObjectsD_CommandRequestBlock_t* cmd_blk_alloc(void) {
+	LiveObjectsD_CommandRequestBlock_t* pReqBlk = (LiveObjectsD_CommandRequestBlock_t*) MEM_ALLOC(LOC_CMD_BLK_SZ);
+	if (pReqBlk == NULL) {
+		LOTRACE_ERR("MEM_ALLOC ERROR, len=%u", LOC_CMD_BLK_SZ);
+		return NULL;
+	}
+	LOTRACE_NOTICE("MEM_ALLOC %p len=%u", pReqBlk, LOC_CMD_BLK_SZ);
+	return pReqBlk;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void cmd_blk_set_cid(LiveObjectsD_CommandRequestBlock_t* pReqBlk, int32_t cid) {
+	(void) pReqBlk;
+	(void) cid;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void cmd_blk_free(LiveObjectsD_CommandRequestBlock_t* pReqBlk) {
+	LOTRACE_NOTICE("MEM_FREE %p", pReqBlk);
+	MEM_FREE(pReqBlk);
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_cmd_blk_hold(int32_t cid) {
+	(void) cid;
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_cmd_blk_release(int32_t cid) {
+	(void) cid;
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void LO_msg_cmd_blk_reset(void) {
+}
+#endif /* LOC_CMD_BLK_NB */
+
+/* --------------------------------------------------------------------------------- */
+/* State of the command request decoder (see LO_msg_decode_cmd_req)
+ * The arguments are copied in the command block while the message is decoded:
+ * argument descriptors from the beginning of the block, names and values from its end.
+ * When the message is received in pieces, the name of the request is also copied in the block.
+ */
+typedef struct {
+	LiveObjectsD_CommandRequestBlock_t* pReqBlk;  /* NULL if no free block */
+	LiveObjectsD_CommandArg_t* pArgs;  /* next argument */
+	char*    pLine;        /* names and values, stored from the end of the block */
+	const char* req_ptr;   /* name of the request */
+	uint32_t req_len;
+	uint16_t arg_nb;       /* number of arguments */
+	int32_t  cid;
+	int8_t   cid_rc;       /* 1: found, -1: bad value, 0: not found */
+	int8_t   arg_rc;       /* 1: found, -1: bad format, -6: block too small, 0: not found */
+	uint8_t  root;         /* 1: the root value is an object */
+	uint8_t  in_arg;       /* 1: in the "arg" object */
+	uint16_t root_nb;      /* number of members of the root object */
+	uint8_t  part;         /* 1: message received in pieces (see LO_msg_decode_cmd_part) */
+} LOMCmdDecode_t;
+
+/* --------------------------------------------------------------------------------- */
+/* Copy one argument (member of the "arg" object) in the command request block */
+static void decode_cmd_arg(LOMCmdDecode_t* pDec, const LOJsonToken_t* tk) {
+	LiveObjectsD_CommandArg_t* pArgs = pDec->pArgs;
+
+	LOTRACE_INF("arg \"%.*s\" = (%s) %.*s", (int) tk->name_len, tk->name_ptr,
+			(tk->evt == LOJSON_EVT_STRING) ? "STRING" : "PRIMITIVE", (int) tk->val_len, tk->val_ptr);
+	pDec->arg_nb++;
+	if ((pDec->pReqBlk == NULL) || (pDec->arg_rc != 1)) {
+		return;
 	}
+	if ((char*) (pArgs + 1) + tk->name_len + 1 + tk->val_len + 1 > pDec->pLine) {
+		LOTRACE_ERR("arg[%u] %.*s - command block too small (%u bytes)", tk->index, (int) tk->name_len,
+				tk->name_ptr, LOC_CMD_BLK_SZ);
+		pDec->arg_rc = -6;
+		return;
+	}
+
+	pDec->pLine -= tk->val_len + 1;
+	memcpy(pDec->pLine, tk->val_ptr, tk->val_len);
+	pDec->pLine[tk->val_len] = 0;
+	pArgs->arg_value = pDec->pLine;
+
+	pDec->pLine -= tk->name_len + 1;
+	memcpy(pDec->pLine, tk->name_ptr, tk->name_len);
+	pDec->pLine[tk->name_len] = 0;
+	pArgs->arg_name = pDec->pLine;
+
+	pArgs->arg_type = (tk->evt == LOJSON_EVT_STRING) ? 1 : 0;
+
+	pDec->pArgs++;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Name of the request, copied in the command block if the message is received in pieces */
+static void decode_cmd_req(LOMCmdDecode_t* pDec, const LOJsonToken_t* tk) {
+	if (!pDec->part) {
+		pDec->req_ptr = tk->val_ptr;
+		pDec->req_len = tk->val_len;
+		return;
+	}
+	pDec->req_ptr = "";  /* not kept without command block */
+	pDec->req_len = 0;
+	if (pDec->pReqBlk == NULL) {
+		return;
+	}
+	if ((char*) pDec->pArgs + tk->val_len + 1 > pDec->pLine) {
+		LOTRACE_ERR("req %.*s - command block too small (%u bytes)", (int) tk->val_len, tk->val_ptr, LOC_CMD_BLK_SZ);
+		pDec->req_ptr = NULL;
+		return;
+	}
+	pDec->pLine -= tk->val_len + 1;
+	memcpy(pDec->pLine, tk->val_ptr, tk->val_len);
+	pDec->pLine[tk->val_len] = 0;
+	pDec->req_ptr = pDec->pLine;
+	pDec->req_len = tk->val_len;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* The members of the command request ("req", "arg" and "cid") can be in any order */
+static int decode_cmd_event(void* ctx, const LOJsonToken_t* tk) {
+	LOMCmdDecode_t* pDec = (LOMCmdDecode_t*) ctx;
 
 #if (MSG_DUMP)
-	dump_json_msg("decode_cmd", payload_data, tokens, token_cnt);
+	dump_json_evt("decode_cmd", tk);
 #endif
 
-	if (token_cnt < 5) {
-		LOTRACE_ERR("Bad format - token_cnt=%d < 5 too short ! ", token_cnt);
-		return -1;
+	switch (tk->depth) {
+	case 0:
+		if (tk->evt == LOJSON_EVT_OBJECT_END) {
+			pDec->root_nb = tk->index;
+			return 0;
+		}
+		if (tk->evt != LOJSON_EVT_OBJECT_BEGIN) {
+			LOTRACE_ERR("Bad format - unexpected root value, evt=%d", tk->evt);
+			return 1;
+		}
+		pDec->root = 1;
+		return 0;
+
+	case 1:
+		if (tk->evt == LOJSON_EVT_OBJECT_END) {
+			pDec->in_arg = 0;
+		}
+		else if (isName(tk, "cid", 3)) {
+			pDec->cid_rc = (get_CorrelationId(&pDec->cid, tk)) ? -1 : 1;
+		}
+		else if ((tk->evt == LOJSON_EVT_STRING) && isName(tk, "req", 3)) {
+			decode_cmd_req(pDec, tk);
+		}
+		else if ((tk->evt == LOJSON_EVT_OBJECT_BEGIN) && isName(tk, "arg", 3)) {
+			if (pDec->arg_rc) {
+				LOTRACE_ERR("Bad format - \"arg\" is duplicated");
+				pDec->arg_rc = -1;
+				return 0;
+			}
+			pDec->arg_rc = 1;
+			pDec->in_arg = 1;
+		}
+		return 0;
+
+	case 2:
+		if (!pDec->in_arg) {
+			return 0;
+		}
+		// Support only simple type - "name" : string or primitive value
+		if ((tk->evt != LOJSON_EVT_STRING) && (tk->evt != LOJSON_EVT_PRIMITIVE)) {
+			if ((tk->evt != LOJSON_EVT_OBJECT_END) && (tk->evt != LOJSON_EVT_ARRAY_END)) {
+				LOTRACE_ERR("format not supported for arg[%u] %.*s (evt=%d)", tk->index, (int) tk->name_len,
+						tk->name_ptr, tk->evt);
+				pDec->arg_rc = -1;
+			}
+			return 0;
+		}
+		decode_cmd_arg(pDec, tk);
+		return 0;
 	}
+	return 0;
+}
 
-	if ((tokens[0].type != JSMN_OBJECT) || (tokens[0].size <= 0)) {
-		LOTRACE_ERR("Bad format: Empty ! %d [0]=(%d,%d)", token_cnt, tokens[0].type, tokens[0].size);
-		return -1;
+/* --------------------------------------------------------------------------------- */
+/* Move the names and values just after the last argument, and return the size of the block */
+static uint32_t decode_cmd_pack(LOMCmdDecode_t* pDec) {
+	LiveObjectsD_CommandRequestBlock_t* pReqBlk = pDec->pReqBlk;
+	LiveObjectsD_CommandArg_t* pArgs = (LiveObjectsD_CommandArg_t*) pReqBlk->args_array;
+	char* pDst = (char*) pDec->pArgs;
+	uint32_t len = ((char*) pReqBlk + LOC_CMD_BLK_SZ) - pDec->pLine;
+	uint32_t delta = pDec->pLine - pDst;
+	uint16_t i;
+
+	memmove(pDst, pDec->pLine, len);
+	for (i = 0; i < pDec->arg_nb; i++, pArgs++) {
+		pArgs->arg_name -= delta;
+		pArgs->arg_value -= delta;
 	}
+	if (pDec->part && pDec->req_len) {
+		pDec->req_ptr -= delta;
+	}
+	return (pDst + len) - (char*) pReqBlk;
+}
 
-	// Get the Correlation Id.
-	ret = get_CorrelationId(pCid, payload_data, &tokens[1], token_cnt - 1);
-	if (ret) {
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void decode_cmd_init(LOMCmdDecode_t* pDec, uint8_t part) {
+	LiveObjectsD_CommandRequestBlock_t* pReqBlk;
+
+	memset(pDec, 0, sizeof(LOMCmdDecode_t));
+	pDec->part = part;
+	// Single pass: the arguments are copied in the command block while decoding the message
+	pReqBlk = cmd_blk_alloc();
+	if (pReqBlk) {
+		pDec->pReqBlk = pReqBlk;
+		pDec->pArgs = (LiveObjectsD_CommandArg_t*) pReqBlk->args_array;
+		pDec->pLine = (char*) pReqBlk + LOC_CMD_BLK_SZ;
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Check a decoded command request (ret: value returned by the JSON reader), and give it to the user */
+static int decode_cmd_result(LOMCmdDecode_t* pDec, int ret, const LOMSetofCommands_t* pSetCmd, int32_t* pCid) {
+	int idx;
+	const LiveObjectsD_Command_t* cmd_ptr;
+	LiveObjectsD_CommandRequestBlock_t* pReqBlk = pDec->pReqBlk;
+
+	if (ret < 0) {
+		ret = -1;
+	}
+	else if ((ret == 0) && (pDec->root == 0)) {
+		LOTRACE_NOTICE("EMPTY !");
+		ret = 0;
+	}
+	else if ((pDec->root == 0) || (pDec->root_nb == 0)) {
+		LOTRACE_ERR("Bad format: Empty ! root=%u nb=%u", pDec->root, pDec->root_nb);
+		ret = -1;
+	}
+	else if (pDec->cid_rc <= 0) {
 		LOTRACE_ERR("Error to get the correlation id (cid)");
-		return -1;
+		ret = -1;
+	}
+	else {
+		*pCid = pDec->cid;
+		ret = 1;
+	}
+	if (ret <= 0) {
+		if (pReqBlk)
+			cmd_blk_free(pReqBlk);
+		return ret;
 	}
 
-	// Now, Check the first tokens
-	// Note: suppose that token[1]= "req" and token[3]= "arg", and so cid at the end !
-	if ((tokens[0].type != JSMN_OBJECT) || (tokens[0].size < 3) // at least 3 items : "req", "arg" and "cid"
-			|| (tokens[1].type != JSMN_STRING) || (tokens[1].size != 1) // expected : "req"
-			|| (tokens[2].type != JSMN_STRING) || (tokens[2].size != 0) // expected : name of request
-			) {
-		LOTRACE_ERR("Bad format (cid=%"PRIi32") - %d [0]=(%d,%d) [1]=(%d,%d) [2]=(%d,%d)", *pCid, token_cnt,
-				tokens[0].type, tokens[0].size, tokens[1].type, tokens[1].size, tokens[2].type, tokens[2].size);
+	// at least 3 members : "req", "arg" and "cid"
+	if ((pDec->root_nb < 3) || (pDec->req_ptr == NULL)) {
+		LOTRACE_ERR("Bad format (cid=%"PRIi32") - %u members, expected=req", *pCid, pDec->root_nb);
 		//pCid = 0; // set cid=0 => no response, otherwise LiveObjects platform will send again this malformed command !
-		return -2;
+		ret = -2;
 	}
-
-	ret = check_token(payload_data, &tokens[1], "req");
-	if (ret <= 0) {
-		LOTRACE_ERR("Bad format (cid=%"PRIi32") - expected=req", *pCid);
-		return -2;
-	}
-
-	// Is it registered by user ?
-	cmd_ptr = NULL;
-	size = tokens[2].end - tokens[2].start;
-	LOTRACE_INF("command \"%.*s\"  (NumberOfCommands=%d) ..", size, payload_data + tokens[2].start,
-			pSetCmd->cmd_nb);
-	for (idx = 0; idx < pSetCmd->cmd_nb; idx++) {
-		LOTRACE_DBG1("   [%d] %s ?", idx, pSetCmd->cmd_ptr[idx].cmd_name);
-		if ((size == (int) strlen(pSetCmd->cmd_ptr[idx].cmd_name))
-				&& !strncmp(pSetCmd->cmd_ptr[idx].cmd_name, payload_data + tokens[2].start, size)) {
+	else if ((pReqBlk == NULL) && (pDec->part)) {
+		// the name of the request is only kept in the command block
+		LOTRACE_ERR("cid=%"PRIi32" - no command block", *pCid);
+		ret = (LOC_CMD_BLK_NB > 0) ? -7 : -6;
+	}
+	else {
+		// Is it registered by user ?
+		cmd_ptr = NULL;
+		LOTRACE_INF("command \"%.*s\"  (NumberOfCommands=%d) ..", (int) pDec->req_len, pDec->req_ptr,
+				pSetCmd->cmd_nb);
+		idx = LO_msg_name_find(&pSetCmd->cmd_index, pSetCmd->cmd_ptr, pSetCmd->cmd_nb,
+				sizeof(LiveObjectsD_Command_t), offsetof(LiveObjectsD_Command_t, cmd_name), pDec->req_ptr,
+				pDec->req_len);
+		if (idx >= 0) {
 			cmd_ptr = &pSetCmd->cmd_ptr[idx];
-			break;
+		}
+		if (cmd_ptr == NULL) { // not found in the set of commands
+			LOTRACE_ERR("cid=%"PRIi32" - command \"%.*s\" not registered ", *pCid, (int) pDec->req_len,
+					pDec->req_ptr);
+			ret = -3;
+		}
+		else if (pSetCmd->cmd_callback == NULL) { // No function to process command
+			LOTRACE_ERR("cid=%"PRIi32" - command \"%.*s\" - No function to process command", *pCid,
+					(int) pDec->req_len, pDec->req_ptr);
+			ret = -4;
+		}
+		else if (pDec->arg_rc == 0) {
+			LOTRACE_ERR("Bad format - \"arg\" was expected");
+			ret = -2;
+		}
+		else if (pDec->arg_rc == -1) {
+			ret = -2;
+		}
+		else if (pReqBlk == NULL) {
+			ret = (LOC_CMD_BLK_NB > 0) ? -7 : -6;
+		}
+		else if (pDec->arg_rc < 0) {
+			ret = pDec->arg_rc;
 		}
 	}
-	if (cmd_ptr == NULL) { // not found in the set of commands
-		LOTRACE_ERR("cid=%"PRIi32" - command \"%.*s\" not registered ", *pCid, size,
-				payload_data + tokens[2].start);
-		return -3;
-	}
-	if (pSetCmd->cmd_callback == NULL) { // No callback function !
-		LOTRACE_ERR("cid=%"PRIi32" - command \"%.*s\" - No function to process command", *pCid, size,
-				payload_data + tokens[2].start);
-		return -4;
-	}
-	// Check the second token :  "arg" : { ... }
-	// TODO: position of 'arg' should be anywhere. (after or before 'cid')
-	if ((tokens[3].type != JSMN_STRING) || (tokens[3].size != 1) // expected : "arg"
-			|| (tokens[4].type != JSMN_OBJECT)  // expected :  ': {'
-			) {
-		LOTRACE_ERR("Bad format - [3]=(%d,%d) [4]=(%d,%d)", tokens[3].type, tokens[3].size, tokens[4].type,
-				tokens[4].size);
-		return -2;
-	}
-	ret = check_token(payload_data, &tokens[3], "arg");
 	if (ret <= 0) {
-		LOTRACE_ERR("Bad format - \"arg\" was expected");
-		return -2;
-	}
-
-	// Get the number of arguments
-	size = tokens[4].size;
-
-	LOTRACE_DBG1("cid=%"PRIi32" - command \"%.*s\" with %d params ...", *pCid,
-			tokens[2].end - tokens[2].start, payload_data + tokens[2].start, size);
-
-	// Now, get each argument. Support only simple type - "name" : string or primitive value
-	idx = 5;
-	token_cnt -= 5;
-	if (size > 0) {
-		char* pm;
-		LiveObjectsD_CommandRequestBlock_t* pReqBlkWithArgs;
-		LiveObjectsD_CommandArg_t* pArgs;
-		char* pLine;
-
-		int len = sizeof(LiveObjectsD_CommandRequestBlock_t) + (size - 1) * sizeof(LiveObjectsD_CommandArg_t)
-				+ tokens[idx + (size * 2) + 1].end - tokens[idx].start + 1;
-		pm = (char*) MEM_ALLOC(len);
-		if (pm == NULL) {
-			LOTRACE_ERR("nb_params=%d args_sz=%d - MEM_ALLOC ERROR, len=%d", size,
-					tokens[idx + (size * 2) + 1].end - tokens[idx].start, len);
-			return -6;
-		}
+		if (pReqBlk)
+			cmd_blk_free(pReqBlk);
+		return ret;
+	}
 
-		LOTRACE_NOTICE("nb_params=%d args_sz=%d - MEM_ALLOC %p len=%d", size,
-				tokens[idx + (size * 2) + 1].end - tokens[idx].start, pm, len);
+	LOTRACE_DBG1("cid=%"PRIi32" - command \"%.*s\" with %u params ...", *pCid, (int) pDec->req_len, pDec->req_ptr,
+			pDec->arg_nb);
 
-		//memset(pm, 0, len);
+	pReqBlk->hd.cmd_blk_len = (pDec->arg_nb > 0) ? decode_cmd_pack(pDec) : sizeof(LiveObjectsD_CommandRequestHeader_t);
+	pReqBlk->hd.cmd_ptr = cmd_ptr;
+	pReqBlk->hd.cmd_cid = *pCid;
+	pReqBlk->hd.cmd_args_nb = pDec->arg_nb;
 
-		pReqBlkWithArgs = (LiveObjectsD_CommandRequestBlock_t*) pm;
-		pArgs = (LiveObjectsD_CommandArg_t*) pReqBlkWithArgs->args_array;
-		pLine = (char*) (pm + sizeof(LiveObjectsD_CommandRequestBlock_t)
-				+ (size - 1) * sizeof(LiveObjectsD_CommandArg_t));
+	//TODO: Must be fixed - How to pass arguments to user ?
+#if (MSG_DBG > 1)
+	{
+		unsigned int i;
+		LOTRACE_INF("process command with %d args: ", pReqBlk->hd.cmd_args_nb);
+		for (i = 0; i < pReqBlk->hd.cmd_args_nb; i++) {
+			LOTRACE_INF("arg[%d] (%d)  %s %s", i, pReqBlk->args_array[i].arg_type, pReqBlk->args_array[i].arg_name,
+					pReqBlk->args_array[i].arg_value);
+		}
+	}
+#endif
 
-		pReqBlkWithArgs->hd.cmd_blk_len = len;
-		pReqBlkWithArgs->hd.cmd_ptr = cmd_ptr;
-		pReqBlkWithArgs->hd.cmd_cid = *pCid;
-		pReqBlkWithArgs->hd.cmd_args_nb = 0;
+	cmd_blk_set_cid(pReqBlk, *pCid);
+	ret = pSetCmd->cmd_callback(pReqBlk);
 
-		while ((token_cnt >= 2) && (size > 0)) {
-			if ((tokens[idx].type != JSMN_STRING) || (tokens[idx].size != 1) || (tokens[idx + 1].size != 0)
-					|| ((tokens[idx + 1].type != JSMN_STRING) && (tokens[idx + 1].type != JSMN_PRIMITIVE))) {
-				LOTRACE_ERR("format not supported for arg[%d]= (%d,%d):(%d,%d)", idx, tokens[idx].type,
-						tokens[idx].size, tokens[idx + 1].type, tokens[idx + 1].size);
-				return -2;
-			}
-			LOTRACE_INF("arg \"%.*s\" = (%s) %.*s", tokens[idx].end - tokens[idx].start,
-					payload_data + tokens[idx].start, conv_jsmntypeToString(tokens[idx + 1].type),
-					tokens[idx + 1].end - tokens[idx + 1].start, payload_data + tokens[idx + 1].start);
+#if (LOC_CMD_BLK_NB > 0)
+	// Delayed response: the block is kept until LiveObjectsClient_CommandResponse() or the next connection
+	if (ret == 0) {
+		return ret;
+	}
+#endif
+	cmd_blk_free(pReqBlk);
 
-			{
-				pArgs->arg_name = pLine;
-				memcpy(pLine, payload_data + tokens[idx].start, tokens[idx].end - tokens[idx].start);
-				pLine += tokens[idx].end - tokens[idx].start;
-				*pLine++ = 0;
+	return ret;
+}
 
-				pArgs->arg_value = pLine;
-				memcpy(pLine, payload_data + tokens[idx + 1].start, tokens[idx + 1].end - tokens[idx + 1].start);
-				pLine += tokens[idx + 1].end - tokens[idx + 1].start;
-				*pLine++ = 0;
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_decode_cmd_req(const char* payload_data, uint32_t payload_len, const LOMSetofCommands_t* pSetCmd,
+		int32_t* pCid) {
+	int ret;
+	LOMCmdDecode_t dec;
 
-				pArgs->arg_type = (tokens[idx + 1].type == JSMN_STRING) ? 1 : 0;
+	if ((pSetCmd == NULL) || (payload_data == NULL) || (pCid == NULL)) {
+		LOTRACE_ERR("Invalid params, pSetCmd=x%p payload_data=x%p pCid=x%p", pSetCmd, payload_data,
+				pCid);
+		return -1;
+	}
 
-				pArgs++;
-				pReqBlkWithArgs->hd.cmd_args_nb++;
-			}
-			size--;
-			idx += 2;
-			token_cnt -= 2;
-		}
+	*pCid = 0;
 
-		if (size) {
-			LOTRACE_ERR("Bad JSON format - remain= %d != 0 - arg_nb=%d  token_cnt=%d", size,
-					tokens[4].size, token_cnt);
-			return -2;
-		}
+	decode_cmd_init(&dec, 0);
 
-		//TODO: Must be fixed - How to pass arguments to user ?
-#if (MSG_DBG > 1)
-		{
-			unsigned int i;
-			LOTRACE_INF("process command with %d args: ", pReqBlkWithArgs->hd.cmd_args_nb);
-			for (i = 0; i < pReqBlkWithArgs->hd.cmd_args_nb; i++) {
-				LOTRACE_INF("arg[%d] (%d)  %s %s", i, pReqBlkWithArgs->args_array[i].arg_type,
-						pReqBlkWithArgs->args_array[i].arg_name, pReqBlkWithArgs->args_array[i].arg_value);
-			}
-		}
-#endif
+	ret = LO_json_parse(payload_data, payload_len, decode_cmd_event, &dec);
+	if (ret < 0) {
+		LOTRACE_ERR("ERROR %d returned by LO_json_parse", ret);
+		LOTRACE_ERR("'%.*s'", (int) payload_len, payload_data);
+	}
+	return decode_cmd_result(&dec, ret, pSetCmd, pCid);
+}
 
-		ret = pSetCmd->cmd_callback(pReqBlkWithArgs);
+#if LOC_MQTT_RCV_CHUNKED
+/* State of the command request being received in pieces */
+static struct {
+	LOJsonReader_t rd;
+	LOMCmdDecode_t dec;
+	uint8_t busy;  /* 1: waiting for the next piece */
+} _LOM_cmd_part;
 
-		LOTRACE_NOTICE("args - MEM_FREE %p", pReqBlkWithArgs);
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_decode_cmd_part(const char* data, uint32_t len, uint32_t offset, uint8_t last,
+		const LOMSetofCommands_t* pSetCmd, int32_t* pCid, uint32_t* pConsumed) {
+	int ret;
 
-		MEM_FREE(pReqBlkWithArgs);
+	if ((pSetCmd == NULL) || (data == NULL) || (pCid == NULL) || (pConsumed == NULL)) {
+		LOTRACE_ERR("Invalid params, pSetCmd=x%p data=x%p pCid=x%p", pSetCmd, data, pCid);
+		return -1;
 	}
-	else {
-		LiveObjectsD_CommandRequestHeader_t* pReqWithoutArg = (LiveObjectsD_CommandRequestHeader_t*) MEM_ALLOC(
-				sizeof(LiveObjectsD_CommandRequestHeader_t));
-		if (pReqWithoutArg == NULL) {
-			LOTRACE_ERR("no arg - MEM_ALLOC ERROR, len=%d", sizeof(LiveObjectsD_CommandRequestHeader_t));
-			return -6;
-		}
-		LOTRACE_NOTICE("no arg - MEM_ALLOC %p len=%d", pReqWithoutArg,
-				sizeof(LiveObjectsD_CommandRequestHeader_t));
 
-		pReqWithoutArg->cmd_blk_len = sizeof(LiveObjectsD_CommandRequestHeader_t);
-		pReqWithoutArg->cmd_ptr = cmd_ptr;
-		pReqWithoutArg->cmd_cid = *pCid;
-		pReqWithoutArg->cmd_args_nb = 0;
-
-		LOTRACE_INF("process command with empty arg");
-		ret = pSetCmd->cmd_callback((LiveObjectsD_CommandRequestBlock_t*) pReqWithoutArg);
+	*pCid = 0;
 
-		LOTRACE_NOTICE("no arg - MEM_FREE %p len=%d", pReqWithoutArg,
-				sizeof(LiveObjectsD_CommandRequestHeader_t));
-		MEM_FREE(pReqWithoutArg);
+	if (offset == 0) {
+		// the previous message may have been given up before its last piece
+		if ((_LOM_cmd_part.busy) && (_LOM_cmd_part.dec.pReqBlk)) {
+			cmd_blk_free(_LOM_cmd_part.dec.pReqBlk);
+		}
+		decode_cmd_init(&_LOM_cmd_part.dec, 1);
+		LO_json_reader_init(&_LOM_cmd_part.rd);
+		_LOM_cmd_part.busy = 1;
+	}
+	else if (!_LOM_cmd_part.busy) {
+		return -1;
 	}
+	LOTRACE_DBG1("piece at %"PRIu32", len=%"PRIu32"%s", offset, len, (last) ? " (last)" : "");
 
-	return ret;
+	*pConsumed = len;
+	ret = LO_json_parse_part(&_LOM_cmd_part.rd, data, len, last, decode_cmd_event, &_LOM_cmd_part.dec, pConsumed);
+	if (ret < 0) {
+		LOTRACE_ERR("ERROR %d returned by LO_json_parse_part, at offset %"PRIu32, ret, offset);
+	}
+	else if ((ret == 0) && (!last)) {
+		return 0;
+	}
+	_LOM_cmd_part.busy = 0;
+	ret = decode_cmd_result(&_LOM_cmd_part.dec, ret, pSetCmd, pCid);
+	return ((ret == 0) && (!last)) ? -1 : ret;
 }
+#endif /* LOC_MQTT_RCV_CHUNKED */
 #endif /* LOC_FEATURE_LO_COMMANDS */
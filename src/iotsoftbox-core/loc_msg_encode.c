@@ -33,8 +33,11 @@
 /*  */
 static const char* LO_msg_encode_status_buf(char* buf_ptr, uint32_t buf_len, const LOMArrayOfData_t* pObjSet) {
 	int ret, i;
+	LOJsonWriter_t jw;
 	const LiveObjectsD_Data_t* data_ptr;
-	ret = LO_json_begin_section(buf_ptr, buf_len, "info");
+
+	LO_json_init(&jw, buf_ptr, buf_len);
+	ret = LO_json_begin_section(&jw, "info");
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_begin)");
 		return NULL;
@@ -43,14 +46,14 @@ static const char* LO_msg_encode_status_buf(char* buf_ptr, uint32_t buf_len, con
 	for (i = 0; i < pObjSet->data_nb; i++) {
 		LOTRACE_DBG1("[%d] - data_type=%d=%s data_name=%s", i, data_ptr->data_type,
 				LO_getDataTypeToStr(data_ptr->data_type), data_ptr->data_name);
-		ret = LO_json_add_item(data_ptr, buf_ptr, buf_len);
+		ret = LO_json_add_item(&jw, data_ptr);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_add_item)");
 			return NULL;
 		}
 		data_ptr++;
 	}
-	ret = LO_json_end_section(buf_ptr, buf_len);
+	ret = LO_json_end_section(&jw);
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_end)");
 		return NULL;
@@ -58,50 +61,204 @@ static const char* LO_msg_encode_status_buf(char* buf_ptr, uint32_t buf_len, con
 	return buf_ptr;
 }
 
-/* --------------------------------------------------------------------------------- */
-/*  */
 #if LOC_FEATURE_LO_DATA
-static const char* LO_msg_encode_data_buf(char* buf_ptr, uint32_t buf_len, const LOMSetOfData_t* pSetData) {
+/* --------------------------------------------------------------------------------- */
+/* Constant head of a data message: {"s":"<stream id>","m":"<model>", */
+static int LO_msg_encode_data_head(LOJsonWriter_t* jw, const LOMSetOfData_t* pSetData) {
 	int ret;
 
-	ret = LO_json_begin(buf_ptr, buf_len);
+	ret = LO_json_begin(jw);
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_begin)");
 	}
 
 	if (ret == 0) {
 		// stream id
-		ret = LO_json_add_name_str("s", pSetData->stream_id, buf_ptr, buf_len);
+		ret = LO_json_add_name_str(jw, "s", pSetData->stream_id);
 		if (ret) {
 			LOTRACE_ERR("failed (stream_id)");
 		}
 	}
 
-	// timestamp
-	if ((ret == 0) && (pSetData->timestamp[0])) {
-		ret = LO_json_add_name_str("ts", pSetData->timestamp, buf_ptr, buf_len);
-		if (ret)
-			LOTRACE_ERR("failed (timestamp)");
-	}
-
 #if (LOM_SETOFDATA_MODEL_SZ > 0)
 	if (ret == 0) {
 		// model
-		ret = LO_json_add_name_str("m", pSetData->model, buf_ptr, buf_len);
+		ret = LO_json_add_name_str(jw, "m", pSetData->model);
 		if (ret)
 			LOTRACE_ERR("failed (model)");
 	}
 #endif
+	return ret;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Constant tail of a data message: "t":[<tags>], */
+static int LO_msg_encode_data_tail(LOJsonWriter_t* jw, const LOMSetOfData_t* pSetData) {
+	int ret = 0;
+#if (LOM_SETOFDATA_TAGS_SZ > 0)
+	if (pSetData->tags[0]) {
+		ret = LO_json_add_name_array(jw, "t", pSetData->tags);
+		if (ret)
+			LOTRACE_ERR("failed (LO_json_add_name_str(\"t\", ...)");
+	}
+#else
+	(void) jw;
+	(void) pSetData;
+#endif
+	return ret;
+}
+
+#if (LOM_SETOFDATA_FILTER_NB > 0) || (LOM_SETOFDATA_AGGR_NB > 0)
+/* --------------------------------------------------------------------------------- */
+/* Value of a numeric data item */
+static double LO_msg_data_value(const LiveObjectsD_Data_t* data_ptr) {
+	const void* p = data_ptr->data_value;
+	switch (data_ptr->data_type) {
+	case LOD_TYPE_INT32:
+		return *((const int32_t*) p);
+	case LOD_TYPE_INT16:
+		return *((const int16_t*) p);
+	case LOD_TYPE_INT8:
+		return *((const int8_t*) p);
+	case LOD_TYPE_UINT32:
+		return *((const uint32_t*) p);
+	case LOD_TYPE_UINT16:
+		return *((const uint16_t*) p);
+	case LOD_TYPE_UINT8:
+	case LOD_TYPE_BOOL:
+		return *((const uint8_t*) p);
+	case LOD_TYPE_FLOAT:
+		return *((const float*) p);
+	case LOD_TYPE_DOUBLE:
+		return *((const double*) p);
+	default:
+		return 0;
+	}
+}
+
+#endif
+
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+/* --------------------------------------------------------------------------------- */
+/*  */
+static LOMDataAggr_t* LO_msg_data_aggr_get(const LOMSetOfData_t* pSetData, int item) {
+	int i;
+	for (i = 0; i < LOM_SETOFDATA_AGGR_NB; i++) {
+		if ((pSetData->aggr[i].used) && (pSetData->aggr[i].item == item))
+			return (LOMDataAggr_t*) &pSetData->aggr[i];
+	}
+	return NULL;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Summary of an aggregated data item: {"min":..,"max":..,"avg":..,"count":..,"last":..}, */
+static int LO_msg_encode_data_aggr(LOJsonWriter_t* jw, const LiveObjectsD_Data_t* data_ptr,
+		const LOMDataAggr_t* pAggr) {
+	static const char* const names[] = { "min", "max", "avg", "count", "last" };
+	int ret;
+	int i;
+	union {
+		int32_t i32;
+		uint32_t u32;
+		float f;
+		double d;
+	} value;
+	LiveObjectsD_Data_t item;
+
+	item.data_value = &value;
+	item.data_dim = 1;
+	item.data_prec = data_ptr->data_prec;
+
+	ret = LO_json_add_raw(jw, "{", 1);
+	for (i = 0; (ret == 0) && (i < 5); i++) {
+		double v;
+		if ((pAggr->fields & (1 << i)) == 0)
+			continue;
+		switch (1 << i) {
+		case LOD_AGGR_MIN:
+			v = pAggr->min;
+			break;
+		case LOD_AGGR_MAX:
+			v = pAggr->max;
+			break;
+		case LOD_AGGR_AVG:
+			v = pAggr->mean;
+			break;
+		case LOD_AGGR_COUNT:
+			v = pAggr->count;
+			break;
+		default:
+			v = pAggr->last;
+			break;
+		}
+		item.data_name = names[i];
+		if ((1 << i) == LOD_AGGR_COUNT) {
+			item.data_type = LOD_TYPE_UINT32;
+			value.u32 = pAggr->count;
+		}
+		else if (data_ptr->data_type == LOD_TYPE_DOUBLE) {
+			item.data_type = LOD_TYPE_DOUBLE;
+			value.d = v;
+		}
+		else if ((data_ptr->data_type == LOD_TYPE_FLOAT) || ((1 << i) == LOD_AGGR_AVG)) {
+			item.data_type = LOD_TYPE_FLOAT;
+			value.f = (float) v;
+		}
+		else if (data_ptr->data_type == LOD_TYPE_UINT32) {
+			item.data_type = LOD_TYPE_UINT32;
+			value.u32 = (uint32_t) v;
+		}
+		else {
+			item.data_type = LOD_TYPE_INT32;
+			value.i32 = (int32_t) v;
+		}
+		ret = LO_json_add_item(jw, &item);
+	}
+	if (ret == 0)
+		ret = LO_json_add_section_end(jw);
+	return ret;
+}
+#endif
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static const char* LO_msg_encode_data_buf(char* buf_ptr, uint32_t buf_len, const LOMSetOfData_t* pSetData) {
+	int ret;
+	LOJsonWriter_t jw;
+#if (LOM_SETOFDATA_SKEL_SZ > 0)
+	const char* key_ptr = NULL;
+#endif
+
+	LO_json_init(&jw, buf_ptr, buf_len);
+
+#if (LOM_SETOFDATA_SKEL_SZ > 0)
+	if (pSetData->skel_head_len) {
+		// pre-rendered stream id and model
+		ret = LO_json_add_raw(&jw, pSetData->skel, pSetData->skel_head_len);
+		if (ret)
+			LOTRACE_ERR("failed (head)");
+		key_ptr = pSetData->skel + pSetData->skel_head_len + pSetData->skel_tail_len;
+	}
+	else
+#endif
+	ret = LO_msg_encode_data_head(&jw, pSetData);
+
+	// timestamp
+	if ((ret == 0) && (pSetData->timestamp[0])) {
+		ret = LO_json_add_name_str(&jw, "ts", pSetData->timestamp);
+		if (ret)
+			LOTRACE_ERR("failed (timestamp)");
+	}
 
 	// Add GPS localization
 	if ((ret == 0) && (pSetData->gps_ptr) && (pSetData->gps_ptr->gps_valid)) {
 		char msg[80];
 		snprintf(msg, sizeof(msg) - 1, "%3.6f,%3.6f", pSetData->gps_ptr->gps_lat, pSetData->gps_ptr->gps_long);
-		ret = LO_json_add_name_array("loc", msg, buf_ptr, buf_len);
+		ret = LO_json_add_name_array(&jw, "loc", msg);
 	}
 
 	if (ret == 0) {
-		ret = LO_json_add_section_start("v", buf_ptr, buf_len);
+		ret = LO_json_add_section_start(&jw, "v");
 		if (ret)
 			LOTRACE_ERR("failed (add section v)");
 	}
@@ -112,7 +269,53 @@ static const char* LO_msg_encode_data_buf(char* buf_ptr, uint32_t buf_len, const
 		for (i = 0; i < pSetData->data_set.data_nb; i++) {
 			LOTRACE_DBG1("[%d] - data_type=%d=%s data_name=%s", i, data_ptr->data_type,
 					LO_getDataTypeToStr(data_ptr->data_type), data_ptr->data_name);
-			ret = LO_json_add_item(data_ptr, buf_ptr, buf_len);
+#if (LOM_SETOFDATA_RBE_NB > 0)
+			if ((pSetData->rbe_enabled) && ((pSetData->rbe_dirty[i >> 3] & (1 << (i & 7))) == 0)) {
+				// unchanged since the last publish
+#if (LOM_SETOFDATA_SKEL_SZ > 0)
+				if (key_ptr)
+					key_ptr += 1 + (uint8_t) *key_ptr;
+#endif
+				data_ptr++;
+				continue;
+			}
+#endif
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+			const LOMDataAggr_t* pAggr = (pSetData->aggr_nb) ? LO_msg_data_aggr_get(pSetData, i) : NULL;
+			if ((pAggr) && (pAggr->count)) {
+				// summary of the window
+#if (LOM_SETOFDATA_SKEL_SZ > 0)
+				if (key_ptr) {
+					uint8_t key_len = (uint8_t) *key_ptr++;
+					ret = LO_json_add_raw(&jw, key_ptr, key_len);
+					key_ptr += key_len;
+				}
+				else
+#endif
+				{
+					ret = LO_json_add_raw(&jw, "\"", 1);
+					if (ret == 0)
+						ret = LO_json_add_raw(&jw, data_ptr->data_name, strlen(data_ptr->data_name));
+					if (ret == 0)
+						ret = LO_json_add_raw(&jw, "\":", 2);
+				}
+				if (ret == 0)
+					ret = LO_msg_encode_data_aggr(&jw, data_ptr, pAggr);
+			}
+			else
+#endif
+#if (LOM_SETOFDATA_SKEL_SZ > 0)
+			if (key_ptr) {
+				// pre-rendered "name":
+				uint8_t key_len = (uint8_t) *key_ptr++;
+				ret = LO_json_add_raw(&jw, key_ptr, key_len);
+				if (ret == 0)
+					ret = LO_json_add_value(&jw, data_ptr);
+				key_ptr += key_len;
+			}
+			else
+#endif
+			ret = LO_json_add_item(&jw, data_ptr);
 			if (ret) {
 				LOTRACE_ERR("failed (LO_json_add_item)");
 				break;
@@ -122,22 +325,25 @@ static const char* LO_msg_encode_data_buf(char* buf_ptr, uint32_t buf_len, const
 	}
 
 	if (ret == 0) {
-		ret = LO_json_add_section_end(buf_ptr, buf_len);
+		ret = LO_json_add_section_end(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (end section v)");
 		}
 	}
 
-#if (LOM_SETOFDATA_TAGS_SZ > 0)
-	if ((ret == 0) && (pSetData->tags[0])) {
-		ret = LO_json_add_name_array("t", pSetData->tags, buf_ptr, buf_len);
-		if (ret)
-			LOTRACE_ERR("failed (LO_json_add_name_str(\"t\", ...)");
-	}
+	if (ret == 0) {
+#if (LOM_SETOFDATA_SKEL_SZ > 0)
+		if (key_ptr) {
+			// pre-rendered tags
+			ret = LO_json_add_raw(&jw, pSetData->skel + pSetData->skel_head_len, pSetData->skel_tail_len);
+		}
+		else
 #endif
+		ret = LO_msg_encode_data_tail(&jw, pSetData);
+	}
 
 	if (ret == 0) {
-		ret = LO_json_end(buf_ptr, buf_len);
+		ret = LO_json_end(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_end)");
 		}
@@ -153,9 +359,11 @@ static const char* LO_msg_encode_data_buf(char* buf_ptr, uint32_t buf_len, const
 static const char* LO_msg_encode_resources_buf(char* buf_ptr, uint32_t buf_len,
 		const LOMSetOfResources_t* pSetResources) {
 	int ret, i;
+	LOJsonWriter_t jw;
 	const LiveObjectsD_Resource_t* rsc_ptr;
 
-	ret = LO_json_begin_section(buf_ptr, buf_len, "rsc");
+	LO_json_init(&jw, buf_ptr, buf_len);
+	ret = LO_json_begin_section(&jw, "rsc");
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_begin)");
 		return NULL;
@@ -164,22 +372,22 @@ static const char* LO_msg_encode_resources_buf(char* buf_ptr, uint32_t buf_len,
 	for (i = 0; i < pSetResources->rsc_nb; i++) {
 		LOTRACE_DBG1("[%d] - rsc_name=%s version=%s", i, rsc_ptr->rsc_name, rsc_ptr->rsc_version_ptr);
 		if (ret == 0) {
-			ret = LO_json_add_section_start(rsc_ptr->rsc_name, buf_ptr, buf_len);
+			ret = LO_json_add_section_start(&jw, rsc_ptr->rsc_name);
 		}
 		if (ret == 0) {
-			ret = LO_json_add_name_str("v", rsc_ptr->rsc_version_ptr, buf_ptr, buf_len);
+			ret = LO_json_add_name_str(&jw, "v", rsc_ptr->rsc_version_ptr);
 		}
 
 		// metadata section: empty
 		if (ret == 0) {
-			ret = LO_json_add_section_start("m", buf_ptr, buf_len);
+			ret = LO_json_add_section_start(&jw, "m");
 		}
 		if (ret == 0) {
-			ret = LO_json_add_section_end(buf_ptr, buf_len);
+			ret = LO_json_add_section_end(&jw);
 		}
 
 		if (ret == 0) {
-			ret = LO_json_add_section_end(buf_ptr, buf_len);
+			ret = LO_json_add_section_end(&jw);
 		}
 		if (ret) {
 			LOTRACE_ERR("failed (rsc[%d] - rsc_name=%s version=%s)", i, rsc_ptr->rsc_name,
@@ -188,7 +396,7 @@ static const char* LO_msg_encode_resources_buf(char* buf_ptr, uint32_t buf_len,
 		}
 		rsc_ptr++;
 	}
-	ret = LO_json_end_section(buf_ptr, buf_len);
+	ret = LO_json_end_section(&jw);
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_end)");
 		return NULL;
@@ -203,9 +411,11 @@ static const char* LO_msg_encode_resources_buf(char* buf_ptr, uint32_t buf_len,
 const char* LO_msg_encode_params_all_buf(char* buf_ptr, uint32_t buf_len, const LOMArrayOfParams_t* params_array,
 		int32_t cid) {
 	int ret, i;
+	LOJsonWriter_t jw;
 	const LiveObjectsD_Param_t* param_ptr;
 
-	ret = LO_json_begin_section(buf_ptr, buf_len, "cfg");
+	LO_json_init(&jw, buf_ptr, buf_len);
+	ret = LO_json_begin_section(&jw, "cfg");
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_begin)");
 		return NULL;
@@ -214,7 +424,7 @@ const char* LO_msg_encode_params_all_buf(char* buf_ptr, uint32_t buf_len, const
 	for (i = 0; i < params_array->param_nb; i++) {
 		LOTRACE_DBG1("[%d] - data_type=%d=%s data_name=%s ...", i, param_ptr->parm_data.data_type,
 				LO_getDataTypeToStr(param_ptr->parm_data.data_type), param_ptr->parm_data.data_name);
-		ret = LO_json_add_param(&param_ptr->parm_data, buf_ptr, buf_len);
+		ret = LO_json_add_param(&jw, &param_ptr->parm_data);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_add_param)");
 			return NULL;
@@ -224,27 +434,27 @@ const char* LO_msg_encode_params_all_buf(char* buf_ptr, uint32_t buf_len, const
 
 	if (cid) {
 		if (ret == 0) {
-			ret = LO_json_add_section_end(buf_ptr, buf_len);
+			ret = LO_json_add_section_end(&jw);
 			if (ret) {
 				LOTRACE_ERR("failed (LO_json_end_section)");
 			}
 		}
 
 		if (ret == 0) {
-			ret = LO_json_add_name_int("cid", cid, buf_ptr, buf_len);
+			ret = LO_json_add_name_int(&jw, "cid", cid);
 			if (ret) {
 				LOTRACE_ERR("failed while adding cid=%"PRIi32", rc=%d", cid, ret);
 			}
 		}
 		if (ret == 0) {
-			ret = LO_json_end(buf_ptr, buf_len);
+			ret = LO_json_end(&jw);
 			if (ret) {
 				LOTRACE_ERR("failed (LO_json_end)");
 			}
 		}
 	}
 	else {
-		ret = LO_json_end_section(buf_ptr, buf_len);
+		ret = LO_json_end_section(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_end)");
 			return NULL;
@@ -260,13 +470,15 @@ const char* LO_msg_encode_params_all_buf(char* buf_ptr, uint32_t buf_len, const
 static const char* LO_msg_encode_cmd_resp_buf(char* buf_ptr, uint32_t buf_len, int32_t cid,
 		const LiveObjectsD_Data_t* data_ptr, int data_nb) {
 	int ret;
+	LOJsonWriter_t jw;
 
 	if (cid == 0) {
 		LOTRACE_ERR("failed, invalid params cid=%"PRIu32, cid);
 		return NULL;
 	}
 
-	ret = LO_json_begin_section(buf_ptr, buf_len, "res");
+	LO_json_init(&jw, buf_ptr, buf_len);
+	ret = LO_json_begin_section(&jw, "res");
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_begin)");
 	}
@@ -277,7 +489,7 @@ static const char* LO_msg_encode_cmd_resp_buf(char* buf_ptr, uint32_t buf_len, i
 		for (i = 0; i < data_nb; i++) {
 			LOTRACE_DBG1("[%d] - data_type=%d=%s data_name=%s", i, p_data->data_type,
 					LO_getDataTypeToStr(p_data->data_type), p_data->data_name);
-			ret = LO_json_add_item(p_data, buf_ptr, buf_len);
+			ret = LO_json_add_item(&jw, p_data);
 			if (ret) {
 				LOTRACE_ERR("failed (LO_json_add_item)");
 				break;
@@ -287,19 +499,19 @@ static const char* LO_msg_encode_cmd_resp_buf(char* buf_ptr, uint32_t buf_len, i
 	}
 
 	if (ret == 0) {
-		ret = LO_json_add_section_end(buf_ptr, buf_len);
+		ret = LO_json_add_section_end(&jw);
 		if (ret)
 			LOTRACE_ERR("failed (LO_json_end_section)");
 	}
 
 	if (ret == 0) {
-		ret = LO_json_add_name_int("cid", cid, buf_ptr, buf_len);
+		ret = LO_json_add_name_int(&jw, "cid", cid);
 		if (ret)
 			LOTRACE_ERR("failed while adding cid=%"PRIi32", rc=%d", cid, ret);
 	}
 
 	if (ret == 0) {
-		ret = LO_json_end(buf_ptr, buf_len);
+		ret = LO_json_end(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_end)");
 		}
@@ -313,7 +525,19 @@ static const char* LO_msg_encode_cmd_resp_buf(char* buf_ptr, uint32_t buf_len, i
 /* --------------------------------------------------------------------------------- */
 /*  */
 
+#if LOM_ENCODE_IN_MQTT_BUF
+/* Payload area of the MQTT send buffer, given by LO_msg_encode_set_buffer() */
+static char*    _LO_msg_buf;
+static uint32_t _LO_msg_buf_sz;
+
+void LO_msg_encode_set_buffer(char* buf_ptr, uint32_t buf_sz) {
+	_LO_msg_buf = buf_ptr;
+	_LO_msg_buf_sz = (buf_ptr) ? buf_sz : 0;
+}
+#else
 static char _LO_msg_buf[LOM_JSON_BUF_SZ];
+#define _LO_msg_buf_sz   LOM_JSON_BUF_SZ
+#endif
 
 /* --------------------------------------------------------------------------------- */
 /*  */
@@ -330,13 +554,15 @@ static const char* lib_rsc_res[] = {
 
 const char* LO_msg_encode_rsc_result(int32_t cid, LiveObjectsD_ResourceRespCode_t result) {
 	int ret;
+	LOJsonWriter_t jw;
 
 	if (cid == 0) {
 		LOTRACE_ERR("failed, invalid params cid=%"PRIu32, cid);
 		return NULL;
 	}
 
-	ret = LO_json_begin(_LO_msg_buf, LOM_JSON_BUF_SZ);
+	LO_json_init(&jw, _LO_msg_buf, _LO_msg_buf_sz);
+	ret = LO_json_begin(&jw);
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_begin)");
 	}
@@ -347,8 +573,7 @@ const char* LO_msg_encode_rsc_result(int32_t cid, LiveObjectsD_ResourceRespCode_
 			res_idx = RSC_RSP_ERR_INTERNAL_ERROR;
 		LOTRACE_INF("cid=%"PRIi32", result=%d -> %d res=%s", cid, result, res_idx,
 				lib_rsc_res[res_idx]);
-		ret = LO_json_add_name_str("res", lib_rsc_res[res_idx], _LO_msg_buf,
-		LOM_JSON_BUF_SZ);
+		ret = LO_json_add_name_str(&jw, "res", lib_rsc_res[res_idx]);
 		if (ret) {
 			LOTRACE_ERR("failed while adding res=%d %d %s, rc=%d", result, res_idx,
 					lib_rsc_res[res_idx], ret);
@@ -356,14 +581,14 @@ const char* LO_msg_encode_rsc_result(int32_t cid, LiveObjectsD_ResourceRespCode_
 	}
 
 	if (ret == 0) {
-		ret = LO_json_add_name_int("cid", cid, _LO_msg_buf, LOM_JSON_BUF_SZ);
+		ret = LO_json_add_name_int(&jw, "cid", cid);
 		if (ret) {
 			LOTRACE_ERR("failed while adding cid=%"PRIi32", rc=%d", cid, ret);
 		}
 	}
 
 	if (ret == 0) {
-		ret = LO_json_end(_LO_msg_buf, LOM_JSON_BUF_SZ);
+		ret = LO_json_end(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_end)");
 		}
@@ -377,6 +602,7 @@ const char* LO_msg_encode_rsc_result(int32_t cid, LiveObjectsD_ResourceRespCode_
 #if LOC_FEATURE_LO_PARAMS
 const char* LO_msg_encode_params_update(const LOMSetofUpdatedParams_t* pParamUpdateSet) {
 	int ret;
+	LOJsonWriter_t jw;
 
 	if (pParamUpdateSet == NULL) {
 		LOTRACE_ERR("failed, invalid params pParamUpdateSet=%p", pParamUpdateSet);
@@ -392,8 +618,13 @@ const char* LO_msg_encode_params_update(const LOMSetofUpdatedParams_t* pParamUpd
 		LOTRACE_WARN("Empty");
 		return NULL;
 	}
+	if (pParamUpdateSet->nb_of_params > LOC_MAX_OF_PARSED_PARAMS) {
+		LOTRACE_WARN("%"PRIi32" updated params, only %u listed", pParamUpdateSet->nb_of_params, LOC_MAX_OF_PARSED_PARAMS);
+		return NULL;
+	}
 
-	ret = LO_json_begin_section(_LO_msg_buf, LOM_JSON_BUF_SZ, "cfg");
+	LO_json_init(&jw, _LO_msg_buf, _LO_msg_buf_sz);
+	ret = LO_json_begin_section(&jw, "cfg");
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_begin)");
 	}
@@ -410,7 +641,7 @@ const char* LO_msg_encode_params_update(const LOMSetofUpdatedParams_t* pParamUpd
 			}
 			LOTRACE_DBG1("[%d] - data_type=%d=%s data_name=%s ...", i, param_ptr->parm_data.data_type,
 					LO_getDataTypeToStr(param_ptr->parm_data.data_type), param_ptr->parm_data.data_name);
-			ret = LO_json_add_param(&param_ptr->parm_data, _LO_msg_buf, LOM_JSON_BUF_SZ);
+			ret = LO_json_add_param(&jw, &param_ptr->parm_data);
 			if (ret) {
 				LOTRACE_ERR("failed (LO_json_add_param)");
 				break;
@@ -418,22 +649,21 @@ const char* LO_msg_encode_params_update(const LOMSetofUpdatedParams_t* pParamUpd
 		}
 	}
 	if (ret == 0) {
-		ret = LO_json_add_section_end(_LO_msg_buf, LOM_JSON_BUF_SZ);
+		ret = LO_json_add_section_end(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_end_section)");
 		}
 	}
 
 	if (ret == 0) {
-		ret = LO_json_add_name_int("cid", pParamUpdateSet->cid, _LO_msg_buf,
-		LOM_JSON_BUF_SZ);
+		ret = LO_json_add_name_int(&jw, "cid", pParamUpdateSet->cid);
 		if (ret) {
 			LOTRACE_ERR("failed while adding cid=%"PRIi32", rc=%d", pParamUpdateSet->cid, ret);
 		}
 	}
 
 	if (ret == 0) {
-		ret = LO_json_end(_LO_msg_buf, LOM_JSON_BUF_SZ);
+		ret = LO_json_end(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_end)");
 		}
@@ -449,18 +679,23 @@ static const char* lib_res[] = {
 	"Invalid",
 	"Bad format",
 	"Not supported",
-	"Not processed"
+	"Not processed",
+	"Error",
+	"No memory",
+	"Busy"
 };
 
 const char* LO_msg_encode_cmd_result(int32_t cid, int result) {
 	int ret;
+	LOJsonWriter_t jw;
 
 	if (cid == 0) {
 		LOTRACE_ERR("failed, invalid params cid=%"PRIu32, cid);
 		return NULL;
 	}
 
-	ret = LO_json_begin_section(_LO_msg_buf, LOM_JSON_BUF_SZ, "res");
+	LO_json_init(&jw, _LO_msg_buf, _LO_msg_buf_sz);
+	ret = LO_json_begin_section(&jw, "res");
 	if (ret) {
 		LOTRACE_ERR("failed (LO_json_begin)");
 	}
@@ -469,41 +704,39 @@ const char* LO_msg_encode_cmd_result(int32_t cid, int result) {
 		if (result < 0) {
 			int err_idx = -result - 1;
 			LOTRACE_WARN("ERROR result=%d  err_idx=%d", result, err_idx);
-			ret = LO_json_add_name_int("lom_err_code", result, _LO_msg_buf,
-			LOM_JSON_BUF_SZ);
+			ret = LO_json_add_name_int(&jw, "lom_err_code", result);
 			if (ret) {
 				LOTRACE_ERR("failed (LO_json_end_section)");
 			}
 
-			if ((ret == 0) && (err_idx >= 0) && (err_idx < 4)) {
-				ret = LO_json_add_name_str("lom_error", lib_res[err_idx], _LO_msg_buf,
-				LOM_JSON_BUF_SZ);
+			if ((ret == 0) && (err_idx >= 0) && (err_idx < (int) (sizeof(lib_res) / sizeof(lib_res[0])))) {
+				ret = LO_json_add_name_str(&jw, "lom_error", lib_res[err_idx]);
 			}
 		}
 		else if (result > 0) { // User code
-			ret = LO_json_add_name_int("result", result, _LO_msg_buf, LOM_JSON_BUF_SZ);
+			ret = LO_json_add_name_int(&jw, "result", result);
 		}
 		else { /* result == 0,  Not called => pending request; Delayed response procssed by user. */
-			; /* ret = LO_json_add_name_str("status", "pending", _LO_msg_buf, LOM_JSON_BUF_SZ); */
+			; /* ret = LO_json_add_name_str(&jw, "status", "pending"); */
 		}
 	}
 
 	if (ret == 0) {
-		ret = LO_json_add_section_end(_LO_msg_buf, LOM_JSON_BUF_SZ);
+		ret = LO_json_add_section_end(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_end_section)");
 		}
 	}
 
 	if (ret == 0) {
-		ret = LO_json_add_name_int("cid", cid, _LO_msg_buf, LOM_JSON_BUF_SZ);
+		ret = LO_json_add_name_int(&jw, "cid", cid);
 		if (ret) {
 			LOTRACE_ERR("failed while adding cid=%"PRIi32", rc=%d", cid, ret);
 		}
 	}
 
 	if (ret == 0) {
-		ret = LO_json_end(_LO_msg_buf, LOM_JSON_BUF_SZ);
+		ret = LO_json_end(&jw);
 		if (ret) {
 			LOTRACE_ERR("failed (LO_json_end)");
 		}
@@ -552,7 +785,7 @@ const char* LO_msg_encode_cmd_resp(uint8_t from, int32_t cid, const LiveObjectsD
 
 	const char *p_msg;
 	if (from == 0) { /* Called by the LOM Client Thread. */
-		p_msg = LO_msg_encode_cmd_resp_buf(_LO_msg_buf, LOM_JSON_BUF_SZ, cid, data_ptr, data_nb);
+		p_msg = LO_msg_encode_cmd_resp_buf(_LO_msg_buf, _LO_msg_buf_sz, cid, data_ptr, data_nb);
 	}
 	else {
 #if LOM_ENCODE_MQUEUE
@@ -591,7 +824,7 @@ const char* LO_msg_encode_status(uint8_t from, const LOMArrayOfData_t* pObjSet)
 	}
 
 	if (from == 0) { /* Called by the LiveObjects Client Thread. */
-		p_msg = LO_msg_encode_status_buf(_LO_msg_buf, LOM_JSON_BUF_SZ, pObjSet);
+		p_msg = LO_msg_encode_status_buf(_LO_msg_buf, _LO_msg_buf_sz, pObjSet);
 	}
 	else {
 #if LOM_ENCODE_MQUEUE
@@ -630,7 +863,7 @@ const char* LO_msg_encode_data(uint8_t from, const LOMSetOfData_t* pSetData) {
 		return NULL;
 	}
 	if (from == 0) { // Called by the LiveObjects Client Thread.
-		p_msg = LO_msg_encode_data_buf(_LO_msg_buf, LOM_JSON_BUF_SZ, pSetData);
+		p_msg = LO_msg_encode_data_buf(_LO_msg_buf, _LO_msg_buf_sz, pSetData);
 	}
 	else {
 #if LOM_ENCODE_MQUEUE
@@ -651,8 +884,418 @@ const char* LO_msg_encode_data(uint8_t from, const LOMSetOfData_t* pSetData) {
 	}
 	return p_msg;
 }
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_encode_data_skeleton(LOMSetOfData_t* pSetData) {
+#if (LOM_SETOFDATA_SKEL_SZ > 0)
+	int ret;
+	int i;
+	uint32_t head_len;
+	uint32_t tail_len;
+	LOJsonWriter_t jw;
+	const LiveObjectsD_Data_t* data_ptr;
+
+	if (pSetData == NULL) {
+		return -1;
+	}
+	pSetData->skel_head_len = 0;
+	pSetData->skel_tail_len = 0;
+	if ((pSetData->stream_id[0] == 0) || (pSetData->data_set.data_ptr == NULL)) {
+		return -1;
+	}
+
+	LO_json_init(&jw, pSetData->skel, sizeof(pSetData->skel));
+	ret = LO_msg_encode_data_head(&jw, pSetData);
+	head_len = jw.len;
+	if (ret == 0) {
+		ret = LO_msg_encode_data_tail(&jw, pSetData);
+	}
+	tail_len = jw.len - head_len;
+
+	// "name": keys, each one preceded by its length
+	data_ptr = pSetData->data_set.data_ptr;
+	for (i = 0; (ret == 0) && (i < pSetData->data_set.data_nb); i++, data_ptr++) {
+		uint32_t len = (data_ptr->data_name) ? strlen(data_ptr->data_name) : 0;
+		char key_len = (char) (len + 3);
+		if ((len == 0) || ((len + 3) > 255) || ((jw.len + len + 4) >= jw.buf_sz)) {
+			ret = -1;
+			break;
+		}
+		ret = LO_json_add_raw(&jw, &key_len, 1);
+		if (ret == 0)
+			ret = LO_json_add_raw(&jw, "\"", 1);
+		if (ret == 0)
+			ret = LO_json_add_raw(&jw, data_ptr->data_name, len);
+		if (ret == 0)
+			ret = LO_json_add_raw(&jw, "\":", 2);
+	}
+	if (ret) {
+		LOTRACE_WARN("%s: skeleton not used (LOM_SETOFDATA_SKEL_SZ=%u too small ?)", pSetData->stream_id,
+				LOM_SETOFDATA_SKEL_SZ);
+		return -1;
+	}
+
+	pSetData->skel_tail_len = (uint16_t) tail_len;
+	pSetData->skel_head_len = (uint16_t) head_len;
+	LOTRACE_DBG1("%s: skeleton %"PRIu32" bytes", pSetData->stream_id, jw.len);
+	return 0;
+#else
+	(void) pSetData;
+	return -1;
+#endif
+}
 #endif /* LOC_FEATURE_LO_DATA */
 
+/* --------------------------------------------------------------------------------- */
+/*  */
+#if LOC_FEATURE_LO_DATA && (LOM_SETOFDATA_RBE_NB > 0)
+/* FNV-1a hash of the value(s) of a data item */
+static uint32_t LO_msg_data_hash(const LiveObjectsD_Data_t* data_ptr) {
+	uint32_t h = 2166136261UL;
+	const uint8_t* pc = (const uint8_t*) data_ptr->data_value;
+	uint32_t len;
+
+	if ((pc == NULL) || (data_ptr->data_dim <= 0))
+		return 0;
+
+	switch (data_ptr->data_type) {
+	case LOD_TYPE_INT32:
+	case LOD_TYPE_UINT32:
+	case LOD_TYPE_FLOAT:
+		len = 4;
+		break;
+	case LOD_TYPE_INT16:
+	case LOD_TYPE_UINT16:
+		len = 2;
+		break;
+	case LOD_TYPE_DOUBLE:
+		len = 8;
+		break;
+	case LOD_TYPE_STRING_C:
+		len = strlen((const char*) pc);
+		break;
+	default:
+		len = 1;
+		break;
+	}
+	if (data_ptr->data_type != LOD_TYPE_STRING_C)
+		len *= data_ptr->data_dim;
+
+	while (len--) {
+		h ^= *pc++;
+		h *= 16777619UL;
+	}
+	return h;
+}
+#endif /* LOC_FEATURE_LO_DATA && LOM_SETOFDATA_RBE_NB */
+
+#if LOC_FEATURE_LO_DATA && (LOM_SETOFDATA_FILTER_NB > 0)
+/* --------------------------------------------------------------------------------- */
+/*  */
+static LOMDataFilter_t* LO_msg_data_filter_get(LOMSetOfData_t* pSetData, int item) {
+	int i;
+	for (i = 0; i < LOM_SETOFDATA_FILTER_NB; i++) {
+		if ((pSetData->filter[i].used) && (pSetData->filter[i].item == item))
+			return &pSetData->filter[i];
+	}
+	return NULL;
+}
+
+/* --------------------------------------------------------------------------------- */
+/* Return 1 if the filtered data item has to be published */
+static uint8_t LO_msg_data_filter_due(LOMDataFilter_t* pFilter, const LiveObjectsD_Data_t* data_ptr) {
+	double delta;
+	double band;
+
+	if (!pFilter->valid)
+		return 1;
+	if ((pFilter->max_ms) && (TimerIsExpired(&pFilter->tmr_max)))
+		return 1;
+	if ((pFilter->min_ms) && (!TimerIsExpired(&pFilter->tmr_min)))
+		return 0;
+
+	delta = LO_msg_data_value(data_ptr) - pFilter->last_value;
+	if (delta < 0)
+		delta = -delta;
+	band = pFilter->deadband;
+	if (pFilter->percent) {
+		band *= ((pFilter->last_value < 0) ? -pFilter->last_value : pFilter->last_value) / 100;
+	}
+	return (delta > band) ? 1 : 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_data_filter_set(LOMSetOfData_t* pSetData, int item, float deadband, uint8_t percent,
+		uint32_t min_ms, uint32_t max_ms) {
+	LOMDataFilter_t* pFilter;
+	const LiveObjectsD_Data_t* data_ptr;
+
+	if ((item < 0) || (item >= pSetData->data_set.data_nb) || (item > 255)) {
+		LOTRACE_ERR("%s: invalid item %d", pSetData->stream_id, item);
+		return -1;
+	}
+	data_ptr = &pSetData->data_set.data_ptr[item];
+	pFilter = LO_msg_data_filter_get(pSetData, item);
+
+	if (deadband < 0) {
+		if (pFilter) {
+			pFilter->used = 0;
+			pSetData->filter_nb--;
+		}
+		return 0;
+	}
+
+	if ((data_ptr->data_dim != 1) || (data_ptr->data_type == LOD_TYPE_STRING_C)
+			|| (data_ptr->data_type <= LOD_TYPE_UNKNOWN) || (data_ptr->data_type >= LOD_TYPE_MAX_NOT_USED)) {
+		LOTRACE_ERR("%s: item %d (%s) is not a numeric value", pSetData->stream_id, item, data_ptr->data_name);
+		return -1;
+	}
+
+	if (pFilter == NULL) {
+		int i;
+		for (i = 0; i < LOM_SETOFDATA_FILTER_NB; i++) {
+			if (!pSetData->filter[i].used) {
+				pFilter = &pSetData->filter[i];
+				break;
+			}
+		}
+		if (pFilter == NULL) {
+			LOTRACE_ERR("%s: no more filter (LOM_SETOFDATA_FILTER_NB=%u)", pSetData->stream_id,
+					LOM_SETOFDATA_FILTER_NB);
+			return -1;
+		}
+		memset(pFilter, 0, sizeof(LOMDataFilter_t));
+		pFilter->used = 1;
+		pFilter->item = (uint8_t) item;
+		pSetData->filter_nb++;
+	}
+	pFilter->deadband = deadband;
+	pFilter->percent = (percent) ? 1 : 0;
+	pFilter->min_ms = min_ms;
+	pFilter->max_ms = max_ms;
+	pFilter->valid = 0;
+	return 0;
+}
+#endif /* LOC_FEATURE_LO_DATA && LOM_SETOFDATA_FILTER_NB */
+
+#if LOC_FEATURE_LO_DATA && (LOM_SETOFDATA_AGGR_NB > 0)
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_data_aggr_set(LOMSetOfData_t* pSetData, int item, uint8_t fields) {
+	LOMDataAggr_t* pAggr;
+	const LiveObjectsD_Data_t* data_ptr;
+
+	if ((item < 0) || (item >= pSetData->data_set.data_nb) || (item > 255)) {
+		LOTRACE_ERR("%s: invalid item %d", pSetData->stream_id, item);
+		return -1;
+	}
+	data_ptr = &pSetData->data_set.data_ptr[item];
+	pAggr = LO_msg_data_aggr_get(pSetData, item);
+
+	if ((fields & LOD_AGGR_ALL) == 0) {
+		if (pAggr) {
+			pAggr->used = 0;
+			pSetData->aggr_nb--;
+		}
+		return 0;
+	}
+
+	if ((data_ptr->data_dim != 1) || (data_ptr->data_type == LOD_TYPE_STRING_C)
+			|| (data_ptr->data_type == LOD_TYPE_BOOL) || (data_ptr->data_type <= LOD_TYPE_UNKNOWN)
+			|| (data_ptr->data_type >= LOD_TYPE_MAX_NOT_USED)) {
+		LOTRACE_ERR("%s: item %d (%s) is not a numeric value", pSetData->stream_id, item, data_ptr->data_name);
+		return -1;
+	}
+
+	if (pAggr == NULL) {
+		int i;
+		for (i = 0; i < LOM_SETOFDATA_AGGR_NB; i++) {
+			if (!pSetData->aggr[i].used) {
+				pAggr = &pSetData->aggr[i];
+				break;
+			}
+		}
+		if (pAggr == NULL) {
+			LOTRACE_ERR("%s: no more aggregation (LOM_SETOFDATA_AGGR_NB=%u)", pSetData->stream_id,
+					LOM_SETOFDATA_AGGR_NB);
+			return -1;
+		}
+		memset(pAggr, 0, sizeof(LOMDataAggr_t));
+		pAggr->used = 1;
+		pAggr->item = (uint8_t) item;
+		pSetData->aggr_nb++;
+	}
+	pAggr->fields = fields & LOD_AGGR_ALL;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_data_aggr_sample(LOMSetOfData_t* pSetData) {
+	int i;
+
+	if (pSetData->aggr_nb == 0)
+		return 0;
+
+	if (!pSetData->aggr_started) {
+		pSetData->aggr_started = 1;
+		if (pSetData->aggr_window_ms)
+			TimerCountdownMS(&pSetData->aggr_tmr, pSetData->aggr_window_ms);
+	}
+
+	for (i = 0; i < LOM_SETOFDATA_AGGR_NB; i++) {
+		LOMDataAggr_t* pAggr = &pSetData->aggr[i];
+		double v;
+		if ((!pAggr->used) || (pAggr->item >= pSetData->data_set.data_nb))
+			continue;
+		v = LO_msg_data_value(&pSetData->data_set.data_ptr[pAggr->item]);
+		if (pAggr->count == 0) {
+			pAggr->min = v;
+			pAggr->max = v;
+			pAggr->mean = v;
+		}
+		else {
+			if (v < pAggr->min)
+				pAggr->min = v;
+			if (v > pAggr->max)
+				pAggr->max = v;
+			// running mean: no sum to overflow or to lose the small samples
+			pAggr->mean += (v - pAggr->mean) / (pAggr->count + 1);
+		}
+		pAggr->last = v;
+		pAggr->count++;
+	}
+
+	return ((pSetData->aggr_window_ms) && (TimerIsExpired(&pSetData->aggr_tmr))) ? 1 : 0;
+}
+#endif /* LOC_FEATURE_LO_DATA && LOM_SETOFDATA_AGGR_NB */
+
+#if LOC_FEATURE_LO_DATA && LOM_SETOFDATA_CHECK
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_msg_data_check(LOMSetOfData_t* pSetData) {
+	int i;
+	int nb = 0;
+	int due = 0;
+	uint8_t rbe = 0;
+	uint8_t full = 0;
+	const LiveObjectsD_Data_t* data_ptr = pSetData->data_set.data_ptr;
+
+#if (LOM_SETOFDATA_RBE_NB > 0)
+	rbe = (pSetData->rbe_enabled) && (pSetData->data_set.data_nb <= LOM_SETOFDATA_RBE_NB);
+	if (rbe) {
+		full = !pSetData->rbe_valid;
+		if ((pSetData->rbe_full_every) && (++pSetData->rbe_push_cnt >= pSetData->rbe_full_every)) {
+			full = 1;
+		}
+	}
+#endif
+#if (LOM_SETOFDATA_FILTER_NB > 0)
+	if ((!rbe) && (pSetData->filter_nb == 0))
+#else
+	if (!rbe)
+#endif
+		return pSetData->data_set.data_nb;
+
+	for (i = 0; i < pSetData->data_set.data_nb; i++, data_ptr++) {
+		uint8_t changed = full;
+#if (LOM_SETOFDATA_FILTER_NB > 0)
+		LOMDataFilter_t* pFilter = (pSetData->filter_nb) ? LO_msg_data_filter_get(pSetData, i) : NULL;
+#endif
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+		LOMDataAggr_t* pAggr = (pSetData->aggr_nb) ? LO_msg_data_aggr_get(pSetData, i) : NULL;
+#endif
+#if (LOM_SETOFDATA_FILTER_NB > 0)
+		if (pFilter) {
+			if (LO_msg_data_filter_due(pFilter, data_ptr))
+				changed = 1;
+		}
+		else
+#endif
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+		if (pAggr) {
+			if ((rbe) && (pAggr->count))
+				changed = 1;
+		}
+		else
+#endif
+		{
+#if (LOM_SETOFDATA_RBE_NB > 0)
+			if (rbe) {
+				uint32_t h = LO_msg_data_hash(data_ptr);
+				if (h != pSetData->rbe_hash[i])
+					changed = 1;
+				pSetData->rbe_hash[i] = h;
+			}
+			else
+#endif
+			// without report-by-exception, a change can not be detected: always to be published
+			changed = 1;
+		}
+		if (changed)
+			due++;
+#if (LOM_SETOFDATA_RBE_NB > 0)
+		if (rbe) {
+			if (changed)
+				pSetData->rbe_dirty[i >> 3] |= (1 << (i & 7));
+			if (pSetData->rbe_dirty[i >> 3] & (1 << (i & 7)))
+				nb++;
+		}
+#endif
+	}
+
+#if (LOM_SETOFDATA_RBE_NB > 0)
+	if (full) {
+		pSetData->rbe_valid = 1;
+		pSetData->rbe_push_cnt = 0;
+	}
+#endif
+	if (!rbe)
+		nb = (due) ? pSetData->data_set.data_nb : 0;
+
+	LOTRACE_DBG1("%s: %d data items changed, %d/%d to publish (full=%u)", pSetData->stream_id, due, nb,
+			pSetData->data_set.data_nb, full);
+	return nb;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void LO_msg_data_done(LOMSetOfData_t* pSetData) {
+#if (LOM_SETOFDATA_FILTER_NB > 0) || (LOM_SETOFDATA_AGGR_NB > 0)
+	int i;
+#endif
+#if (LOM_SETOFDATA_FILTER_NB > 0)
+	for (i = 0; (pSetData->filter_nb) && (i < LOM_SETOFDATA_FILTER_NB); i++) {
+		LOMDataFilter_t* pFilter = &pSetData->filter[i];
+		int item = pFilter->item;
+		if ((!pFilter->used) || (item >= pSetData->data_set.data_nb))
+			continue;
+#if (LOM_SETOFDATA_RBE_NB > 0)
+		if ((pSetData->rbe_enabled) && ((pSetData->rbe_dirty[item >> 3] & (1 << (item & 7))) == 0))
+			continue; // not encoded
+#endif
+		pFilter->last_value = LO_msg_data_value(&pSetData->data_set.data_ptr[item]);
+		pFilter->valid = 1;
+		if (pFilter->min_ms)
+			TimerCountdownMS(&pFilter->tmr_min, pFilter->min_ms);
+		if (pFilter->max_ms)
+			TimerCountdownMS(&pFilter->tmr_max, pFilter->max_ms);
+	}
+#endif
+#if (LOM_SETOFDATA_AGGR_NB > 0)
+	for (i = 0; (pSetData->aggr_nb) && (i < LOM_SETOFDATA_AGGR_NB); i++) {
+		pSetData->aggr[i].count = 0;
+	}
+	pSetData->aggr_started = 0;
+#endif
+#if (LOM_SETOFDATA_RBE_NB > 0)
+	memset(pSetData->rbe_dirty, 0, sizeof(pSetData->rbe_dirty));
+#endif
+}
+#endif /* LOC_FEATURE_LO_DATA && LOM_SETOFDATA_CHECK */
+
 /* --------------------------------------------------------------------------------- */
 /*  */
 #if LOC_FEATURE_LO_RESOURCES
@@ -669,7 +1312,7 @@ const char* LO_msg_encode_resources(uint8_t from, const LOMSetOfResources_t* pSe
 	}
 
 	if (from == 0) { // Called by the LiveObjects Client Thread.
-		p_msg = LO_msg_encode_resources_buf(_LO_msg_buf, LOM_JSON_BUF_SZ, pSetResources);
+		p_msg = LO_msg_encode_resources_buf(_LO_msg_buf, _LO_msg_buf_sz, pSetResources);
 	}
 	else {
 #if LOM_ENCODE_MQUEUE
@@ -706,7 +1349,7 @@ const char* LO_msg_encode_params_all(uint8_t from, const LOMArrayOfParams_t* par
 		return NULL;
 	}
 	if (from == 0) { // Called by the LiveObjects Client Thread.
-		p_msg = LO_msg_encode_params_all_buf(_LO_msg_buf, LOM_JSON_BUF_SZ, params_array, cid);
+		p_msg = LO_msg_encode_params_all_buf(_LO_msg_buf, _LO_msg_buf_sz, params_array, cid);
 	}
 	else {
 #if LOM_ENCODE_MQUEUE
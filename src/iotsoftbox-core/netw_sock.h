@@ -46,6 +46,12 @@ int f_netw_sock_connect(Network *pNetwork, const char* RemoteHostAddress, uint16
 
 int f_netw_sock_send(void *pNetwork, const unsigned char *buf, size_t len);
 
+#if defined(LOC_NETW_SOCK_SENDV)
+/* Send the segments of one packet (at most NETW_SOCK_VEC_MAX), return the number of bytes sent */
+#define NETW_SOCK_VEC_MAX                4
+int f_netw_sock_sendv(void *pNetwork, const NetworkVec *vec, int nb);
+#endif
+
 int f_netw_sock_recv(void *pNetwork, unsigned char *buf, size_t len);
 
 int f_netw_sock_recv_timeout(void *pNetwork, unsigned char *buf, size_t len, uint32_t tmo);
@@ -24,15 +24,113 @@
 #include "platform_default.h"
 
 #if (LOC_MQTT_DUMP_MSG & 0x02)
-void LOCC_mqtt_dump_msg(const unsigned char* p_buf);
+void LOCC_mqtt_dump_msg(const unsigned char* p_buf, const unsigned char* p_payload);
 #endif
 
+#if (LOC_NETW_RCV_BUF_SZ > 0)
+/* Receive buffer: filled by one read of all that the link has (up to its size), when it is empty.
+ * The MQTT client reads the fixed header byte per byte, then the rest of the packet:
+ * these small reads are served from this buffer. */
+static struct {
+	uint16_t rd;
+	uint16_t wr;
+	unsigned char buf[LOC_NETW_RCV_BUF_SZ];
+} _netw_rcv;
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int netw_rcv_get(unsigned char *pMsg, int len) {
+	int n = _netw_rcv.wr - _netw_rcv.rd;
+	if (n > len) {
+		n = len;
+	}
+	memcpy(pMsg, _netw_rcv.buf + _netw_rcv.rd, n);
+	_netw_rcv.rd += (uint16_t) n;
+	return n;
+}
+#endif
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void netw_rcv_reset(void) {
+#if (LOC_NETW_RCV_BUF_SZ > 0)
+	_netw_rcv.rd = 0;
+	_netw_rcv.wr = 0;
+#endif
+}
+
+#if (LOC_NETW_SND_BUF_SZ > 0)
+/* Transmit buffer: the packets written by the MQTT client are gathered here, and sent by one write
+ * (i.e. one modem transaction) before the next read of the MQTT client (waiting for a response),
+ * when the next packet does not fit, or by netw_flush (end of the LiveObjects Client cycle).
+ * A PUBLISH packet written in segments (netw_mqtt_writev) is not gathered: it is sent directly, after them.
+ * A sending error is kept until it is returned by netw_flush. */
+static struct {
+	uint16_t len;
+	int err;
+	unsigned char buf[LOC_NETW_SND_BUF_SZ];
+} _netw_snd;
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int netw_snd_flush(Network *pNetwork) {
+	int sent = 0;
+	while (sent < _netw_snd.len) {
+		int ret = f_netw_sock_send(pNetwork, _netw_snd.buf + sent, _netw_snd.len - sent);
+		if (ret <= 0) {
+			LOTRACE_ERR("(len=%d) ERROR %d after %d bytes", _netw_snd.len, ret, sent);
+			_netw_snd.len = 0;
+			_netw_snd.err = (ret < 0) ? ret : NETW_ERR_NET_SEND_FAILED;
+			return _netw_snd.err;
+		}
+		sent += ret;
+	}
+	LOTRACE_DBG1("(len=%d) sent", sent);
+	_netw_snd.len = 0;
+	return 0;
+}
+#endif
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void netw_snd_reset(void) {
+#if (LOC_NETW_SND_BUF_SZ > 0)
+	_netw_snd.len = 0;
+	_netw_snd.err = 0;
+#endif
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int netw_flush(Network *pNetwork) {
+#if (LOC_NETW_SND_BUF_SZ > 0)
+	int ret;
+	if (_netw_snd.len > 0) {
+		netw_snd_flush(pNetwork);
+	}
+	ret = _netw_snd.err;
+	_netw_snd.err = 0;
+	return ret;
+#else
+	(void) pNetwork;
+	return 0;
+#endif
+}
+
 /* --------------------------------------------------------------------------------- */
 /*  */
 void netw_disconnect(Network *pNetwork, int mode) {
 	if (f_netw_sock_isOpen(pNetwork)) {
+#if (LOC_NETW_SND_BUF_SZ > 0)
+		/* last packets (MQTT DISCONNECT) */
+		if ((_netw_snd.len > 0) && (!f_netw_sock_isLost(pNetwork))) {
+			netw_snd_flush(pNetwork);
+		}
+#endif
 		f_netw_sock_close(pNetwork);
 	}
+	netw_rcv_reset();
+	netw_snd_reset();
 	LOTRACE_INF("RESET");
 }
 
@@ -52,7 +150,22 @@ int netw_mqtt_write(Network *pNetwork, unsigned char *pMsg, int len, int timeout
 	LOTRACE_DBG1("(%p/%p, len=%d,timeout_ms=%d) ...", pNetwork, pNetwork->my_socket, len, timeout_ms);
 
 #if (LOC_MQTT_DUMP_MSG & 0x02)
-	LOCC_mqtt_dump_msg(pMsg);
+	LOCC_mqtt_dump_msg(pMsg, NULL);
+#endif
+
+#if (LOC_NETW_SND_BUF_SZ > 0)
+	if (_netw_snd.len + len > LOC_NETW_SND_BUF_SZ) {
+		written = netw_snd_flush(pNetwork);
+		if (written < 0) {
+			return written;
+		}
+	}
+	if (len <= LOC_NETW_SND_BUF_SZ) {
+		memcpy(_netw_snd.buf + _netw_snd.len, pMsg, len);
+		_netw_snd.len += (uint16_t) len;
+		return len;
+	}
+	/* larger than the transmit buffer: sent directly */
 #endif
 
 	written = f_netw_sock_send(pNetwork, pMsg, len);
@@ -65,6 +178,46 @@ int netw_mqtt_write(Network *pNetwork, unsigned char *pMsg, int len, int timeout
 	return written;
 }
 
+#if defined(LOC_NETW_SOCK_SENDV)
+/* --------------------------------------------------------------------------------- */
+/* Write a packet given in segments: header in the MQTT send buffer, payload from the user memory */
+int netw_mqtt_writev(Network *pNetwork, const NetworkVec *vec, int nb, int timeout_ms) {
+	int written = 0;
+	int len = 0;
+	int i;
+
+	for (i = 0; i < nb; i++) {
+		len += vec[i].len;
+	}
+	LOTRACE_DBG1("(%p/%p, nb=%d, len=%d,timeout_ms=%d) ...", pNetwork, pNetwork->my_socket, nb, len, timeout_ms);
+
+#if (LOC_MQTT_DUMP_MSG & 0x02)
+	if (nb == 2) {
+		LOCC_mqtt_dump_msg(vec[0].buf, vec[1].buf);
+	}
+#endif
+
+#if (LOC_NETW_SND_BUF_SZ > 0)
+	/* the payload is not copied in the transmit buffer: the packets waiting in it are sent before */
+	if (_netw_snd.len > 0) {
+		written = netw_snd_flush(pNetwork);
+		if (written < 0) {
+			return written;
+		}
+	}
+#endif
+
+	written = f_netw_sock_sendv(pNetwork, vec, nb);
+	if (written < 0) {
+		LOTRACE_ERR("(nb=%d, len=%d,timeout_ms=%d) ERROR %d", nb, len, timeout_ms, written);
+		return written;
+	}
+
+	LOTRACE_DBG1("(len=%d,timeout_ms=%d) -> written=%d", len, timeout_ms, written);
+	return written;
+}
+#endif
+
 /* --------------------------------------------------------------------------------- */
 /*  */
 int netw_mqtt_read(Network *pNetwork, unsigned char *pMsg, int len, int timeout_ms) {
@@ -72,7 +225,35 @@ int netw_mqtt_read(Network *pNetwork, unsigned char *pMsg, int len, int timeout_
 
 	/* LOTRACE_DBG_VERBOSE("(%p/%p, len=%d,timeout_ms=%d) ...",  pNetwork, pNetwork->my_socket, len, timeout_ms); */
 
+#if (LOC_NETW_SND_BUF_SZ > 0)
+	/* the written packets are sent before waiting for a response */
+	if (_netw_snd.len > 0) {
+		ret = netw_snd_flush(pNetwork);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+#endif
+
+#if (LOC_NETW_RCV_BUF_SZ > 0)
+	if (_netw_rcv.rd < _netw_rcv.wr) {
+		ret = netw_rcv_get(pMsg, len);
+	}
+	else if (len >= LOC_NETW_RCV_BUF_SZ) {
+		/* large read (payload): directly in the caller buffer */
+		ret = f_netw_sock_recv_timeout(pNetwork, pMsg, len, timeout_ms);
+	}
+	else {
+		ret = f_netw_sock_recv_timeout(pNetwork, _netw_rcv.buf, LOC_NETW_RCV_BUF_SZ, timeout_ms);
+		if (ret > 0) {
+			_netw_rcv.rd = 0;
+			_netw_rcv.wr = (uint16_t) ret;
+			ret = netw_rcv_get(pMsg, len);
+		}
+	}
+#else
 	ret = f_netw_sock_recv_timeout(pNetwork, pMsg, len, timeout_ms);
+#endif
     if (ret < 0) {
         if ((ret != NETW_ERR_NET_RECV_WANT_READ) && (ret != NETW_ERR_NET_RECV_TIMEOUT)) {
             LOTRACE_ERR("f_netw_sock_recv_timeout(len=%d) -> ERROR %d x%x", len, ret, ret);
@@ -92,6 +273,8 @@ int netw_init(Network *pNetwork, void* net_iface_handler) {
 	LOTRACE_DBG1("netw_init(%p,%p)", pNetwork, net_iface_handler);
 
 	f_netw_sock_init(pNetwork, net_iface_handler);
+	netw_rcv_reset();
+	netw_snd_reset();
 
 	LOTRACE_DBG1("netw_init: OK");
 
@@ -99,6 +282,12 @@ int netw_init(Network *pNetwork, void* net_iface_handler) {
 		pNetwork->my_socket = SOCKETHANDLE_NULL;
 		pNetwork->mqttread = netw_mqtt_read;
 		pNetwork->mqttwrite = netw_mqtt_write;
+#if defined(LOC_NETW_SOCK_SENDV)
+		pNetwork->mqttwritev = netw_mqtt_writev;
+#else
+		/* no scatter-gather send on this platform: the packets are copied in the MQTT send buffer */
+		pNetwork->mqttwritev = NULL;
+#endif
 		/* pNetwork->disconnect = netw_mqtt_disconnect; */
 	}
 
@@ -115,6 +304,8 @@ int netw_connect(Network* pNetwork, LiveObjectsNetConnectParams_t* params) {
 	if (f_netw_sock_isOpen(pNetwork)) {
 		netw_disconnect(pNetwork, 0);
 	}
+	netw_rcv_reset();
+	netw_snd_reset();
 
 	ret = f_netw_sock_connect(pNetwork, params->RemoteHostAddress, params->RemoteHostPort, params->TimeoutMs);
 	if (ret) {
@@ -34,6 +34,9 @@ int netw_connect(Network *pNetwork, LiveObjectsNetConnectParams_t* params);
 
 void netw_disconnect(Network *pNetwork, int cause);
 
+/* Send the packets waiting in the transmit buffer. Return 0, or the sending error since the previous call */
+int netw_flush(Network *pNetwork);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  posix_netw.c
+ * @brief Network Interface (Linux/POSIX host, BSD sockets).
+ */
+
+#include "liveobjects-sys/LiveObjectsClient_Platform.h"
+
+#if defined(LOC_PLATFORM_POSIX)
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "liveobjects-client/LiveObjectsClient_Config.h"
+
+#include "liveobjects-sys/loc_trace.h"
+#include "liveobjects-sys/mqtt_network_interface.h"
+
+#include "iotsoftbox-core/loc_sock.h"
+#include "iotsoftbox-core/netw_sock.h"
+
+#include "posix_sock.h"
+
+static socketHandle_t  _netw_socket = SOCKETHANDLE_NULL;
+static uint8_t         _netw_bSockState;
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int f_netw_sock_init(Network *pNetwork, void* net_iface_handler) {
+	(void)net_iface_handler;
+	if (pNetwork) {
+		pNetwork->my_socket = SOCKETHANDLE_NULL;
+		pNetwork->mqttread = NULL;
+		pNetwork->mqttwrite = NULL;
+		pNetwork->mqttwritev = NULL;
+	}
+	_netw_socket = SOCKETHANDLE_NULL;
+	_netw_bSockState = 0;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+uint8_t f_netw_sock_isOpen(Network *pNetwork) {
+	(void)pNetwork;
+	if (_netw_bSockState == 0x01) {
+		return 1;
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+uint8_t f_netw_sock_isLost(Network *pNetwork) {
+	(void)pNetwork;
+	if (_netw_bSockState & 0x01) {
+		if (_netw_bSockState & 0x02)
+			LOTRACE_INF("bSockState= x%0x ", _netw_bSockState);
+		return _netw_bSockState & 0x02;
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int f_netw_sock_close(Network *pNetwork) {
+	LOTRACE_INF("f_netw_sock_close(%" PRIsock " %p)...", _netw_socket, pNetwork);
+
+	if (_netw_socket >= 0) {
+		close(_netw_socket);
+	}
+	_netw_socket = SOCKETHANDLE_NULL;
+	_netw_bSockState = 0;
+	if (pNetwork) {
+		pNetwork->my_socket = SOCKETHANDLE_NULL;
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int f_netw_sock_setup(Network *pNetwork) {
+	int flag = 1;
+	(void)pNetwork;
+	if (_netw_socket < 0) {
+		return -1;
+	}
+	/* MQTT packets are small and sent one by one: do not delay them (Nagle) */
+	if (setsockopt(_netw_socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) < 0) {
+		LOTRACE_WARN("setsockopt(TCP_NODELAY) failed, errno=%d", errno);
+	}
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int f_netw_sock_connect(Network *pNetwork, const char* RemoteHostAddress, uint16_t RemoteHostPort, uint32_t tmo_ms) {
+	int ret = -1;
+	LOTRACE_DBG1("(RemoteHostAddress=%s RemoteHostPort=%u tmo_ms=%u) (_netw_socket=%" PRIsock ") ...",
+			RemoteHostAddress, RemoteHostPort, tmo_ms, _netw_socket);
+
+	if (_netw_socket >= 0) {
+		close(_netw_socket);
+	}
+	_netw_socket = SOCKETHANDLE_NULL;
+	_netw_bSockState = 0;
+
+	_netw_socket = posix_sock_open(RemoteHostAddress, RemoteHostPort, tmo_ms);
+	if (_netw_socket >= 0) {
+		_netw_bSockState = 0x01;
+		ret = 0;
+	}
+	else {
+		LOTRACE_ERR("Error while connecting to %s:%u", RemoteHostAddress, RemoteHostPort);
+		_netw_socket = SOCKETHANDLE_NULL;
+	}
+
+	if (pNetwork) {
+		pNetwork->my_socket = _netw_socket;
+	}
+	return ret;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int f_netw_sock_recv(void *pNetwork, unsigned char* buf, size_t len) {
+	int ret;
+
+	if (_netw_socket < 0) {
+		return (NETW_ERR_NET_INVALID_CONTEXT);
+	}
+
+	LOTRACE_DBG_VERBOSE("(pNetwork=%p _netw_socket=%" PRIsock " buf=%p len=%zu) ...", pNetwork, _netw_socket, buf, len);
+	ret = (int) recv(_netw_socket, buf, len, MSG_DONTWAIT);
+	if (ret == 0) {
+		/* Orderly shutdown by the peer */
+		_netw_bSockState |= 0x02;
+		LOTRACE_ERR("(_netw_socket=%" PRIsock " len=%zu) Closed by peer", _netw_socket, len);
+		return (NETW_ERR_NET_CONN_RESET);
+	}
+	if (ret < 0) {
+		if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+			return (NETW_ERR_NET_RECV_WANT_READ);
+		}
+		if ((errno == EPIPE) || (errno == ECONNRESET)) {
+			_netw_bSockState |= 0x02;
+			LOTRACE_ERR("(_netw_socket=%" PRIsock " len=%zu) ret=%d errno=%d x%x", _netw_socket, len, ret, errno,
+					NETW_ERR_NET_CONN_RESET);
+			return (NETW_ERR_NET_CONN_RESET);
+		}
+		LOTRACE_ERR("(_netw_socket=%" PRIsock " len=%zu) ret=%d errno=%d x%x", _netw_socket, len, ret, errno,
+				NETW_ERR_NET_RECV_FAILED);
+		return (NETW_ERR_NET_RECV_FAILED);
+	}
+	LOTRACE_DBG_VERBOSE("(_netw_socket=%" PRIsock " len=%zu) ret=%d", _netw_socket, len, ret);
+	return (ret);
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int f_netw_sock_recv_timeout(void *pNetwork, unsigned char *buf, size_t len, uint32_t timeout) {
+	int ret;
+	struct pollfd pfd;
+
+	LOTRACE_DBG_VERBOSE("(pNetwork=%p _netw_socket=%" PRIsock " buf=%p len=%zu tmo=%u)...", pNetwork, _netw_socket, buf,
+			len, timeout);
+
+	if (_netw_socket < 0) {
+		LOTRACE_ERR("Invalid context %d", _netw_socket);
+		return (NETW_ERR_NET_INVALID_CONTEXT);
+	}
+
+	pfd.fd = _netw_socket;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+
+	ret = poll(&pfd, 1, (timeout == ((uint32_t) -1)) ? -1 : (int) timeout);
+	/* Zero fds ready means we timed out */
+	if (ret == 0) {
+		return (NETW_ERR_NET_RECV_TIMEOUT);
+	}
+	if (ret < 0) {
+		if (errno == EINTR) {
+			LOTRACE_NOTICE("POLL INTERRUPT (sock=%" PRIsock " tmo=%u) %d !", _netw_socket, timeout, ret);
+			return (NETW_ERR_NET_RECV_WANT_READ);
+		}
+		LOTRACE_NOTICE("POLL ERR (sock=%" PRIsock " tmo=%u) %d errno=%d !", _netw_socket, timeout, ret, errno);
+		return (NETW_ERR_NET_RECV_FAILED);
+	}
+
+	/* This call will not block */
+	return (f_netw_sock_recv(pNetwork, buf, len));
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int f_netw_sock_send(void *pNetwork, const unsigned char *buf, size_t len) {
+	int ret;
+	size_t written = 0;
+
+	LOTRACE_DBG2("(pNetwork=%p _netw_socket=%" PRIsock " buf=%p len=%zu)...", pNetwork, _netw_socket, buf, len);
+
+	if (_netw_socket < 0) {
+		LOTRACE_ERR("Invalid context %d", _netw_socket);
+		return (NETW_ERR_NET_INVALID_CONTEXT);
+	}
+
+	while (written < len) {
+		ret = (int) send(_netw_socket, buf + written, len - written, MSG_NOSIGNAL);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			LOTRACE_ERR("ERROR %d (errno=%d) returned by send(len=%zu)", ret, errno, len - written);
+			if ((errno == EPIPE) || (errno == ECONNRESET)) {
+				_netw_bSockState |= 0x02;
+				return (NETW_ERR_NET_CONN_RESET);
+			}
+			if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+				return (NETW_ERR_NET_RECV_WANT_WRITE);
+			return (NETW_ERR_NET_SEND_FAILED);
+		}
+		written += ret;
+	}
+	LOTRACE_DBG_VERBOSE("(_netw_socket=%" PRIsock " len=%zu) written= %zu", _netw_socket, len, written);
+	return ((int) written);
+}
+
+/* --------------------------------------------------------------------------------- */
+/* One sendmsg call: the caller sends the rest if it is not all written */
+int f_netw_sock_sendv(void *pNetwork, const NetworkVec *vec, int nb) {
+	struct iovec iov[NETW_SOCK_VEC_MAX];
+	struct msghdr msg;
+	int ret;
+	int i;
+
+	LOTRACE_DBG2("(pNetwork=%p _netw_socket=%" PRIsock " nb=%d)...", pNetwork, _netw_socket, nb);
+
+	if (_netw_socket < 0) {
+		LOTRACE_ERR("Invalid context %d", _netw_socket);
+		return (NETW_ERR_NET_INVALID_CONTEXT);
+	}
+	if (nb > NETW_SOCK_VEC_MAX) {
+		nb = NETW_SOCK_VEC_MAX;
+	}
+	for (i = 0; i < nb; i++) {
+		iov[i].iov_base = (void*) vec[i].buf;
+		iov[i].iov_len = (size_t) vec[i].len;
+	}
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = nb;
+
+	do {
+		ret = (int) sendmsg(_netw_socket, &msg, MSG_NOSIGNAL);
+	} while ((ret < 0) && (errno == EINTR));
+	if (ret < 0) {
+		LOTRACE_ERR("ERROR %d (errno=%d) returned by sendmsg(nb=%d)", ret, errno, nb);
+		if ((errno == EPIPE) || (errno == ECONNRESET)) {
+			_netw_bSockState |= 0x02;
+			return (NETW_ERR_NET_CONN_RESET);
+		}
+		if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+			return (NETW_ERR_NET_RECV_WANT_WRITE);
+		return (NETW_ERR_NET_SEND_FAILED);
+	}
+	LOTRACE_DBG_VERBOSE("(_netw_socket=%" PRIsock " nb=%d) written= %d", _netw_socket, nb, ret);
+	return ret;
+}
+
+#endif /* LOC_PLATFORM_POSIX */
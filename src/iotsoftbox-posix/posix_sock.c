@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  posix_sock.c
+ * @brief TCP Socket Interface used by loc_wget (Linux/POSIX host, BSD sockets)
+ */
+
+#include "liveobjects-sys/LiveObjectsClient_Platform.h"
+
+#if defined(LOC_PLATFORM_POSIX)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include "liveobjects-client/LiveObjectsClient_Config.h"
+
+#include "liveobjects-sys/loc_trace.h"
+
+#include "iotsoftbox-core/loc_sock.h"
+#include "iotsoftbox-core/netw_sock.h"
+
+#include "posix_sock.h"
+
+static char _dns_domain_name[100];
+static char _dns_ipv4_addr[48];
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static int sock_connect_tmo(int sock_fd, const struct sockaddr* addr, socklen_t addrlen, uint32_t tmo_ms) {
+	int ret;
+	int flags = fcntl(sock_fd, F_GETFL);
+
+	if ((flags < 0) || (fcntl(sock_fd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+		return -1;
+	}
+
+	ret = connect(sock_fd, addr, addrlen);
+	if ((ret < 0) && (errno == EINPROGRESS)) {
+		struct pollfd pfd;
+		pfd.fd = sock_fd;
+		pfd.events = POLLOUT;
+		pfd.revents = 0;
+		ret = poll(&pfd, 1, (tmo_ms) ? (int) tmo_ms : -1);
+		if (ret == 1) {
+			int err = 0;
+			socklen_t len = sizeof(err);
+			if ((getsockopt(sock_fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0) && (err == 0)) {
+				ret = 0;
+			}
+			else {
+				errno = err;
+				ret = -1;
+			}
+		}
+		else {
+			if (ret == 0) {
+				errno = ETIMEDOUT;
+			}
+			ret = -1;
+		}
+	}
+
+	/* Back to blocking mode */
+	if (fcntl(sock_fd, F_SETFL, flags) < 0) {
+		return -1;
+	}
+	return ret;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int posix_sock_open(const char* remoteHostAddress, uint16_t remoteHostPort, uint32_t tmo_ms) {
+	int ret;
+	int sock_fd = -1;
+	char port_str[8];
+	const char* remote_host = remoteHostAddress;
+	struct addrinfo hints;
+	struct addrinfo *ai_list = NULL;
+	struct addrinfo *ai;
+
+	if ((remoteHostAddress == NULL) || (*remoteHostAddress == 0)) {
+		return -1;
+	}
+
+	/* IP address set by LO_sock_dnsSetFQDN() */
+	if ((_dns_ipv4_addr[0]) && !strcmp(remoteHostAddress, _dns_domain_name)) {
+		remote_host = _dns_ipv4_addr;
+	}
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+	snprintf(port_str, sizeof(port_str), "%u", remoteHostPort);
+
+	ret = getaddrinfo(remote_host, port_str, &hints, &ai_list);
+	if (ret) {
+		LOTRACE_ERR("getaddrinfo(%s) failed: %s", remote_host, gai_strerror(ret));
+		return -1;
+	}
+
+	for (ai = ai_list; ai; ai = ai->ai_next) {
+		sock_fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (sock_fd < 0) {
+			continue;
+		}
+		if (sock_connect_tmo(sock_fd, ai->ai_addr, ai->ai_addrlen, tmo_ms) == 0) {
+			break;
+		}
+		LOTRACE_NOTICE("connect(%s:%u) failed, errno=%d %s", remote_host, remoteHostPort, errno, strerror(errno));
+		close(sock_fd);
+		sock_fd = -1;
+	}
+	freeaddrinfo(ai_list);
+
+	if (sock_fd >= 0) {
+		LOTRACE_INF("Connected to server %s:%u - sock=%d", remoteHostAddress, remoteHostPort, sock_fd);
+	}
+	return sock_fd;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_sock_dnsSetFQDN(const char* domain_name, const char* ip_address) {
+	if ((domain_name) && (*domain_name)) {
+		if (ip_address == NULL) {
+			/* Host name is resolved when connecting */
+			_dns_domain_name[0] = 0;
+			_dns_ipv4_addr[0] = 0;
+			return 0;
+		}
+		strncpy(_dns_domain_name, domain_name, sizeof(_dns_domain_name) - 1);
+		strncpy(_dns_ipv4_addr, ip_address, sizeof(_dns_ipv4_addr) - 1);
+		return 0;
+	}
+	return -1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void LO_sock_disconnect(socketHandle_t *pHdl) {
+	if (pHdl) {
+		if (*pHdl != SOCKETHANDLE_NULL) {
+			close(*pHdl);
+		}
+		*pHdl = SOCKETHANDLE_NULL;
+	}
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_sock_connect(short retry, const char* remoteHostAddress, uint16_t remoteHostPort, socketHandle_t *pHdl) {
+	int i;
+	int sock_fd = -1;
+
+	if (pHdl)
+		*pHdl = SOCKETHANDLE_NULL;
+
+	if (remoteHostAddress == NULL) {
+		return -1;
+	}
+	LOTRACE_INF("Connecting to server %s:%d (retry=%d) ...", remoteHostAddress, remoteHostPort, retry);
+
+	if (retry <= 0)
+		retry = 1;
+
+	for (i = 0; i < retry; i++) {
+		sock_fd = posix_sock_open(remoteHostAddress, remoteHostPort, LOC_SERV_TIMEOUT);
+		if (sock_fd >= 0)
+			break;
+		WAIT_MS(200);
+	}
+	if (sock_fd < 0) {
+		LOTRACE_ERR("Failed to connect to %s:%d", remoteHostAddress, remoteHostPort);
+		return -1;
+	}
+
+	if (pHdl)
+		*pHdl = sock_fd;
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_sock_send(socketHandle_t hdl, const char* buf_ptr) {
+	int len, ret;
+	const char* pc = buf_ptr;
+	if ((hdl < 0) || (pc == NULL)) {
+		LOTRACE_ERR("Invalid parameter hdl=%d buf=%p", hdl, pc);
+		return -1;
+	}
+	len = strlen(buf_ptr);
+
+	LOTRACE_DBG1("len=%d\r\n%s", len, buf_ptr);
+	while (len > 0) {
+		ret = (int) send(hdl, pc, len, MSG_NOSIGNAL);
+		if (ret < 0) {
+			if ((errno == EINTR) || (errno == EAGAIN)) {
+				continue;
+			}
+			LOTRACE_NOTICE("ERROR (ret=%d errno=%d) while sending data , len=%d/%d", ret, errno,
+					(int) strlen(buf_ptr) - len, (int) strlen(buf_ptr));
+			return -1;
+		}
+		pc += ret;
+		len -= ret;
+	}
+	LOTRACE_DBG1("send_data: OK");
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_sock_recv(socketHandle_t hdl, char* buf_ptr, int buf_len) {
+	int ret;
+	if ((hdl < 0) || (buf_ptr == NULL) || (buf_len <= 0)) {
+		LOTRACE_ERR("Invalid parameters - hdl=%d buf_ptr=%p buf_len=%d", hdl, buf_ptr, buf_len);
+		return -1;
+	}
+	do {
+		ret = (int) recv(hdl, buf_ptr, buf_len, 0);
+	} while ((ret < 0) && (errno == EINTR));
+	if (ret < 0) {
+		LOTRACE_ERR("(len=%d) ret=%d errno=%d", buf_len, ret, errno);
+		return -1;
+	}
+	LOTRACE_DBG1("LO_sock_recv(len=%d)", ret);
+	return ret;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_sock_read_line(socketHandle_t hdl, char* buf_ptr, int buf_len) {
+	int len = 0;
+	char cc = 0;
+
+	if ((hdl < 0) || (buf_ptr == NULL) || (buf_len <= 0)) {
+		LOTRACE_ERR("LO_sock_recv: Invalid parameters - hdl=%d buf_ptr=%p buf_len=%d", hdl, buf_ptr, buf_len);
+		return -1;
+	}
+
+	while (1) {
+		int ret = (int) recv(hdl, &cc, 1, 0);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			LOTRACE_ERR("(len=%d/%d) -> ERROR ret=%d errno=%d", len, buf_len, ret, errno);
+			return ret;
+		}
+		if (ret == 0) {
+			LOTRACE_ERR("(len=%d) ->  ret=0 -> Closed by peer  !!", len);
+			return -1;
+		}
+		if (cc == '\n') {
+			LOTRACE_DBG1("(len=%d) -> EOL", len);
+			break;
+		}
+
+		buf_ptr[len++] = cc;
+		if (len >= buf_len) {
+			LOTRACE_ERR("(len=%d) ->  TOO SHORT  !!", len);
+			return -1;
+		}
+	}
+
+	if ((len >= 1) && (buf_ptr[len - 1] == '\r')) {
+		len--;
+		if (len == 0)
+			LOTRACE_DBG1("->  BODY  !!");
+	}
+	buf_ptr[len] = 0;
+
+	return len;
+}
+
+#endif /* LOC_PLATFORM_POSIX */
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  posix_sock.h
+ * @brief Internal TCP socket helpers shared by posix_netw.c and posix_sock.c
+ */
+
+#ifndef __posix_sock_H_
+#define __posix_sock_H_
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Open a TCP connection (resolving the host name if needed).
+ *
+ * @return the socket file descriptor, or -1 on failure.
+ */
+int posix_sock_open(const char* remoteHostAddress, uint16_t remoteHostPort, uint32_t tmo_ms);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __posix_sock_H_ */
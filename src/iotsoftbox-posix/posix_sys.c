@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file  posix_sys.c
+ * @brief System Interface : Mutex , Thread, .. (Linux/POSIX host, pthreads)
+ */
+
+#include "liveobjects-sys/LiveObjectsClient_Platform.h"
+
+#if defined(LOC_PLATFORM_POSIX)
+
+#include <pthread.h>
+
+#include "iotsoftbox-core/loc_sys.h"
+
+#include "liveobjects-client/LiveObjectsClient_Config.h"
+#include "liveobjects-client/LiveObjectsClient_Core.h"
+
+#include "liveobjects-sys/loc_trace.h"
+
+/* ================================================================================= */
+/* Private Functions
+ * -----------------
+ */
+
+static pthread_mutex_t _lo_sys_mutex[LO_SYS_MUTEX_NB] = {
+	PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_MUTEX_INITIALIZER
+};
+
+static pthread_t        _lo_sys_thread;
+static volatile uint8_t _lo_sys_thread_running = 0;
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static void* _LO_sys_threadExec(void *argument) {
+	LOTRACE_DBG1("THREAD %p...", argument);
+
+	LiveObjectsClient_Run((LiveObjectsD_CallbackState_t) argument);
+
+	LOTRACE_WARN("THREAD EXIT");
+	_lo_sys_thread_running = 0;
+	return NULL;
+}
+
+/* ================================================================================= */
+/* Public Functions
+ * ----------------
+ */
+
+/* --------------------------------------------------------------------------------- */
+/*  Initialization */
+void LO_sys_init(void) {
+	LOTRACE_DBG1("LO_sys_init");
+}
+
+/* ================================================================================= */
+/* MUTEX
+ * -----
+ */
+uint8_t LO_sys_mutex_lock(uint8_t idx) {
+	LOTRACE_DBG_VERBOSE("LO_sys_mutex_lock(%d)", idx);
+	if (idx >= LO_SYS_MUTEX_NB) {
+		LOTRACE_ERR("Invalid mutex index %d", idx);
+		return 1;
+	}
+	if (pthread_mutex_lock(&_lo_sys_mutex[idx])) {
+		LOTRACE_ERR("pthread_mutex_lock(%d) failed", idx);
+		return 1;
+	}
+	return 0;
+}
+
+void LO_sys_mutex_unlock(uint8_t idx) {
+	LOTRACE_DBG_VERBOSE("LO_sys_mutex_unlock(%d)", idx);
+	if (idx < LO_SYS_MUTEX_NB) {
+		pthread_mutex_unlock(&_lo_sys_mutex[idx]);
+	}
+}
+
+/* ================================================================================= */
+/* THREAD
+ * ------
+ */
+
+/* --------------------------------------------------------------------------------- */
+/*  Called by LiveObjectsClient_Run(), in the LiveObjects Client thread */
+void LO_sys_threadRun(void) {
+	LOTRACE_DBG1("LO_sys_threadRun()");
+	_lo_sys_thread = pthread_self();
+	_lo_sys_thread_running = 1;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+uint8_t LO_sys_threadIsLiveObjectsClient(void) {
+	if (!_lo_sys_thread_running) {
+		/* No LiveObjects thread: the application calls LiveObjectsClient_Cycle() itself */
+		return 1;
+	}
+	return pthread_equal(pthread_self(), _lo_sys_thread) ? 1 : 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+int LO_sys_threadStart(void const *argument) {
+	int ret;
+	pthread_t thread;
+	LOTRACE_DBG1("LO_sys_threadStart()");
+	ret = pthread_create(&thread, NULL, _LO_sys_threadExec, (void*) argument);
+	if (ret) {
+		LOTRACE_ERR("pthread_create failed, ret=%d", ret);
+		return -1;
+	}
+	_lo_sys_thread = thread;
+	_lo_sys_thread_running = 1;
+	pthread_detach(thread);
+	return 0;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void LO_sys_threadCheck(void) {
+	LOTRACE_DBG1("LO_sys_threadCheck()");
+}
+
+#endif /* LOC_PLATFORM_POSIX */
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file posix_timer.c
+ * @brief Linux/POSIX implementation of the timer interface (monotonic clock).
+ */
+
+#include "liveobjects-sys/LiveObjectsClient_Platform.h"
+
+#if defined(LOC_PLATFORM_POSIX)
+
+#include <stddef.h>
+#include <time.h>
+
+#include "paho-mqttclient-embedded-c/timer_interface.h"
+
+#include "liveobjects-sys/loc_trace.h"
+
+typedef unsigned long  time_ms_t;
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static time_ms_t timer_get_time_ms(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	/* Never 0 : end_time = 0 means 'timer not started' */
+	return (time_ms_t) ts.tv_sec * 1000UL + ts.tv_nsec / 1000000UL + 1;
+}
+
+/*
+ * count timer and return true or false if the time ends up
+ */
+char TimerIsExpired(Timer* timer) {
+	return ((timer->end_time) && (timer->end_time < timer_get_time_ms())) ? 1 : 0;
+}
+
+//add time to the timer in milliseconds
+void TimerCountdownMS(Timer* timer, unsigned int timeout) {
+	timer->end_time = timer_get_time_ms() + timeout;
+}
+
+//add time to the timer in seconds
+void TimerCountdown(Timer* timer, unsigned int timeout) {
+	timer->end_time = timer_get_time_ms() + (time_ms_t) timeout * 1000;
+}
+
+//calculate the left time in milliseconds
+int TimerLeftMS(Timer* timer) {
+	long left = (long) (timer->end_time - timer_get_time_ms());
+	return (left <= 0) ? 0 : (int) left;
+}
+
+void TimerInit(Timer* timer) {
+	timer->end_time = 0;
+}
+
+#endif /* LOC_PLATFORM_POSIX */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2016 Orange
+ *
+ * This software is distributed under the terms and conditions of the 'BSD-3-Clause'
+ * license which can be found in the file 'LICENSE.txt' in this package distribution
+ * or at 'https://opensource.org/licenses/BSD-3-Clause'.
+ */
+
+/**
+ * @file posix_trace.c
+ * @brief Trace/Log Interface (Linux/POSIX host).
+ */
+
+#include "liveobjects-sys/LiveObjectsClient_Platform.h"
+
+#if defined(LOC_PLATFORM_POSIX)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#include <pthread.h>
+
+#include "liveobjects-sys/loc_trace.h"
+
+#define TRACE_LEVELS_MAX      7
+#define LOGP_MAX_MSG_SIZE     1024
+
+static uint32_t _trace_index = 0;
+static int _trace_level_current = 4;
+static pthread_mutex_t _trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static const char _trace_TraceLib[TRACE_LEVELS_MAX + 2] = "-EWNIDdV";
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+static unsigned long trace_millis(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long) ts.tv_sec * 1000UL + ts.tv_nsec / 1000000UL;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void lo_trace_init(int level) {
+	_trace_level_current = level;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void lo_trace_level(int level) {
+	_trace_level_current = level;
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void lo_trace_log(int level,
+#if LOTRACE_WITH_LOCATION
+		const char *file,
+		unsigned int line,
+		const char *function,
+#endif
+		const char* format, ...) {
+	char trace_str[LOGP_MAX_MSG_SIZE];
+	char *pt_str = trace_str;
+	char *end_str = trace_str + sizeof(trace_str) - 1;
+	va_list ap;
+
+	if ((level <= 0) || (level > _trace_level_current)) {
+		return;
+	}
+	if (level > TRACE_LEVELS_MAX)
+		level = TRACE_LEVELS_MAX;
+
+	pthread_mutex_lock(&_trace_mutex);
+
+	pt_str += snprintf(pt_str, end_str - pt_str, "%" PRIu32 ":%lu:%c:", ++_trace_index, trace_millis(),
+			*(_trace_TraceLib + level));
+
+#if LOTRACE_WITH_LOCATION
+	/*Add file:line: */
+	if (pt_str < end_str) {
+		const char* name = strrchr(file, '/');
+		name = (name) ? name + 1 : file;
+		pt_str += snprintf(pt_str, end_str - pt_str, "%s:%u:%s:", name, line, function);
+	}
+#endif
+
+	if (pt_str < end_str) {
+		va_start(ap, format);
+		pt_str += vsnprintf(pt_str, end_str - pt_str, format, ap);
+		va_end(ap);
+	}
+	if (pt_str >= end_str) {
+		/* Truncated message */
+		pt_str = end_str - 1;
+	}
+	if ((pt_str == trace_str) || (*(pt_str - 1) != '\n')) {
+		*pt_str++ = '\n';
+	}
+	*pt_str = 0;
+
+	fputs(trace_str, stdout);
+	fflush(stdout);
+
+	pthread_mutex_unlock(&_trace_mutex);
+}
+
+/* --------------------------------------------------------------------------------- */
+/*  */
+void lo_trace_printf(const char* format, ...) {
+	va_list ap;
+	va_start(ap, format);
+	pthread_mutex_lock(&_trace_mutex);
+	vfprintf(stdout, format, ap);
+	fflush(stdout);
+	pthread_mutex_unlock(&_trace_mutex);
+	va_end(ap);
+}
+
+#endif /* LOC_PLATFORM_POSIX */
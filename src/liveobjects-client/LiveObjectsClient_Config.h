@@ -26,23 +26,66 @@
  * - LOC_MQTT_DEF_COMMAND_TIMEOUT  Timeout in milliseconds to wait for a MQTT ACK/NACK response after sending MQTT request
  * - LOC_MQTT_DEF_SND_SZ  Size(in bytes) of static MQTT buffer used to send a MQTT message (default: 2 K bytes)
  * - LOC_MQTT_DEF_RCV_SZ  Size(in bytes) of static MQTT buffer used to receive a MQTT message (default: 2 K bytes)
+ * - LOC_MQTT_RCV_CHUNKED  boolean to receive the configuration updates and the commands larger than LOC_MQTT_DEF_RCV_SZ
+ *   in pieces: the topic is read first, then the payload is given to the JSON reader by pieces of the receive buffer
+ *   (default: 1). A string value (or a member name and its value) must still fit in the receive buffer.
+ *   When set to 0, or for the other messages, a payload larger than the receive buffer is ignored.
+ * - LOC_NETW_RCV_BUF_SZ  Size (in bytes) of the network receive buffer (default: 256 bytes). When empty, it is filled
+ *   by one read of all the received bytes, and the small reads of the MQTT client (fixed header, remaining length,
+ *   short packets) are served from it. A larger read is done directly in the caller buffer. Set to 0 to disable it.
+ * - LOC_NETW_SND_BUF_SZ  Size (in bytes) of the network transmit buffer (default: 1 K bytes). The packets written by the
+ *   MQTT client are gathered in it, and sent by one write (one modem transaction) before the next read of the MQTT
+ *   client (a response is expected), when the next packet does not fit, and at the end of each LiveObjects Client
+ *   cycle. A packet larger than this buffer, or a PUBLISH packet written in two segments (header and payload, when
+ *   the platform supports it), is written directly. Set to 0 to disable it.
  * - LOC_MQTT_DEF_TOPIC_NAME_SZ  Max Size(in bytes) of MQTT Topic name (default: 40 bytes)
  * - LOC_MQTT_DEF_DEV_ID_SZ  Max Size(in bytes) of Device Identifier (default: 20 bytes)
  * - LOC_MQTT_DEF_NAME_SPACE_SZ  Max Size(in bytes) o Name Space (default: 20 bytes)
  * - LOC_MQTT_DEF_PENDING_MSG_MAX  Max Number of pending MQTT Publish messages (default: 5 messages)
+ * - LOC_MQTT_DEF_PUB_ASYNC_MAX  Max Number of messages published by LiveObjectsClient_xxxAsync functions and not
+ *   completed yet, i.e. waiting to be sent or to be acknowledged (default: 4 messages with LOM_MQUEUE, otherwise 0).
+ *   These messages are copied (MEM_ALLOC), so it needs LOM_MQUEUE. It can be set to 0 : disabled.
  * - LOC_MAX_OF_COMMAND_ARGS  Max Number of arguments in command (default: 5 arguments)
+ * - LOC_CMD_BLK_NB  Number of static blocks used to pass the received commands to user (default: 2). When all blocks
+ *   are in use (i.e. delayed commands without response), a new command gets a 'Busy' response.
+ *   The blocks of delayed commands are also released when the client is (re)connected.
+ *   It can be set to 0 : a block of LOC_CMD_BLK_SZ bytes is allocated (MEM_ALLOC) and freed after the user callback.
+ * - LOC_CMD_BLK_SZ  Size (in bytes) of one command block: header, arguments, names and values (default: 256 bytes)
  * - LOC_MAX_OF_DATA_SET  Max Number of collected data streams (or also named 'data sets')  (default: 5 data streams)
  * - LOC_MAX_OF_STATUS_SET  Max Number of status/info sets (default: 1 status set)
- * - LOC_MAX_OF_PARSED_PARAMS Max Number of parsed parameters in a same received update param request (default: 5)
+ * - LOC_MAX_OF_PARSED_PARAMS Max Number of updated parameters listed in the response to a received update param
+ *   request (default: 5). The request itself is not limited: over this number, all parameters are published.
+ * - LOC_PARAMS_BATCH_SZ  Max Number of parameter updates given in one call of the batch callback
+ *   (see LiveObjectsClient_AttachCfgParamsBatch) (default: 8)
  * - LOM_JSON_BUF_SZ  Size (in bytes) of static JSON buffer used to encode the JSON payload to be sent (default: 1 K bytes)
+ *   Not used when LOM_ENCODE_IN_MQTT_BUF is set.
  * - LOM_JSON_BUF_USER_SZ  Size (in bytes) of static JSON buffer used to encode a user JSON payload (default: 200 bytes)
+ * - LOM_JSON_MAX_DEPTH  Max nesting depth of the received JSON messages (default: 8, max: 32). The state of the JSON
+ *   reader grows with this depth only, not with the size of the message.
+ * - LOM_JSON_SIMD  boolean to let the JSON reader scan the received text 16 or 32 bytes at a time (strings, numbers,
+ *   white spaces) when the compiler targets SSE2, AVX2 or NEON (default: 1). Otherwise, or when set to 0, the text is
+ *   scanned byte per byte.
+ * - LOM_NAME_INDEX_SZ  Number of slots (power of 2, max 256) of the hash index built on the names of the attached
+ *   commands, resources and configuration parameters, to find a received name with a single compare (default: 64,
+ *   i.e. up to 32 names).
+ *   Over this capacity, or when set to 0, the names are searched one by one.
  *
  *
  * - LOM_SETOFDATA_STREAM_ID_SZ Max Size(in bytes) of Data Stream Id (default: 80 bytes)
  * - LOM_SETOFDATA_MODEL_SZ Max Size(in bytes) of Data Model field (default: 80 bytes). It can be set to 0 : disabled.
  * - LOM_SETOFDATA_TAGS_SZ Max Size(in bytes) of Data Tag field (default: 80 bytes). It can be set to 0 : disabled.
+ * - LOM_SETOFDATA_SKEL_SZ Size(in bytes) of the JSON skeleton (stream id, model, tags and data names) pre-rendered
+ *   for each data stream (default: 320 bytes). It can be set to 0 : disabled.
+ * - LOM_SETOFDATA_RBE_NB Max Number of data items of a data stream in 'report-by-exception' mode, i.e. with
+ *   a 32-bit hash of their last published value (default: 16). It can be set to 0 : disabled.
+ * - LOM_SETOFDATA_FILTER_NB Max Number of numeric data items of a data stream with a publish filter, i.e. deadband
+ *   and min/max publish interval (default: 4). It can be set to 0 : disabled.
+ * - LOM_SETOFDATA_AGGR_NB Max Number of numeric data items of a data stream aggregated (min/max/mean/count/last)
+ *   over a window of samples (default: 4). It can be set to 0 : disabled.
  *
  * - LOM_PUSH_ASYNC boolean to enable or not the asynchronous push call
+ * - LOM_ENCODE_IN_MQTT_BUF boolean to encode the JSON payload of the messages published by the LiveObjects Client thread
+ *   directly in the MQTT send buffer (no LOM_JSON_BUF_SZ buffer, no copy). Default: 1
  * - LOM_MQUEUE boolean to use or not a message queue to publish message between user application and iotsoftbox-mqtt library.
  *
  */
@@ -96,6 +139,18 @@
 #define LOC_MQTT_DEF_RCV_SZ                  (1024*2)
 #endif
 
+#ifndef LOC_MQTT_RCV_CHUNKED
+#define LOC_MQTT_RCV_CHUNKED                 1
+#endif
+
+#ifndef LOC_NETW_RCV_BUF_SZ
+#define LOC_NETW_RCV_BUF_SZ                  256
+#endif
+
+#ifndef LOC_NETW_SND_BUF_SZ
+#define LOC_NETW_SND_BUF_SZ                  1024
+#endif
+
 #ifndef LOC_MQTT_DEF_TOPIC_NAME_SZ
 #define LOC_MQTT_DEF_TOPIC_NAME_SZ           40
 #endif
@@ -116,6 +171,14 @@
 #define LOC_MAX_OF_COMMAND_ARGS              5
 #endif
 
+#ifndef LOC_CMD_BLK_NB
+#define LOC_CMD_BLK_NB                       2
+#endif
+
+#ifndef LOC_CMD_BLK_SZ
+#define LOC_CMD_BLK_SZ                       256
+#endif
+
 #ifndef LOC_MAX_OF_DATA_SET
 #define LOC_MAX_OF_DATA_SET                  5
 #endif
@@ -128,15 +191,35 @@
 #define LOC_MAX_OF_PARSED_PARAMS             5
 #endif
 
+#ifndef LOC_PARAMS_BATCH_SZ
+#define LOC_PARAMS_BATCH_SZ                  8
+#endif
+
 
 #ifndef LOM_JSON_BUF_SZ
 #define LOM_JSON_BUF_SZ                      1024
 #endif
 
+#ifndef LOM_ENCODE_IN_MQTT_BUF
+#define LOM_ENCODE_IN_MQTT_BUF               1
+#endif
+
 #ifndef LOM_JSON_BUF_USER_SZ
 #define LOM_JSON_BUF_USER_SZ                 1024
 #endif
 
+#ifndef LOM_JSON_MAX_DEPTH
+#define LOM_JSON_MAX_DEPTH                   8
+#endif
+
+#ifndef LOM_JSON_SIMD
+#define LOM_JSON_SIMD                        1
+#endif
+
+#ifndef LOM_NAME_INDEX_SZ
+#define LOM_NAME_INDEX_SZ                    64
+#endif
+
 #ifndef LOM_PUSH_ASYNC
 #define LOM_PUSH_ASYNC                       0
 #endif
@@ -150,6 +233,18 @@
 #ifndef LOM_SETOFDATA_TAGS_SZ
 #define LOM_SETOFDATA_TAGS_SZ                 80
 #endif
+#ifndef LOM_SETOFDATA_SKEL_SZ
+#define LOM_SETOFDATA_SKEL_SZ                 320
+#endif
+#ifndef LOM_SETOFDATA_RBE_NB
+#define LOM_SETOFDATA_RBE_NB                  16
+#endif
+#ifndef LOM_SETOFDATA_FILTER_NB
+#define LOM_SETOFDATA_FILTER_NB               4
+#endif
+#ifndef LOM_SETOFDATA_AGGR_NB
+#define LOM_SETOFDATA_AGGR_NB                 4
+#endif
 
 
 #ifndef LOM_MQUEUE
@@ -160,4 +255,12 @@
 #endif
 #endif
 
+#ifndef LOC_MQTT_DEF_PUB_ASYNC_MAX
+#if LOM_MQUEUE
+#define LOC_MQTT_DEF_PUB_ASYNC_MAX             4
+#else
+#define LOC_MQTT_DEF_PUB_ASYNC_MAX             0
+#endif
+#endif
+
 #endif /* __LiveObjectsClient_Config_H_ */
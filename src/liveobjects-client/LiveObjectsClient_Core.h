@@ -154,6 +154,19 @@ void LiveObjectsClient_SetDbgMsgDump(uint16_t mode);
 int LiveObjectsClient_AttachCfgParams(const LiveObjectsD_Param_t* param_ptr,
 		int32_t param_nb, LiveObjectsD_CallbackParams_t callback);
 
+/**
+ * @brief Define a set of user data as the LiveObjects IoT Configuration parameters,
+ *        with a callback function called once per batch of updated parameters.
+ *
+ * @param param_ptr   Pointer to an array of Configuration Parameters
+ * @param param_nb    Number of elements in this array.
+ * @param callback    User callback function, called to check a batch of parameters to be updated.
+ *
+ * @return 0 if successful, otherwise a negative value when error occurs.
+ */
+int LiveObjectsClient_AttachCfgParamsBatch(const LiveObjectsD_Param_t* param_ptr,
+		int32_t param_nb, LiveObjectsD_CallbackParamsBatch_t callback);
+
 /**
  * @brief Define the set of user data as the LiveObjects IoT Status.
  *
@@ -255,6 +268,81 @@ int LiveObjectsClient_RemoveData(int handle);
 int LiveObjectsClient_ChangeDataStreamId(uint8_t prefix, int handle,
 		const char* stream_id);
 
+/**
+ * @brief Enable/disable the 'report-by-exception' mode of a collected data set:
+ *        each push request publishes only the data items whose value changed since the last publish,
+ *        and nothing at all when no value changed.
+ *
+ * @param handle      Collected data handle (returned by LiveObjectsClient_AttachData)
+ * @param enable      Boolean to enable/disable this mode
+ * @param full_every  Publish a full snapshot (all data items) every N push requests (0: only the first one).
+
+ * @return  0 if successful, otherwise a negative value when error occurs
+ *          (i.e. more than LOM_SETOFDATA_RBE_NB data items in this set).
+ */
+int LiveObjectsClient_ControlDataDelta(int handle, bool enable, uint16_t full_every);
+
+/**
+ * @brief Set (or remove) the publish filter of a numeric data item of a collected data set:
+ *        this data item has to be published only when its value changed by more than the deadband
+ *        (and min_interval_ms elapsed since its last publish), or when max_interval_ms elapsed since its last publish.
+ *        The set is published when one of its data items has to be published:
+ *        - in 'report-by-exception' mode (see LiveObjectsClient_ControlDataDelta), a data item without filter
+ *          has to be published when its value changed, and only these data items are published.
+ *        - otherwise, a data item without filter (and not aggregated) has to be published at each push,
+ *          and the whole set is published: the filters only reduce the publishes of a set whose
+ *          data items all have a filter (or an aggregation).
+ *
+ * @param handle           Collected data handle (returned by LiveObjectsClient_AttachData)
+ * @param item             Index of the data item in the data set (single numeric value)
+ * @param deadband         Deadband: minimal change of the value to publish it. Negative value to remove the filter.
+ * @param percent          The deadband is a percentage of the last published value (otherwise, absolute value)
+ * @param min_interval_ms  Minimal interval between two publishes of a changed value (0: none)
+ * @param max_interval_ms  Maximal interval between two publishes, even if the value is unchanged (0: none)
+
+ * @return  0 if successful, otherwise a negative value when error occurs
+ *          (i.e. invalid data item, or more than LOM_SETOFDATA_FILTER_NB filters in this set).
+ */
+int LiveObjectsClient_SetDataFilter(int handle, int item, float deadband, bool percent,
+		uint32_t min_interval_ms, uint32_t max_interval_ms);
+
+/**
+ * @brief Set (or remove) the aggregation of a numeric data item of a collected data set, sampled at high rate
+ *        by LiveObjectsClient_SampleData: instead of its current value, a summary of the samples of the current
+ *        window (min, max, mean, count and/or last value) is published as a JSON object
+ *        "name":{"min":..,"max":..,"avg":..,"count":..,"last":..}.
+ *        The current value is published when there is no sample in the window.
+ *
+ * @param handle      Collected data handle (returned by LiveObjectsClient_AttachData)
+ * @param item        Index of the data item in the data set (single numeric value)
+ * @param fields      Published summary fields, combination of LiveObjectsD_Aggr_t flags. 0 to remove the aggregation.
+
+ * @return  0 if successful, otherwise a negative value when error occurs
+ *          (i.e. invalid data item, or more than LOM_SETOFDATA_AGGR_NB aggregations in this set).
+ */
+int LiveObjectsClient_SetDataAggregation(int handle, int item, uint8_t fields);
+
+/**
+ * @brief Set the duration of the aggregation window of a collected data set.
+ *
+ * @param handle      Collected data handle (returned by LiveObjectsClient_AttachData)
+ * @param window_ms   Duration of a window, starting at the first sample: at its end, LiveObjectsClient_SampleData
+ *                    publishes the summary. 0 (default): the window ends at each LiveObjectsClient_PushData.
+
+ * @return  0 if successful, otherwise a negative value when error occurs.
+ */
+int LiveObjectsClient_SetDataWindow(int handle, uint32_t window_ms);
+
+/**
+ * @brief Add the current value of each aggregated data item to the current window of a collected data set,
+ *        and publish the summary at the end of the window.
+ *
+ * @param handle      Collected data handle (returned by LiveObjectsClient_AttachData)
+
+ * @return  0 if successful, otherwise a negative value when error occurs.
+ */
+int LiveObjectsClient_SampleData(int handle);
+
 /**
  * @brief Remove a set of user commands
  *
@@ -454,6 +542,57 @@ int LiveObjectsClient_CommandResponse(int32_t cid,
  */
 int LiveObjectsClient_Publish(const char* topic_name, const char* payload_data);
 
+/**
+ * @brief Request to publish one set of 'status' to LiveObjects server, and be notified of its completion.
+ *        The message is encoded (and copied) now, and published by the next loop of LiveObjects Client thread.
+ *        Only available with the messages queue (LOM_MQUEUE) and LOC_MQTT_DEF_PUB_ASYNC_MAX > 0.
+ *
+ * @param handle      Handle of user status set
+ * @param qos         MQTT QoS : 0 (completed when sent) or 1 (completed when acknowledged by the server)
+ * @param callback    User callback function called when the message is completed, or NULL
+ * @param context     User context given to this callback function
+ *
+ * @return A ticket (positive value) given to the callback function, otherwise a negative value when error occurs
+ *         (then the callback function is not called).
+ */
+int LiveObjectsClient_PushStatusAsync(int handle, uint8_t qos,
+		LiveObjectsD_CallbackPublished_t callback, void* context);
+
+/**
+ * @brief Request to publish one set of 'collected data' to LiveObjects server, and be notified of its completion.
+ *        The message is encoded (and copied) now, and published by the next loop of LiveObjects Client thread.
+ *        Only available with the messages queue (LOM_MQUEUE) and LOC_MQTT_DEF_PUB_ASYNC_MAX > 0.
+ *
+ * @param handle      Handle of collected data set
+ * @param qos         MQTT QoS : 0 (completed when sent) or 1 (completed when acknowledged by the server)
+ * @param callback    User callback function called when the message is completed, or NULL
+ * @param context     User context given to this callback function
+ *
+ * @return A ticket (positive value) given to the callback function, otherwise a negative value when error occurs
+ *         (then the callback function is not called). In 'report-by-exception' mode, 0 if there is nothing to
+ *         publish.
+ */
+int LiveObjectsClient_PushDataAsync(int handle, uint8_t qos,
+		LiveObjectsD_CallbackPublished_t callback, void* context);
+
+/**
+ * @brief Request to publish a command response, and be notified of its completion.
+ *        Only available with the messages queue (LOM_MQUEUE) and LOC_MQTT_DEF_PUB_ASYNC_MAX > 0.
+ *
+ * @param cid         Correlation Identifier ((given by LiveObjects client while command receipt).
+ * @param data_ptr    Pointer to the first data in  an array of data (not an array of pointers)
+ * @param data_nb     The number of data in array
+ * @param qos         MQTT QoS : 0 (completed when sent) or 1 (completed when acknowledged by the server)
+ * @param callback    User callback function called when the message is completed, or NULL
+ * @param context     User context given to this callback function
+ *
+ * @return A ticket (positive value) given to the callback function, otherwise a negative value when error occurs
+ *         (then the callback function is not called).
+ */
+int LiveObjectsClient_CommandResponseAsync(int32_t cid,
+	const LiveObjectsD_Data_t* data_ptr, int data_nb, uint8_t qos,
+	LiveObjectsD_CallbackPublished_t callback, void* context);
+
 /* @} group end : Async */
 
 #if defined(__cplusplus)
@@ -58,8 +58,22 @@ typedef struct {
 	const char*         data_name;  /*!< Name of user data (used as the JSON name) */
 	void*               data_value; /*!< Pointer to the user data (single value or array) */
 	int8_t              data_dim;   /*!< Number of values (array) */
+	int8_t              data_prec;  /*!< FLOAT/DOUBLE: max number of decimals, 0 for the shortest exact value */
 } LiveObjectsD_Data_t;
 
+/**
+ * @brief Summary fields published for an aggregated data item (see LiveObjectsClient_SetDataAggregation).
+ *        They can be combined, and are published as a JSON object: "name":{"min":..,"max":..,"avg":..,"count":..,"last":..}
+ */
+typedef enum {
+	LOD_AGGR_MIN = 0x01,   /*!< Minimum value in the window */
+	LOD_AGGR_MAX = 0x02,   /*!< Maximum value in the window */
+	LOD_AGGR_AVG = 0x04,   /*!< Mean value in the window */
+	LOD_AGGR_COUNT = 0x08, /*!< Number of samples in the window */
+	LOD_AGGR_LAST = 0x10,  /*!< Last sampled value */
+	LOD_AGGR_ALL = 0x1F
+} LiveObjectsD_Aggr_t;
+
 /**
  * @brief Define an user configuration parameter to build  JSON format
  */
@@ -163,9 +177,34 @@ typedef void (*LiveObjectsD_CallbackState_t)(LiveObjectsD_State_t state);
  */
 typedef int (*LiveObjectsD_CallbackParams_t)(const LiveObjectsD_Param_t* param_ptr, const void* val_ptr, int val_len);
 
+/**
+ * @brief Define a new value of a configuration parameter, given to the batch callback.
+ */
+typedef struct {
+	const LiveObjectsD_Param_t* param_ptr; /*!< Pointer to the LiveObject Configuration Parameter to be updated */
+	const void* val_ptr;                   /*!< Pointer to the new value (not null terminated for a string) */
+	int val_len;                           /*!< Length of this value */
+} LiveObjectsD_ParamUpdate_t;
+
+/**
+ * @brief  Type of a user callback function linked to a set of configuration parameters.
+ *         This function is called with a batch of configuration parameters to be updated,
+ *         several times if the received request contains more than LOC_PARAMS_BATCH_SZ parameters.
+ *
+ * @param upd_ptr   Pointer to an array of new values.
+ * @param upd_nb    Number of elements in this array.
+ *
+ * @return
+ *       0 : the whole batch is accepted, otherwise refused by user.
+ */
+typedef int (*LiveObjectsD_CallbackParamsBatch_t)(const LiveObjectsD_ParamUpdate_t* upd_ptr, int upd_nb);
+
 /**
  * @brief  Type of a user callback function linked to a set of user commands.
  *         This function will be called when a command must be processed by user.
+ *         If the response is delayed (return 0), the data block remains valid until
+ *         LiveObjectsClient_CommandResponse is called with its cid, or the client is reconnected
+ *         (only with LOC_CMD_BLK_NB > 0).
  *
  * @param pCmdReqBlk   Pointer to a data block given arguments
  */
@@ -214,6 +253,18 @@ typedef LiveObjectsD_ResourceRespCode_t (*LiveObjectsD_CallbackResourceNotify_t)
  */
 typedef int (*LiveObjectsD_CallbackResourceData_t)(const LiveObjectsD_Resource_t* rsc_ptr, uint32_t rsc_offset);
 
+/**
+ * @brief  Type of a user callback function.
+ *         This function will be called (by the LiveObjects Client thread) when a message published by
+ *         LiveObjectsClient_PushStatusAsync, LiveObjectsClient_PushDataAsync or LiveObjectsClient_CommandResponseAsync
+ *         is completed: sent (QoS 0), acknowledged by the LiveObjects platform (QoS 1), or failed.
+ *
+ * @param context   User context given to the asynchronous publish function.
+ * @param ticket    Ticket returned by the asynchronous publish function.
+ * @param rc        0 if successful, otherwise a negative value (not sent, or not acknowledged).
+ */
+typedef void (*LiveObjectsD_CallbackPublished_t)(void* context, int ticket, int rc);
+
 #if defined(__cplusplus)
 }
 #endif
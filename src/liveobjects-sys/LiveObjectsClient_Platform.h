@@ -42,8 +42,6 @@
 
 #define MEM_FREE(p)            free((void*)(p))
 
-#define WAIT_MS(dt_ms)         delay(dt_ms)
-
 #if defined(ARDUINO_ARCH_MTK) || defined(ARDUINO_MTK_ONE)
 #define ARDUINO_MEDIATEK   1
 #define ARDUINO_BOARD      "MDK"
@@ -55,11 +53,23 @@
 #else
 #define ARDUINO_BOARD      "???"
 #endif
-#define  ARDUINO_DTOSTRE
+#elif !defined(ARDUINO)
+/* Host build (Linux/POSIX), used to run and profile the library out of the Arduino environment */
+#define LOC_PLATFORM_POSIX 1
+#define ARDUINO_BOARD      "POSIX"
 #else
 #error "Unknown Arduino platform"
 #endif
 
+#if defined(LOC_PLATFORM_POSIX)
+#include <unistd.h>
+#define WAIT_MS(dt_ms)         usleep((dt_ms)*1000)
+/* f_netw_sock_sendv is available: a packet is sent in several segments without copy */
+#define LOC_NETW_SOCK_SENDV    1
+#else
+#define WAIT_MS(dt_ms)         delay(dt_ms)
+#endif
+
 #if defined(ARDUINO_MEDIATEK)
 typedef enum
 {
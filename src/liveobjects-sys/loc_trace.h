@@ -24,11 +24,15 @@ extern "C" {
 
 #define LOTRACE_LEVEL(level)          lo_trace_level(level)
 
+/* Host build: all traces, unless LOC_TRACE_DISABLE is defined (i.e. for benchmarks) */
+#if defined(ARDUINO_MEDIATEK) || defined(ARDUINO_ARCH_SAMD) || (defined(LOC_PLATFORM_POSIX) && !defined(LOC_TRACE_DISABLE))
+#define LOTRACE_WITH_LOCATION         1
+#endif
 
-#if defined(ARDUINO_MEDIATEK) || defined(ARDUINO_ARCH_SAMD)
+#if LOTRACE_WITH_LOCATION
 
 #define LOTRACE_ERR_I(...)            lo_trace_log(1, __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
-#if defined(ARDUINO_MEDIATEK)
+#if defined(ARDUINO_MEDIATEK) || defined(LOC_PLATFORM_POSIX)
 #define LOTRACE_ERR(...)              lo_trace_log(1, __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
 #define LOTRACE_WARN(...)             lo_trace_log(2, __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
 #define LOTRACE_NOTICE(...)           lo_trace_log(3, __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
@@ -69,7 +73,7 @@ void lo_trace_init( int level );
 void lo_trace_level( int level );
 
 void lo_trace_log( int level,
-#if defined(ARDUINO_MEDIATEK) || defined(ARDUINO_ARCH_SAMD)
+#if LOTRACE_WITH_LOCATION
     const char   *file,
     unsigned int line,
     const char   *function,
@@ -25,11 +25,19 @@ extern "C" {
 
 typedef struct Network Network;
 
+// Segment of a packet written by mqttwritev
+typedef struct NetworkVec {
+    const unsigned char* buf;
+    int len;
+} NetworkVec;
+
 struct Network{
     socketHandle_t   my_socket;
 
     int (*mqttread)  (Network*, unsigned char*, int, int);
     int (*mqttwrite) (Network*, unsigned char*, int, int);
+    // Optional (NULL if not supported): write of a packet given in several segments
+    int (*mqttwritev) (Network*, const NetworkVec*, int, int);
 
     //void (*disconnect) (Network*);
 };
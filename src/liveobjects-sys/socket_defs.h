@@ -15,9 +15,12 @@
 #ifndef SOCKET_DEFS_H_
 #define SOCKET_DEFS_H_
 
-#include <Arduino.h>
 #include "liveobjects-sys/LiveObjectsClient_Platform.h"
 
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+
 
 #if defined(ARDUINO_MEDIATEK) && (ARDUINO_CONN_ITF==-1)
 #include <vmdatetime.h>
@@ -32,7 +35,7 @@
 // used by the header file : paho-mqttclient-embedded-c/MQTTClient.h
 #define MQTT_PACKET_HEADER_FILE   "MQTTPacket/MQTTPacket.h"
 
-#if defined(ARDUINO_MEDIATEK) && (ARDUINO_CONN_ITF==-1)
+#if (defined(ARDUINO_MEDIATEK) && (ARDUINO_CONN_ITF==-1)) || defined(LOC_PLATFORM_POSIX)
 #define PRIsock   "d"
 // Socket handle
 #define SOCKETHANDLE_NULL      ((socketHandle_t)-1)
@@ -15,7 +15,9 @@
 #ifndef TIMER_DEFS_H_
 #define TIMER_DEFS_H_
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+#endif
 
 #define LOC_TIMER_STRUCT        0
 
@@ -19,6 +19,16 @@
  *   - Disable Timer to send MQTT Packet
  *   - Add a few traces
  *   - Patch in MQTTSubscribe function to define qos as integer
+ *   - Route the received messages through a hash index of the topic filters (see MQTTSetMessageHandler),
+ *     and remove the message handler in MQTTUnsubscribe
+ *   - Check the remaining length against the read buffer: the payload of a larger PUBLISH packet is given
+ *     in chunks (see MQTTSetMessageChunkHandler), the other larger packets are skipped
+ *   - Read the payload length of a received PUBLISH packet in an int (and not through a cast of size_t)
+ *   - Add an in-flight window of QoS1 messages (see MQTTPublishAsync): PUBACK matched in cycle, retransmission
+ *     with DUP on timeout and after MQTTConnect. waitforPublishAck checks the packet id of the PUBACK.
+ *   - Write a PUBLISH packet in two segments (header in the send buffer, payload from the caller memory) when
+ *     the network supports it (mqttwritev), instead of copying the payload in the send buffer
+ *   - Add MQTTSetLost: the connection is lost, without sending DISCONNECT (the in-flight window is kept)
  * Note: keep the source code as it (dont't suppress /replace tab, end space, ..)
  */
 
@@ -27,6 +37,8 @@
 // LiveObjects Client: Add some logs  (search pattern LOTRACE_ ) ...
 #include "liveobjects-sys/loc_trace.h"
 
+#include <string.h>
+
 
 
 static void NewMessageData(MessageData* md, MQTTString* aTopicName, MQTTMessage* aMessage) {
@@ -40,14 +52,14 @@ static int getNextPacketId(MQTTClient *c) {
 }
 
 
-static int sendPacket(MQTTClient* c, int length, Timer* timer)
+static int sendPacketAt(MQTTClient* c, int offset, int length, Timer* timer)
 {
     int rc = FAILURE, 
         sent = 0;
     
     while (sent < length ) // && !TimerIsExpired(timer)) //OAB: Disable timer to send a packet.
     {
-        rc = c->ipstack->mqttwrite(c->ipstack, &c->buf[sent], length, TimerLeftMS(timer));
+        rc = c->ipstack->mqttwrite(c->ipstack, &c->buf[offset + sent], length - sent, TimerLeftMS(timer));
         if (rc < 0)  // there was an error writing the data
             break;
         sent += rc;
@@ -63,6 +75,72 @@ static int sendPacket(MQTTClient* c, int length, Timer* timer)
 }
 
 
+static int sendPacket(MQTTClient* c, int length, Timer* timer)
+{
+    return sendPacketAt(c, 0, length, timer);
+}
+
+
+// header (hdrlen bytes) in the send buffer, followed by the payload
+static int sendPacketVec(MQTTClient* c, int hdrlen, const unsigned char* payload, int payloadlen, Timer* timer)
+{
+    int rc = FAILURE,
+        sent = 0,
+        length = hdrlen + payloadlen;
+
+    while (sent < length)
+    {
+        NetworkVec vec[2];
+        int nb = 0;
+        if (sent < hdrlen)
+        {
+            vec[nb].buf = &c->buf[sent];
+            vec[nb++].len = hdrlen - sent;
+            vec[nb].buf = payload;
+            vec[nb++].len = payloadlen;
+        }
+        else
+        {
+            vec[nb].buf = payload + (sent - hdrlen);
+            vec[nb++].len = length - sent;
+        }
+        rc = c->ipstack->mqttwritev(c->ipstack, vec, nb, TimerLeftMS(timer));
+        if (rc < 0)  // there was an error writing the data
+            break;
+        sent += rc;
+    }
+    if (sent == length)
+    {
+        TimerCountdown(&c->ping_timer, c->keepAliveInterval); // record the fact that we have successfully sent the packet
+        rc = SUCCESS;
+    }
+    else
+        rc = FAILURE;
+    return rc;
+}
+
+
+static int sendPublish(MQTTClient* c, unsigned char dup, MQTTMessage* message, MQTTString topic, Timer* timer)
+{
+    int len;
+
+    if (c->ipstack->mqttwritev != NULL)
+    {
+        // the payload is not copied in the send buffer
+        len = MQTTSerialize_publishHeader(c->buf, c->buf_size, dup, message->qos, message->retained, message->id,
+                  topic, message->payloadlen);
+        if (len <= 0)
+            return FAILURE;
+        return sendPacketVec(c, len, (unsigned char*)message->payload, message->payloadlen, timer);
+    }
+    len = MQTTSerialize_publish(c->buf, c->buf_size, dup, message->qos, message->retained, message->id,
+              topic, (unsigned char*)message->payload, message->payloadlen);
+    if (len <= 0)
+        return FAILURE;
+    return sendPacket(c, len, timer);
+}
+
+
 void MQTTClientInit(MQTTClient* c, Network* network, unsigned int command_timeout_ms,
 		unsigned char* sendbuf, size_t sendbuf_size, unsigned char* readbuf, size_t readbuf_size)
 {
@@ -70,7 +148,12 @@ void MQTTClientInit(MQTTClient* c, Network* network, unsigned int command_timeou
     c->ipstack = network;
     
     for (i = 0; i < MAX_MESSAGE_HANDLERS; ++i)
+    {
         c->messageHandlers[i].topicFilter = 0;
+        c->messageHandlers[i].fpChunk = NULL;
+    }
+    memset(c->topicIndex, 0, sizeof(c->topicIndex));
+    c->wildcardNb = 0;
     c->command_timeout_ms = command_timeout_ms;
     c->buf = sendbuf;
     c->buf_size = sendbuf_size;
@@ -79,6 +162,10 @@ void MQTTClientInit(MQTTClient* c, Network* network, unsigned int command_timeou
     c->isconnected = 0;
     c->ping_outstanding = 0;
     c->defaultMessageHandler = NULL;
+#if (MAX_INFLIGHT_MESSAGES > 0)
+    memset(c->inflight, 0, sizeof(c->inflight));
+    c->inflightNb = 0;
+#endif
 	c->next_packetid = 1;
     TimerInit(&c->ping_timer);
 #if defined(MQTT_TASK)
@@ -115,6 +202,72 @@ exit:
 }
 
 
+// read len bytes, which can be given by the network in several parts
+static int readBytes(MQTTClient* c, unsigned char* buf, int len, Timer* timer)
+{
+    int got = 0;
+
+    while (got < len)
+    {
+        int rc = c->ipstack->mqttread(c->ipstack, buf + got, len - got, TimerLeftMS(timer));
+        if (rc <= 0)
+            break;
+        got += rc;
+    }
+    return got;
+}
+
+
+// skip the rest of a packet larger than the read buffer, to stay in step with the stream
+static int skipBytes(MQTTClient* c, int len, Timer* timer)
+{
+    while (len > 0)
+    {
+        int n = (len < (int)c->readbuf_size) ? len : (int)c->readbuf_size;
+        int rc = c->ipstack->mqttread(c->ipstack, c->readbuf, n, TimerLeftMS(timer));
+        if (rc <= 0)
+            return FAILURE;
+        len -= rc;
+    }
+    return SUCCESS;
+}
+
+
+// packet larger than the read buffer: only the variable header (topic name and packet id) of a PUBLISH packet
+// is read, its payload is read by deliverMessageChunked
+static int readPacketHeader(MQTTClient* c, MQTTHeader header, int len, int rem_len)
+{
+    int hdr_len = 2;
+    int got = 0;
+    Timer timer;
+
+    TimerInit(&timer);
+    TimerCountdownMS(&timer, c->command_timeout_ms);
+
+    if (header.bits.type == PUBLISH && len + hdr_len < (int)c->readbuf_size)
+    {
+        got = readBytes(c, c->readbuf + len, hdr_len, &timer);
+        if (got == hdr_len)
+        {
+            hdr_len += (c->readbuf[len] << 8) + c->readbuf[len + 1] + ((header.bits.qos > 0) ? 2 : 0);
+            // keep room for a chunk of the payload
+            if (hdr_len < rem_len && len + hdr_len < (int)c->readbuf_size)
+            {
+                got += readBytes(c, c->readbuf + len + got, hdr_len - got, &timer);
+                if (got == hdr_len)
+                    return PUBLISH;
+            }
+        }
+    }
+
+    LOTRACE_ERR("packet type %d, remaining length %d over the read buffer (%d bytes) - skipped", header.bits.type,
+            rem_len, (int)c->readbuf_size);
+    if (skipBytes(c, rem_len - got, &timer) != SUCCESS)
+        LOTRACE_ERR("failed to skip %d bytes", rem_len - got);
+    return FAILURE;
+}
+
+
 static int readPacket(MQTTClient* c, Timer* timer)
 {
     int rc = FAILURE;
@@ -134,10 +287,15 @@ static int readPacket(MQTTClient* c, Timer* timer)
     len += MQTTPacket_encode(c->readbuf + 1, rem_len); /* put the original remaining length back into the buffer */
 
     /* 3. read the rest of the buffer using a callback to supply the rest of the data */
-    if (rem_len > 0 && (c->ipstack->mqttread(c->ipstack, c->readbuf + len, rem_len, TimerLeftMS(timer)) != rem_len))
+    header.byte = c->readbuf[0];
+    if (rem_len > (int)c->readbuf_size - len)
+    {
+        rc = readPacketHeader(c, header, len, rem_len);
+        goto exit;
+    }
+    if (rem_len > 0 && readBytes(c, c->readbuf + len, rem_len, timer) != rem_len)
         goto exit;
 
-    header.byte = c->readbuf[0];
     rc = header.bits.type;
 exit:
     return rc;
@@ -175,16 +333,54 @@ static char isTopicMatched(char* topicFilter, MQTTString* topicName)
 }
 
 
+// FNV-1a
+static unsigned long topicHash(const char* s, int len)
+{
+    unsigned long h = 2166136261UL;
+    while (len-- > 0)
+        h = ((h ^ (unsigned char)*s++) * 16777619UL) & 0xFFFFFFFFUL;
+    return h;
+}
+
+
+// index the topic filters without wildcard, list the others
+static void buildTopicIndex(MQTTClient* c)
+{
+    int i;
+
+    memset(c->topicIndex, 0, sizeof(c->topicIndex));
+    c->wildcardNb = 0;
+    for (i = 0; i < MAX_MESSAGE_HANDLERS; ++i)
+    {
+        const char* topicFilter = c->messageHandlers[i].topicFilter;
+        if (topicFilter == 0)
+            continue;
+        if (strpbrk(topicFilter, "+#") != NULL)
+            c->wildcardHandlers[c->wildcardNb++] = (unsigned char)i;
+        else
+        {
+            unsigned long slot = topicHash(topicFilter, (int)strlen(topicFilter)) & (MQTT_TOPIC_INDEX_SZ - 1);
+            while (c->topicIndex[slot] != 0)
+                slot = (slot + 1) & (MQTT_TOPIC_INDEX_SZ - 1);
+            c->topicIndex[slot] = (unsigned char)(i + 1);
+        }
+    }
+}
+
+
 int deliverMessage(MQTTClient* c, MQTTString* topicName, MQTTMessage* message)
 {
     int i;
     int rc = FAILURE;
+    const char* name = (topicName->cstring) ? topicName->cstring : topicName->lenstring.data;
+    int name_len = (topicName->cstring) ? (int)strlen(topicName->cstring) : topicName->lenstring.len;
+    unsigned long slot = topicHash(name, name_len) & (MQTT_TOPIC_INDEX_SZ - 1);
 
-    // we have to find the right message handler - indexed by topic
-    for (i = 0; i < MAX_MESSAGE_HANDLERS; ++i)
+    // we have to find the right message handler - a single lookup for the topic filters without wildcard
+    while (c->topicIndex[slot] != 0)
     {
-        if (c->messageHandlers[i].topicFilter != 0 && (MQTTPacket_equals(topicName, (char*)c->messageHandlers[i].topicFilter) ||
-                isTopicMatched((char*)c->messageHandlers[i].topicFilter, topicName)))
+        i = c->topicIndex[slot] - 1;
+        if (MQTTPacket_equals(topicName, (char*)c->messageHandlers[i].topicFilter))
         {
             if (c->messageHandlers[i].fp != NULL)
             {
@@ -193,6 +389,25 @@ int deliverMessage(MQTTClient* c, MQTTString* topicName, MQTTMessage* message)
                 c->messageHandlers[i].fp(&md);
                 rc = SUCCESS;
             }
+            break;
+        }
+        slot = (slot + 1) & (MQTT_TOPIC_INDEX_SZ - 1);
+    }
+
+    // then the topic filters with a wildcard
+    if (c->wildcardNb > 0 && topicName->cstring == NULL)
+    {
+        int j;
+        for (j = 0; j < c->wildcardNb; ++j)
+        {
+            i = c->wildcardHandlers[j];
+            if (isTopicMatched((char*)c->messageHandlers[i].topicFilter, topicName) && c->messageHandlers[i].fp != NULL)
+            {
+                MessageData md;
+                NewMessageData(&md, topicName, message);
+                c->messageHandlers[i].fp(&md);
+                rc = SUCCESS;
+            }
         }
     }
     
@@ -208,6 +423,176 @@ int deliverMessage(MQTTClient* c, MQTTString* topicName, MQTTMessage* message)
 }
 
 
+// first matching topic filter with a chunk handler
+static int findChunkHandler(MQTTClient* c, MQTTString* topicName)
+{
+    int i;
+    const char* name = (topicName->cstring) ? topicName->cstring : topicName->lenstring.data;
+    int name_len = (topicName->cstring) ? (int)strlen(topicName->cstring) : topicName->lenstring.len;
+    unsigned long slot = topicHash(name, name_len) & (MQTT_TOPIC_INDEX_SZ - 1);
+
+    while (c->topicIndex[slot] != 0)
+    {
+        i = c->topicIndex[slot] - 1;
+        if (MQTTPacket_equals(topicName, (char*)c->messageHandlers[i].topicFilter))
+        {
+            if (c->messageHandlers[i].fpChunk != NULL)
+                return i;
+            break;
+        }
+        slot = (slot + 1) & (MQTT_TOPIC_INDEX_SZ - 1);
+    }
+    if (topicName->cstring == NULL)
+    {
+        int j;
+        for (j = 0; j < c->wildcardNb; ++j)
+        {
+            i = c->wildcardHandlers[j];
+            if (c->messageHandlers[i].fpChunk != NULL && isTopicMatched((char*)c->messageHandlers[i].topicFilter, topicName))
+                return i;
+        }
+    }
+    return -1;
+}
+
+
+// the payload of a PUBLISH packet larger than the read buffer is read in the room left after its variable header,
+// and given to the chunk handler each time this window is full (or at the end of the payload).
+// The bytes not consumed by the handler are moved at the beginning of the window.
+static int deliverMessageChunked(MQTTClient* c, MQTTString* topicName, MQTTMessage* message)
+{
+    unsigned char* window = (unsigned char*)message->payload;
+    size_t window_size = (size_t)(c->readbuf + c->readbuf_size - window);
+    size_t totallen = message->payloadlen;
+    size_t left = totallen;  // not received yet
+    size_t kept = 0;         // received, not consumed yet
+    size_t offset = 0;       // offset of the window in the payload
+    int i = findChunkHandler(c, topicName);
+    Timer timer;
+    MessageData md;
+
+    if (i < 0)
+        LOTRACE_ERR("payload of %u bytes over the read buffer, no chunk handler - ignored", (unsigned int)totallen);
+
+    NewMessageData(&md, topicName, message);
+    TimerInit(&timer);
+    while (left > 0)
+    {
+        size_t n = window_size - kept;
+        int rc;
+
+        if (n > left)
+            n = left;
+        TimerCountdownMS(&timer, c->command_timeout_ms);
+        rc = c->ipstack->mqttread(c->ipstack, window + kept, (int)n, TimerLeftMS(&timer));
+        if (rc <= 0)
+            return FAILURE; // the stream is broken
+        kept += rc;
+        left -= rc;
+        if (i < 0)
+        {
+            kept = 0;
+            continue;
+        }
+        if (kept < window_size && left > 0)
+            continue;
+
+        message->payload = window;
+        message->payloadlen = kept;
+        rc = c->messageHandlers[i].fpChunk(&md, offset, totallen);
+        if (rc < 0 || (rc == 0 && kept == window_size && left > 0))
+        {
+            if (rc == 0)
+                LOTRACE_ERR("nothing consumed in a chunk of %u bytes, at offset %u - rest ignored", (unsigned int)kept,
+                        (unsigned int)offset);
+            i = -1;
+            kept = 0;
+            continue;
+        }
+        if ((size_t)rc > kept)
+            rc = (int)kept;
+        memmove(window, window + rc, kept - rc);
+        kept -= rc;
+        offset += rc;
+    }
+    return SUCCESS;
+}
+
+
+#if (MAX_INFLIGHT_MESSAGES > 0)
+static int sendInflight(MQTTClient* c, int i, Timer* timer)
+{
+    struct InflightMessages* m = &c->inflight[i];
+    MQTTString topic = MQTTString_initializer;
+
+    topic.cstring = (char *)m->topicName;
+    TimerCountdownMS(&m->timer, c->command_timeout_ms);
+    return sendPublish(c, m->message.dup, &m->message, topic, timer);
+}
+
+
+static void completeInflight(MQTTClient* c, int i, int rc)
+{
+    struct InflightMessages* m = &c->inflight[i];
+    publishCompletionHandler fp = m->fp;
+    void* context = m->context;
+    unsigned short id = m->id;
+
+    m->id = 0; // free the slot before the call, the handler can publish again
+    c->inflightNb--;
+    if (fp != NULL)
+        fp(context, id, rc);
+}
+
+
+static void ackInflight(MQTTClient* c)
+{
+    unsigned short mypacketid;
+    unsigned char dup, type;
+    int i;
+
+    if (c->inflightNb == 0 || MQTTDeserialize_ack(&type, &dup, &mypacketid, c->readbuf, c->readbuf_size) != 1)
+        return;
+    for (i = 0; i < MAX_INFLIGHT_MESSAGES; ++i)
+    {
+        if (c->inflight[i].id == mypacketid)
+        {
+            completeInflight(c, i, SUCCESS);
+            break;
+        }
+    }
+}
+
+
+// send again (DUP) the in-flight messages not acknowledged in time, or all of them after a new connection
+static void retryInflight(MQTTClient* c, int all)
+{
+    Timer timer;
+    int i;
+
+    for (i = 0; i < MAX_INFLIGHT_MESSAGES && c->inflightNb > 0; ++i)
+    {
+        struct InflightMessages* m = &c->inflight[i];
+        if (m->id == 0 || (!all && !TimerIsExpired(&m->timer)))
+            continue;
+        if (!all && m->retries >= MAX_INFLIGHT_RETRIES)
+        {
+            LOTRACE_ERR("no PUBACK for packet id %u - given up", m->id);
+            completeInflight(c, i, FAILURE);
+            continue;
+        }
+        if (!all)
+            m->retries++;
+        m->message.dup = 1;
+        TimerInit(&timer);
+        TimerCountdownMS(&timer, c->command_timeout_ms);
+        if (sendInflight(c, i, &timer) != SUCCESS)
+            break; // the link is broken, wait for the next connection
+    }
+}
+#endif
+
+
 int keepalive(MQTTClient* c)
 {
     int rc = FAILURE;
@@ -249,19 +634,35 @@ int cycle(MQTTClient* c, Timer* timer)
     switch (packet_type)
     {
         case CONNACK:
-        case PUBACK:
         case SUBACK:
             break;
+        case PUBACK:
+#if (MAX_INFLIGHT_MESSAGES > 0)
+            ackInflight(c);
+#endif
+            break;
         case PUBLISH:
         {
             MQTTString topicName;
             MQTTMessage msg;
             int intQoS;
+            int payloadlen;
             if (MQTTDeserialize_publish(&msg.dup, &intQoS, &msg.retained, &msg.id, &topicName,
-               (unsigned char**)&msg.payload, (int*)&msg.payloadlen, c->readbuf, c->readbuf_size) != 1)
+               (unsigned char**)&msg.payload, &payloadlen, c->readbuf, c->readbuf_size) != 1)
                 goto exit;
             msg.qos = (enum QoS)intQoS;
-            deliverMessage(c, &topicName, &msg);
+            msg.payloadlen = (size_t)payloadlen; // not through a (int*) cast: size_t can be larger than int
+            if ((unsigned char*)msg.payload + msg.payloadlen > c->readbuf + c->readbuf_size)
+            {
+                // payload not read yet, larger than the read buffer
+                if (deliverMessageChunked(c, &topicName, &msg) != SUCCESS)
+                {
+                    rc = FAILURE;
+                    goto exit;
+                }
+            }
+            else
+                deliverMessage(c, &topicName, &msg);
             if (msg.qos != QOS0)
             {
                 if (msg.qos == QOS1)
@@ -298,6 +699,9 @@ int cycle(MQTTClient* c, Timer* timer)
             break;
     }
     keepalive(c);
+#if (MAX_INFLIGHT_MESSAGES > 0)
+    retryInflight(c, 0);
+#endif
 exit:
     LOTRACE_DBG_VERBOSE("cycle: rc=%d packet_type=%d x%x", rc, packet_type, packet_type);
     if (rc == SUCCESS)
@@ -412,7 +816,12 @@ int MQTTConnect(MQTTClient* c, MQTTPacket_connectData* options)
     
 exit:
     if (rc == SUCCESS)
+    {
         c->isconnected = 1;
+#if (MAX_INFLIGHT_MESSAGES > 0)
+        retryInflight(c, 1);
+#endif
+    }
 
 #if defined(MQTT_TASK)
 	MutexUnlock(&c->mutex);
@@ -422,6 +831,68 @@ exit:
 }
 
 
+int MQTTSetMessageHandler(MQTTClient* c, const char* topicFilter, messageHandler messageHandler)
+{
+    int rc = FAILURE;
+    int i = -1;
+
+    /* first check for an existing matching slot */
+    for (i = 0; i < MAX_MESSAGE_HANDLERS; ++i)
+    {
+        if (c->messageHandlers[i].topicFilter != NULL && strcmp(c->messageHandlers[i].topicFilter, topicFilter) == 0)
+        {
+            if (messageHandler == NULL) /* remove existing */
+            {
+                c->messageHandlers[i].topicFilter = NULL;
+                c->messageHandlers[i].fp = NULL;
+                c->messageHandlers[i].fpChunk = NULL;
+            }
+            rc = SUCCESS;
+            break;
+        }
+    }
+    /* if no existing, look for empty slot (unless we are removing) */
+    if (messageHandler != NULL)
+    {
+        if (rc == FAILURE)
+        {
+            for (i = 0; i < MAX_MESSAGE_HANDLERS; ++i)
+            {
+                if (c->messageHandlers[i].topicFilter == NULL)
+                {
+                    c->messageHandlers[i].fpChunk = NULL;
+                    rc = SUCCESS;
+                    break;
+                }
+            }
+        }
+        if (i < MAX_MESSAGE_HANDLERS)
+        {
+            c->messageHandlers[i].topicFilter = topicFilter;
+            c->messageHandlers[i].fp = messageHandler;
+        }
+    }
+    buildTopicIndex(c);
+    return rc;
+}
+
+
+int MQTTSetMessageChunkHandler(MQTTClient* c, const char* topicFilter, messageChunkHandler messageChunkHandler)
+{
+    int i;
+
+    for (i = 0; i < MAX_MESSAGE_HANDLERS; ++i)
+    {
+        if (c->messageHandlers[i].topicFilter != NULL && strcmp(c->messageHandlers[i].topicFilter, topicFilter) == 0)
+        {
+            c->messageHandlers[i].fpChunk = messageChunkHandler;
+            return SUCCESS;
+        }
+    }
+    return FAILURE;
+}
+
+
 int MQTTSubscribe(MQTTClient* c, const char* topicFilter, enum QoS qos, messageHandler messageHandler)
 { 
     int rc = FAILURE;  
@@ -453,19 +924,7 @@ int MQTTSubscribe(MQTTClient* c, const char* topicFilter, enum QoS qos, messageH
         if (MQTTDeserialize_suback(&mypacketid, 1, &count, &grantedQoS, c->readbuf, c->readbuf_size) == 1)
             rc = grantedQoS; // 0, 1, 2 or 0x80 
         if (rc != 0x80)
-        {
-            int i;
-            for (i = 0; i < MAX_MESSAGE_HANDLERS; ++i)
-            {
-                if (c->messageHandlers[i].topicFilter == 0)
-                {
-                    c->messageHandlers[i].topicFilter = topicFilter;
-                    c->messageHandlers[i].fp = messageHandler;
-                    rc = 0;
-                    break;
-                }
-            }
-        }
+            rc = MQTTSetMessageHandler(c, topicFilter, messageHandler);
     }
     else 
         rc = FAILURE;
@@ -504,7 +963,11 @@ int MQTTUnsubscribe(MQTTClient* c, const char* topicFilter)
     {
         unsigned short mypacketid;  // should be the same as the packetid above
         if (MQTTDeserialize_unsuback(&mypacketid, c->readbuf, c->readbuf_size) == 1)
-            rc = 0; 
+        {
+            /* remove the subscription message handler associated with this topic, if there is one */
+            MQTTSetMessageHandler(c, topicFilter, NULL);
+            rc = 0;
+        }
     }
     else
         rc = FAILURE;
@@ -517,13 +980,48 @@ exit:
 }
 
 
+static int waitforPublishAck(MQTTClient* c, MQTTMessage* message, Timer* timer)
+{
+    int rc = SUCCESS;
+
+    if (message->qos == QOS1)
+    {
+        rc = FAILURE;
+        while (waitfor(c, PUBACK, timer) == PUBACK) // the PUBACK of an in-flight message can come first
+        {
+            unsigned short mypacketid;
+            unsigned char dup, type;
+            if (MQTTDeserialize_ack(&type, &dup, &mypacketid, c->readbuf, c->readbuf_size) != 1)
+                break;
+            if (mypacketid == message->id)
+            {
+                rc = SUCCESS;
+                break;
+            }
+        }
+    }
+    else if (message->qos == QOS2)
+    {
+        if (waitfor(c, PUBCOMP, timer) == PUBCOMP)
+        {
+            unsigned short mypacketid;
+            unsigned char dup, type;
+            if (MQTTDeserialize_ack(&type, &dup, &mypacketid, c->readbuf, c->readbuf_size) != 1)
+                rc = FAILURE;
+        }
+        else
+            rc = FAILURE;
+    }
+    return rc;
+}
+
+
 int MQTTPublish(MQTTClient* c, const char* topicName, MQTTMessage* message)
 {
     int rc = FAILURE;
     Timer timer;   
     MQTTString topic = MQTTString_initializer;
     topic.cstring = (char *)topicName;
-    int len = 0;
 
 #if defined(MQTT_TASK)
 	MutexLock(&c->mutex);
@@ -537,38 +1035,133 @@ int MQTTPublish(MQTTClient* c, const char* topicName, MQTTMessage* message)
     if (message->qos == QOS1 || message->qos == QOS2)
         message->id = getNextPacketId(c);
     
-    len = MQTTSerialize_publish(c->buf, c->buf_size, 0, message->qos, message->retained, message->id, 
-              topic, (unsigned char*)message->payload, message->payloadlen);
-    if (len <= 0)
-        goto exit;
-    if ((rc = sendPacket(c, len, &timer)) != SUCCESS) // send the subscribe packet
+    if ((rc = sendPublish(c, 0, message, topic, &timer)) != SUCCESS) // send the publish packet
         goto exit; // there was a problem
     
-    if (message->qos == QOS1)
+    rc = waitforPublishAck(c, message, &timer);
+    
+exit:
+#if defined(MQTT_TASK)
+	MutexUnlock(&c->mutex);
+#endif
+    return rc;
+}
+
+
+int MQTTPublishAsync(MQTTClient* c, const char* topicName, MQTTMessage* message, publishCompletionHandler fp,
+        void* context)
+{
+    int rc = FAILURE;
+    Timer timer;
+    MQTTString topic = MQTTString_initializer;
+#if (MAX_INFLIGHT_MESSAGES > 0)
+    unsigned char* payload = (unsigned char*)message->payload;
+    int i;
+#endif
+    topic.cstring = (char *)topicName;
+
+#if defined(MQTT_TASK)
+	MutexLock(&c->mutex);
+#endif
+	if (!c->isconnected)
+		goto exit;
+
+    TimerInit(&timer);
+    TimerCountdownMS(&timer, c->command_timeout_ms);
+
+    if (message->qos == QOS0)
     {
-        if (waitfor(c, PUBACK, &timer) == PUBACK)
-        {
-            unsigned short mypacketid;
-            unsigned char dup, type;
-            if (MQTTDeserialize_ack(&type, &dup, &mypacketid, c->readbuf, c->readbuf_size) != 1)
-                rc = FAILURE;
-        }
-        else
-            rc = FAILURE;
+        message->id = 0;
+        rc = sendPublish(c, 0, message, topic, &timer);
+        if (fp != NULL)
+            fp(context, 0, rc);
+        goto exit;
     }
-    else if (message->qos == QOS2)
+#if (MAX_INFLIGHT_MESSAGES > 0)
+    // the payload is sent again from the caller memory, which can not be the send buffer
+    if (message->qos != QOS1 || (payload + message->payloadlen > c->buf && payload < c->buf + c->buf_size))
+        goto exit;
+
+    // window full: process the received packets (PUBACK) until a slot is free
+    while (c->inflightNb >= MAX_INFLIGHT_MESSAGES)
     {
-        if (waitfor(c, PUBCOMP, &timer) == PUBCOMP)
+        if (TimerIsExpired(&timer))
         {
-            unsigned short mypacketid;
-            unsigned char dup, type;
-            if (MQTTDeserialize_ack(&type, &dup, &mypacketid, c->readbuf, c->readbuf_size) != 1)
-                rc = FAILURE;
+            rc = BUFFER_OVERFLOW;
+            goto exit;
         }
-        else
-            rc = FAILURE;
+        if (cycle(c, &timer) == FAILURE)
+            goto exit;
     }
-    
+    for (i = 0; i < MAX_INFLIGHT_MESSAGES; ++i)
+    {
+        if (c->inflight[i].id == 0)
+            break;
+    }
+
+    message->id = getNextPacketId(c);
+    message->dup = 0;
+    c->inflight[i].id = message->id;
+    c->inflight[i].retries = 0;
+    c->inflight[i].topicName = topicName;
+    c->inflight[i].message = *message;
+    c->inflight[i].fp = fp;
+    c->inflight[i].context = context;
+    TimerInit(&c->inflight[i].timer);
+    c->inflightNb++;
+    if ((rc = sendInflight(c, i, &timer)) != SUCCESS)
+    {
+        c->inflight[i].id = 0; // not sent: no completion
+        c->inflightNb--;
+    }
+#endif
+
+exit:
+#if defined(MQTT_TASK)
+	MutexUnlock(&c->mutex);
+#endif
+    return rc;
+}
+
+
+int MQTTPublishInPlace(MQTTClient* c, const char* topicName, MQTTMessage* message)
+{
+    int rc = FAILURE;
+    Timer timer;
+    MQTTString topic = MQTTString_initializer;
+    unsigned char* payload = (unsigned char*)message->payload;
+    int offset = 0;
+    int len = 0;
+    topic.cstring = (char *)topicName;
+
+#if defined(MQTT_TASK)
+	MutexLock(&c->mutex);
+#endif
+	if (!c->isconnected)
+		goto exit;
+
+    // the payload must be in the send buffer, after the room reserved for the header
+    if ((payload < c->buf) || (payload + message->payloadlen > c->buf + c->buf_size))
+        goto exit;
+
+    TimerInit(&timer);
+    TimerCountdownMS(&timer, c->command_timeout_ms);
+
+    if (message->qos == QOS1 || message->qos == QOS2)
+        message->id = getNextPacketId(c);
+
+    len = MQTTSerialize_publishHeaderLength(message->qos, topic, message->payloadlen);
+    offset = (int)(payload - c->buf) - len;
+    if (offset < 0)
+        goto exit;
+    if (MQTTSerialize_publishHeader(&c->buf[offset], len, 0, message->qos, message->retained, message->id,
+              topic, message->payloadlen) != len)
+        goto exit;
+    if ((rc = sendPacketAt(c, offset, len + message->payloadlen, &timer)) != SUCCESS)
+        goto exit; // there was a problem
+
+    rc = waitforPublishAck(c, message, &timer);
+
 exit:
 #if defined(MQTT_TASK)
 	MutexUnlock(&c->mutex);
@@ -594,6 +1187,16 @@ int MQTTDisconnect(MQTTClient* c)
         rc = sendPacket(c, len, &timer);            // send the disconnect packet
         
     c->isconnected = 0;
+#if (MAX_INFLIGHT_MESSAGES > 0)
+    {
+        int i;
+        for (i = 0; i < MAX_INFLIGHT_MESSAGES && c->inflightNb > 0; ++i)
+        {
+            if (c->inflight[i].id != 0)
+                completeInflight(c, i, FAILURE);
+        }
+    }
+#endif
 
 #if defined(MQTT_TASK)
 	MutexUnlock(&c->mutex);
@@ -601,3 +1204,14 @@ int MQTTDisconnect(MQTTClient* c)
     return rc;
 }
 
+
+void MQTTSetLost(MQTTClient* c)
+{
+#if defined(MQTT_TASK)
+	MutexLock(&c->mutex);
+#endif
+    c->isconnected = 0;     // no DISCONNECT packet: the in-flight messages are kept, sent again after MQTTConnect
+#if defined(MQTT_TASK)
+	MutexUnlock(&c->mutex);
+#endif
+}
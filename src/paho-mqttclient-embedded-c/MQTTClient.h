@@ -61,6 +61,22 @@
 #define MAX_MESSAGE_HANDLERS 5 /* redefinable - how many subscriptions do you want? */
 #endif
 
+#if !defined(MQTT_TOPIC_INDEX_SZ)
+#define MQTT_TOPIC_INDEX_SZ 16 /* redefinable - slots of the topic index (power of 2, greater than MAX_MESSAGE_HANDLERS) */
+#endif
+
+#if (MQTT_TOPIC_INDEX_SZ & (MQTT_TOPIC_INDEX_SZ - 1)) || (MQTT_TOPIC_INDEX_SZ <= MAX_MESSAGE_HANDLERS) || (MAX_MESSAGE_HANDLERS > 255)
+#error "MQTT_TOPIC_INDEX_SZ must be a power of 2 greater than MAX_MESSAGE_HANDLERS (max 255)"
+#endif
+
+#if !defined(MAX_INFLIGHT_MESSAGES)
+#define MAX_INFLIGHT_MESSAGES 4 /* redefinable - QoS1 messages published by MQTTPublishAsync, not acknowledged yet (0: none) */
+#endif
+
+#if !defined(MAX_INFLIGHT_RETRIES)
+#define MAX_INFLIGHT_RETRIES 3 /* redefinable - retransmissions of an unacknowledged QoS1 message before giving up */
+#endif
+
 enum QoS { QOS0, QOS1, QOS2 };
 
 /* all failure return codes must be negative */
@@ -73,6 +89,7 @@ typedef struct Network
 {
 	int (*mqttread)(Network*, unsigned char* read_buffer, int, int);
 	int (*mqttwrite)(Network*, unsigned char* send_buffer, int, int);
+	int (*mqttwritev)(Network*, const NetworkVec* segments, int, int);  // optional, NULL if not supported
 } Network;*/
 
 /* The Timer structure must be defined in the platform specific header,
@@ -101,6 +118,16 @@ typedef struct MessageData
 
 typedef void (*messageHandler)(MessageData*);
 
+/* Chunked delivery of a PUBLISH payload larger than the read buffer (see MQTTSetMessageChunkHandler).
+ * md->message->payload and payloadlen give the current chunk, at offset in the payload of totallen bytes:
+ * the bytes not consumed by the previous call followed by the next received bytes. The last chunk ends at totallen.
+ * Returns the number of bytes consumed, or a negative value to ignore the rest of the payload. */
+typedef int (*messageChunkHandler)(MessageData* md, size_t offset, size_t totallen);
+
+/* Completion of a message published by MQTTPublishAsync: id is its packet id (0 for QoS0),
+ * rc is SUCCESS when sent (QoS0) or acknowledged (QoS1), FAILURE when given up. */
+typedef void (*publishCompletionHandler)(void* context, unsigned short id, int rc);
+
 typedef struct MQTTClient
 {
     unsigned int next_packetid,
@@ -117,10 +144,28 @@ typedef struct MQTTClient
     {
         const char* topicFilter;
         void (*fp) (MessageData*);
+        int (*fpChunk) (MessageData*, size_t, size_t);
     } messageHandlers[MAX_MESSAGE_HANDLERS];      /* Message handlers are indexed by subscription topic */
+    unsigned char topicIndex[MQTT_TOPIC_INDEX_SZ];   /* Hash index of the topic filters without wildcard: handler + 1, 0 if free */
+    unsigned char wildcardHandlers[MAX_MESSAGE_HANDLERS]; /* Handlers with a wildcard ('+' or '#') topic filter */
+    unsigned char wildcardNb;
 
     void (*defaultMessageHandler) (MessageData*);
 
+#if (MAX_INFLIGHT_MESSAGES > 0)
+    struct InflightMessages
+    {
+        unsigned short id;          /* packet id, 0 if the slot is free */
+        unsigned char retries;
+        const char* topicName;      /* topic and payload kept by the caller until the completion */
+        MQTTMessage message;
+        Timer timer;                /* retransmission when expired */
+        publishCompletionHandler fp;
+        void* context;
+    } inflight[MAX_INFLIGHT_MESSAGES];  /* QoS1 messages waiting for their PUBACK */
+    unsigned char inflightNb;
+#endif
+
     Network* ipstack;
     Timer ping_timer;
 #if defined(MQTT_TASK)
@@ -150,6 +195,9 @@ DLLExport void MQTTClientInit(MQTTClient* client, Network* network, unsigned int
 DLLExport int MQTTConnect(MQTTClient* client, MQTTPacket_connectData* options);
 
 /** MQTT Publish - send an MQTT publish packet and wait for all acks to complete for all QoSs
+ *  When the network supports mqttwritev, only the header (fixed header, topic name and packet id) is written
+ *  in the send buffer, and the payload is written from the caller memory (its size is not limited by the send
+ *  buffer). Otherwise the packet is copied in the send buffer.
  *  @param client - the client object to use
  *  @param topic - the topic to publish to
  *  @param message - the message to send
@@ -157,6 +205,34 @@ DLLExport int MQTTConnect(MQTTClient* client, MQTTPacket_connectData* options);
  */
 DLLExport int MQTTPublish(MQTTClient* client, const char*, MQTTMessage*);
 
+/** MQTT Publish In Place - same as MQTTPublish, but the payload is already stored in the send buffer
+ *  of the client (message->payload points into sendbuf), after a room large enough to contain the
+ *  publish header (see MQTTSerialize_publishHeaderLength). The header is written just before the payload,
+ *  so the payload is neither copied nor moved.
+ *  @param client - the client object to use
+ *  @param topic - the topic to publish to
+ *  @param message - the message to send
+ *  @return success code
+ */
+DLLExport int MQTTPublishInPlace(MQTTClient* client, const char*, MQTTMessage*);
+
+/** MQTT Publish Async - send an MQTT publish packet without waiting for its acknowledgement.
+ *  A QoS1 message takes a slot of the in-flight window (MAX_INFLIGHT_MESSAGES): when the window is full,
+ *  the received packets are processed until a slot is free (or command_timeout_ms). The PUBACK is matched
+ *  by cycle (MQTTYield), which calls the completion handler. Without PUBACK within command_timeout_ms, the
+ *  message is sent again with the DUP flag, up to MAX_INFLIGHT_RETRIES times. The in-flight messages are
+ *  also sent again after a new MQTTConnect, and given up by MQTTDisconnect.
+ *  A QoS0 message is sent, and its completion handler called, before returning. QoS2 is not supported.
+ *  @param client - the client object to use
+ *  @param topic - the topic to publish to (kept as is, not copied)
+ *  @param message - the message to send. The payload is not copied: it must stay unchanged until the
+ *  completion, and must not be in the send buffer of the client. message->id is set to the packet id.
+ *  @param fp - completion handler, or NULL
+ *  @param context - given to the completion handler
+ *  @return success code, BUFFER_OVERFLOW if the window stays full
+ */
+DLLExport int MQTTPublishAsync(MQTTClient* client, const char*, MQTTMessage*, publishCompletionHandler fp, void* context);
+
 /** MQTT Subscribe - send an MQTT subscribe packet and wait for suback before returning.
  *  @param client - the client object to use
  *  @param topicFilter - the topic filter to subscribe to
@@ -165,6 +241,26 @@ DLLExport int MQTTPublish(MQTTClient* client, const char*, MQTTMessage*);
  */
 DLLExport int MQTTSubscribe(MQTTClient* client, const char* topicFilter, enum QoS, messageHandler);
 
+/** MQTT SetMessageHandler - set or remove a per topic message handler, without sending any packet.
+ *  The topic filters without wildcard are found with a single lookup in a hash index, the others are tested one by one.
+ *  @param client - the client object to use
+ *  @param topicFilter - the topic filter set the message handler for (kept as is, not copied)
+ *  @param messageHandler - pointer to the message handler function, or NULL to remove
+ *  @return success code
+ */
+DLLExport int MQTTSetMessageHandler(MQTTClient* client, const char* topicFilter, messageHandler messageHandler);
+
+/** MQTT SetMessageChunkHandler - set or remove the chunk handler of a topic filter, which already has a message handler.
+ *  A PUBLISH packet larger than the read buffer is not read as a whole: its payload is given in chunks to the
+ *  chunk handler of the first matching topic filter, or ignored if there is none. The other packets larger than
+ *  the read buffer are ignored.
+ *  @param client - the client object to use
+ *  @param topicFilter - the topic filter set the chunk handler for
+ *  @param messageChunkHandler - pointer to the chunk handler function, or NULL to remove
+ *  @return success code
+ */
+DLLExport int MQTTSetMessageChunkHandler(MQTTClient* client, const char* topicFilter, messageChunkHandler messageChunkHandler);
+
 /** MQTT Subscribe - send an MQTT unsubscribe packet and wait for unsuback before returning.
  *  @param client - the client object to use
  *  @param topicFilter - the topic filter to unsubscribe from
@@ -178,6 +274,12 @@ DLLExport int MQTTUnsubscribe(MQTTClient* client, const char* topicFilter);
  */
 DLLExport int MQTTDisconnect(MQTTClient* client);
 
+/** MQTT Set Lost - mark the connection as lost, without sending an MQTT disconnect packet.
+ *  The in-flight QoS1 messages are kept, and sent again after the next MQTTConnect.
+ *  @param client - the client object to use
+ */
+DLLExport void MQTTSetLost(MQTTClient* client);
+
 /** MQTT Yield - MQTT background
  *  @param client - the client object to use
  *  @param time - the time, in milliseconds, to yield for 